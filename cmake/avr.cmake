@@ -63,6 +63,10 @@ set(CMAKE_ASM_FLAGS "${OBJECT_GEN_FLAGS} -x assembler-with-cpp " CACHE INTERNAL
 
 set(AVRTOS_C_SRC
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/mutex.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/rwlock.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/pipe.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/buf.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/pt.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/condvar.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/assert.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/event.c
@@ -85,6 +89,7 @@ set(AVRTOS_C_SRC
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/misc/led.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/alloc/slab.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/alloc/bump.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/alloc/tlsf.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/alloc/default.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/msgq.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/flags.c
@@ -92,6 +97,7 @@ set(AVRTOS_C_SRC
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/fifo.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/systime.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/poll.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/post.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/mem_slab.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/rust_helpers.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/dstruct/debug.c
@@ -99,16 +105,21 @@ set(AVRTOS_C_SRC
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/dstruct/tqueue.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/dstruct/dlist.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/dstruct/slist.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/dstruct/lflist.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/i2c.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/usart.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/gpio.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/spi.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/timer.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/adc.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/capture.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/exti.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/drivers/swpwm.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/devices/mcp2515.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/devices/tcn75.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/devices/sd.c
 	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/subsystems/crc.c
+	${CMAKE_CURRENT_SOURCE_DIR}/src/avrtos/subsystems/sensor.c
 )
 
 set(AVRTOS_ASM_SRC
@@ -175,6 +186,15 @@ function(target_prepare_env target)
 		@ONLY
 	)
 
+	# generate the initial stacks of the static threads (CONFIG_THREAD_STACK_IMAGE)
+	find_program(PYTHON3 python3)
+	if (PYTHON3)
+		add_custom_command(TARGET ${target} POST_BUILD
+			COMMAND ${PYTHON3} ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/../scripts/stack_image.py ${output_name}
+			VERBATIM
+		)
+	endif()
+
 	# create hex file
 	add_custom_target(
 		hex_${target} 
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Buffers Demo
+ * ============
+ * The main thread receives frames (simulated) in pool buffers, frames larger
+ * than a buffer are chained as fragments. Frames are handed over to the parser
+ * thread through a FIFO, without any copy.
+ *
+ * The parser strips the frame header, then shares the frame with the logger
+ * thread by taking a reference and passing the pointer through a message queue.
+ * The buffers return to the pool when both threads released their reference.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+
+#include <avr/pgmspace.h>
+
+#define HEADER_SIZE 2u
+#define DATA_SIZE   16u
+
+K_BUF_POOL_DEFINE(pool, 8u, DATA_SIZE);
+K_FIFO_DEFINE(rx_fifo);
+K_MSGQ_DEFINE(log_msgq, sizeof(struct k_buf *), 4u);
+
+void parser_thread(void *arg);
+void logger_thread(void *arg);
+
+K_THREAD_DEFINE(parser, parser_thread, 0x100, K_PREEMPTIVE, NULL, 'P');
+K_THREAD_DEFINE(logger, logger_thread, 0x100, K_PREEMPTIVE, NULL, 'L');
+
+static struct k_buf *receive_frame(uint8_t seq, uint8_t len)
+{
+    struct k_buf *head = NULL;
+
+    while (len != 0u) {
+        struct k_buf *buf = k_buf_alloc(&pool, K_FOREVER);
+
+        if (head == NULL) {
+            /* Room for the header, known once the payload is received */
+            k_buf_reserve(buf, HEADER_SIZE);
+            head = buf;
+        } else {
+            k_buf_frag_add(head, buf);
+        }
+
+        while ((len != 0u) && k_buf_tailroom(buf)) {
+            *(uint8_t *)k_buf_add(buf, 1u) = seq + len--;
+        }
+    }
+
+    uint8_t *hdr = k_buf_push(head, HEADER_SIZE);
+    hdr[0]       = seq;
+    hdr[1]       = (uint8_t)(k_buf_frags_len(head) - HEADER_SIZE);
+
+    return head;
+}
+
+int main(void)
+{
+    uint8_t seq = 0u;
+
+    for (;;) {
+        struct k_buf *frame = receive_frame(seq, 4u + (seq % 40u));
+        k_buf_put(&rx_fifo, frame);
+
+        seq++;
+        k_sleep(K_MSEC(200));
+    }
+}
+
+void parser_thread(void *arg)
+{
+    for (;;) {
+        struct k_buf *frame = k_buf_get(&rx_fifo, K_FOREVER);
+
+        const uint8_t *hdr = k_buf_pull(frame, HEADER_SIZE);
+
+        printf_P(PSTR("P: frame %u len %u (%u fragment bytes)\n"), hdr[0], hdr[1],
+                 k_buf_frags_len(frame));
+
+        /* Share the frame with the logger */
+        k_buf_ref(frame);
+        if (k_msgq_put(&log_msgq, &frame, K_NO_WAIT) != 0) {
+            k_buf_unref(frame);
+        }
+
+        k_buf_unref(frame);
+    }
+}
+
+void logger_thread(void *arg)
+{
+    uint8_t line[8u];
+
+    for (;;) {
+        struct k_buf *frame;
+        k_msgq_get(&log_msgq, &frame, K_FOREVER);
+
+        const size_t n = k_buf_linearize(line, sizeof(line), frame, 0u);
+        printf_P(PSTR("L: "));
+        for (uint8_t i = 0u; i < n; i++) {
+            printf_P(PSTR("%02x "), line[i]);
+        }
+        printf_P(PSTR("...\n"));
+
+        k_buf_unref(frame);
+    }
+}
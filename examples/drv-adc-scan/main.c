@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Scan ADC0 and ADC1 at 4 kS/s (2 kS/s per channel) triggered by timer 0,
+ * the main thread is only woken up once per block of 64 values and prints the
+ * mean of each channel every second.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/adc.h>
+
+#define CHANNELS_COUNT 2u
+#define BLOCK_LEN      64u
+#define PERIOD_US      250u
+
+/* Blocks of 32 values per channel at 2 kS/s */
+#define BLOCKS_PER_SECOND (1000000lu / (PERIOD_US * BLOCK_LEN))
+
+static const uint8_t channels[CHANNELS_COUNT] = {ADC_CHANNEL(0u), ADC_CHANNEL(1u)};
+
+static uint16_t buffers[2u][BLOCK_LEN];
+static struct adc_block blocks[2u] = {
+    ADC_BLOCK_INIT(buffers[0u]),
+    ADC_BLOCK_INIT(buffers[1u]),
+};
+
+static struct adc_scan scan = {
+    .channels       = channels,
+    .channels_count = CHANNELS_COUNT,
+    .oversampling   = 0u,
+    .trigger        = ADC_TRIGGER_TIMER0_COMPA,
+    .period_us      = PERIOD_US,
+    .blocks         = {&blocks[0u], &blocks[1u]},
+    .block_len      = BLOCK_LEN,
+};
+
+int main(void)
+{
+    uint32_t sums[CHANNELS_COUNT] = {0u};
+    uint16_t count                = 0u;
+
+    const struct adc_config config = {
+        .ref       = ADC_REF_AVCC,
+        .prescaler = ADC_PRESCALER_64,
+    };
+
+    adc_init(&config);
+
+    int8_t ret = adc_scan_start(&scan);
+    if (ret != 0) {
+        printf("adc_scan_start failed: %d\n", ret);
+        k_sleep(K_FOREVER);
+    }
+
+    for (;;) {
+        struct adc_block *const block = adc_scan_get(&scan, K_FOREVER);
+
+        for (uint16_t i = 0u; i < BLOCK_LEN; i += CHANNELS_COUNT) {
+            for (uint8_t c = 0u; c < CHANNELS_COUNT; c++) {
+                sums[c] += block->samples[i + c];
+            }
+        }
+
+        const uint32_t timestamp = block->timestamp;
+        adc_block_release(&scan, block);
+
+        if (++count == BLOCKS_PER_SECOND) {
+            printf("[%lu] ADC0 %u ADC1 %u overruns %u\n",
+                   timestamp,
+                   (uint16_t)(sums[0u] / (count * BLOCK_LEN / CHANNELS_COUNT)),
+                   (uint16_t)(sums[1u] / (count * BLOCK_LEN / CHANNELS_COUNT)),
+                   scan.overruns);
+
+            sums[0u] = 0u;
+            sums[1u] = 0u;
+            count    = 0u;
+        }
+    }
+}
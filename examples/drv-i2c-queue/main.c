@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read the temperature of all the TCN75 sensors found on the bus (0x48 to
+ * 0x4F) every second: the transactions of a cycle are queued at once and the
+ * thread sleeps until the last one completes.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/i2c.h>
+#include <avrtos/misc/serial.h>
+
+#define I2C_DEVICE I2C0_DEVICE
+
+#define TCN75_ADDR_FIRST 0x48u
+#define TCN75_COUNT      8u
+#define TCN75_REG_TEMP   0x00u
+
+struct sensor {
+    uint8_t reg;
+    uint8_t temp[2u];
+    struct i2c_msg msgs[2u];
+    struct i2c_xfer xfer;
+};
+
+static struct sensor sensors[TCN75_COUNT];
+
+K_SEM_DEFINE(cycle_done, 0u, 1u);
+
+int main(void)
+{
+    uint8_t bitmap[16u];
+    uint8_t count = 0u;
+
+    struct i2c_config config = {
+        .prescaler = I2C_PRESCALER_1,
+        .twbr      = I2C_CALC_TWBR(I2C_PRESCALER_1, 400000),
+    };
+
+    int8_t ret = i2c_init(I2C_DEVICE, config);
+    printf("i2c_init: %d\n", ret);
+
+    ret = i2c_scan(I2C_DEVICE, bitmap);
+    printf("i2c_scan: %d\n", ret);
+
+    for (uint8_t addr = TCN75_ADDR_FIRST; addr < TCN75_ADDR_FIRST + TCN75_COUNT; addr++) {
+        if (!(bitmap[addr >> 3u] & BIT(addr & 7u))) {
+            continue;
+        }
+
+        struct sensor *const s = &sensors[count++];
+
+        s->reg     = TCN75_REG_TEMP;
+        s->msgs[0] = (struct i2c_msg){.buf = &s->reg, .len = 1u, .flags = I2C_MSG_WRITE};
+        s->msgs[1] = (struct i2c_msg){.buf = s->temp, .len = 2u, .flags = I2C_MSG_READ};
+        s->xfer    = (struct i2c_xfer)I2C_XFER_INIT(addr, s->msgs, 2u, NULL);
+
+        printf("tcn75 found at 0x%02x\n", addr);
+    }
+
+    if (count == 0u) {
+        printf("no sensor found\n");
+        return 0;
+    }
+
+    /* Transactions are processed in order, only the last one signals the end
+     * of the cycle */
+    sensors[count - 1u].xfer.done = &cycle_done;
+
+    for (;;) {
+        for (uint8_t i = 0u; i < count; i++) {
+            i2c_submit(I2C_DEVICE, &sensors[i].xfer);
+        }
+
+        k_sem_take(&cycle_done, K_FOREVER);
+
+        for (uint8_t i = 0u; i < count; i++) {
+            struct sensor *const s = &sensors[i];
+
+            if (s->xfer.status == 0) {
+                /* 1/16 °C resolution */
+                const int16_t temp = ((int16_t)(s->temp[0] << 8u) | s->temp[1]) >> 4u;
+                printf("0x%02x: %d/16 C (errors %u)\n", s->xfer.addr, temp,
+                       s->xfer.errors);
+            } else {
+                printf("0x%02x: error %u (errors %u)\n", s->xfer.addr, s->xfer.error,
+                       s->xfer.errors);
+            }
+        }
+
+        k_sleep(K_MSEC(1000));
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the frequency and the duty cycle of the signal on ICP4 (PL0,
+ * ATmega2560) or ICP1 (PB0), e.g. a tachometer output: both edges are
+ * timestamped by the timer and the thread is woken up every 8 pulses.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/capture.h>
+
+#if defined(__AVR_ATmega2560__)
+#define CAPTURE_TIMER 4u
+#else
+#define CAPTURE_TIMER 1u
+#endif
+
+#define BATCH 16u
+
+static uint32_t buf[32u];
+static struct timer_capture cap = {
+    .buf   = buf,
+    .size  = ARRAY_SIZE(buf),
+    .batch = BATCH,
+};
+
+int main(void)
+{
+    uint32_t ts[BATCH];
+    struct timer_capture_measure m;
+
+    /* 0.5us resolution at 16MHz, pulses up to 2147s */
+    int8_t ret = timer_capture_start(CAPTURE_TIMER, &cap, TIMER_PRESCALER_8,
+                                     TIMER_CAPTURE_BOTH | TIMER_CAPTURE_NOISE_CANCELLER);
+    if (ret != 0) {
+        printf("timer_capture_start failed: %d\n", ret);
+        k_sleep(K_FOREVER);
+    }
+
+    for (;;) {
+        const int16_t n = timer_capture_read(&cap, ts, BATCH, K_SECONDS(1));
+
+        if ((n < 0) || (timer_capture_measure(&cap, ts, n, &m) != 0)) {
+            printf("no signal\n");
+            continue;
+        }
+
+        const uint32_t mhz = timer_capture_frequency_mhz(&cap, m.period);
+
+        printf("%lu.%03lu Hz duty %u %% (dropped %u)\n",
+               mhz / 1000u,
+               mhz % 1000u,
+               (uint16_t)(m.high * 100u / m.period),
+               cap.dropped);
+    }
+}
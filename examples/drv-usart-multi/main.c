@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// For ATmega328PB (USART1) or ATmega2560 (USART1 to USART3)
+
+/* Each port receives blocks of BLOCK_SIZE bytes with double buffering, and
+ * echoes them framed by a header and a trailer sent as a single
+ * scatter-gather transmission. The completions are waited in thread context
+ * (CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS), the ports are handled
+ * concurrently. The main USART (serial) reports the dropped blocks.
+ */
+
+#include <string.h>
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/usart.h>
+#include <avrtos/misc/serial.h>
+
+#include <avr/pgmspace.h>
+
+#define K_MODULE K_MODULE_APPLICATION
+
+#define BLOCK_SIZE 16u
+
+struct port {
+    UART_Device *dev;
+    char header[4u];
+    uint8_t rx[2u][BLOCK_SIZE];
+    /* Copy of the completed block, the driver reuses it once the other
+     * buffer is full, which is faster than echoing it */
+    uint8_t block[BLOCK_SIZE];
+    uint16_t dropped;
+};
+
+static const char trailer[] = "\r\n";
+
+const struct usart_config port_cfg PROGMEM = {
+    .baudrate    = USART_BAUD_115200,
+    .receiver    = 1,
+    .transmitter = 1,
+    .mode        = USART_MODE_ASYNCHRONOUS,
+    .parity      = USART_PARITY_NONE,
+    .stopbits    = USART_STOP_BITS_1,
+    .databits    = USART_DATA_BITS_8,
+    .speed_mode  = USART_SPEED_MODE_NORMAL,
+};
+
+static void port_thread(void *arg)
+{
+    struct port *const port = arg;
+    struct usart_config cfg;
+    void *buf;
+
+    memcpy_P(&cfg, &port_cfg, sizeof(struct usart_config));
+    usart_init(port->dev, &cfg);
+    usart_rx_enable_double(port->dev, port->rx[0u], port->rx[1u], BLOCK_SIZE);
+
+    const struct usart_tx_seg segs[] = {
+        {.buf = port->header, .len = sizeof(port->header)},
+        {.buf = port->block, .len = BLOCK_SIZE},
+        {.buf = trailer, .len = sizeof(trailer) - 1u},
+    };
+
+    for (;;) {
+        const int8_t dropped = usart_rx_wait(port->dev, &buf, K_FOREVER);
+        if (dropped < 0)
+            continue;
+
+        memcpy(port->block, buf, BLOCK_SIZE);
+
+        if (dropped != 0) {
+            port->dropped += (uint8_t)dropped;
+            printf_P(PSTR("%c%c: %u block(s) dropped (total %u)\n"), port->header[1u],
+                     port->header[2u], (uint8_t)dropped, port->dropped);
+        }
+
+        usart_tx_sg(port->dev, segs, ARRAY_SIZE(segs));
+        usart_tx_wait(port->dev, K_FOREVER);
+    }
+}
+
+#define PORT_DEFINE(_n, _symbol)                                                         \
+    static struct port port##_n = {                                                      \
+        .dev    = USART##_n##_DEVICE,                                                    \
+        .header = {'[', 'U', '0' + _n, ']'},                                             \
+    };                                                                                   \
+    K_THREAD_DEFINE(port##_n##_thread, port_thread, 0x100, K_PREEMPTIVE, &port##_n,      \
+                    _symbol)
+
+PORT_DEFINE(1, '1');
+#if CONFIG_DRIVERS_USART2_ASYNC
+PORT_DEFINE(2, '2');
+#endif
+#if CONFIG_DRIVERS_USART3_ASYNC
+PORT_DEFINE(3, '3');
+#endif
+
+int main(void)
+{
+    serial_init();
+
+    k_thread_dump_all();
+
+    for (;;) {
+        k_dump_stack_canaries();
+        k_sleep(K_SECONDS(30));
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Keypad and rotary encoder without polling threads: the 4 keys (PCINT0-3,
+ * active low) are debounced and notify a flags object, the encoder (INT0 and
+ * INT1) is decoded from the interrupts by the line callbacks.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/exti.h>
+#include <avrtos/drivers/gpio.h>
+
+#define KEYS_COUNT 4u
+#define DEBOUNCE   K_MSEC(20)
+
+#if defined(__AVR_ATmega2560__)
+#define ENCODER_PIN_A PIN0 /* INT0 */
+#define ENCODER_PIN_B PIN1 /* INT1 */
+#else
+#define ENCODER_PIN_A PIN2 /* INT0 */
+#define ENCODER_PIN_B PIN3 /* INT1 */
+#endif
+
+K_FLAGS_DEFINE(keys_flags, 0u);
+
+static struct exti_line keys[KEYS_COUNT];
+
+static struct encoder {
+    struct exti_line a;
+    struct exti_line b;
+    uint8_t state;
+    volatile int16_t position;
+} encoder;
+
+K_SEM_DEFINE(encoder_sem, 0u, 1u);
+
+/* Quadrature decoding, indexed by the previous and the new state (AB) */
+static const int8_t encoder_steps[16u] = {
+    0, -1, 1, 0, 1, 0, 0, -1, -1, 0, 0, 1, 0, 1, -1, 0,
+};
+
+static void encoder_handler(struct exti_line *line, uint8_t level)
+{
+    ARG_UNUSED(line);
+    ARG_UNUSED(level);
+
+    const uint8_t state = (encoder.a.level << 1u) | encoder.b.level;
+
+    encoder.position += encoder_steps[(encoder.state << 2u) | state];
+    encoder.state = state;
+}
+
+int main(void)
+{
+    for (uint8_t i = 0u; i < KEYS_COUNT; i++) {
+        gpiol_pin_init(GPIOB, i, GPIO_INPUT, PIN_PULLUP);
+
+        keys[i].flags      = &keys_flags;
+        keys[i].flags_mask = BIT(i);
+        pci_line_register(PCINT0 + i, &keys[i], EXTI_TRIG_FALLING, DEBOUNCE);
+    }
+
+    gpiol_pin_init(GPIOD, ENCODER_PIN_A, GPIO_INPUT, PIN_PULLUP);
+    gpiol_pin_init(GPIOD, ENCODER_PIN_B, GPIO_INPUT, PIN_PULLUP);
+
+    encoder.a.handler = encoder_handler;
+    encoder.a.sem     = &encoder_sem;
+    encoder.b.handler = encoder_handler;
+    encoder.b.sem     = &encoder_sem;
+    exti_line_register(INT0, &encoder.a, EXTI_TRIG_BOTH, K_NO_WAIT);
+    exti_line_register(INT1, &encoder.b, EXTI_TRIG_BOTH, K_NO_WAIT);
+    encoder.state = (encoder.a.level << 1u) | encoder.b.level;
+
+    for (;;) {
+        k_flags_value_t mask = BIT(KEYS_COUNT) - 1u;
+
+        if (k_flags_poll(&keys_flags, &mask, K_FLAGS_SET_ANY | K_FLAGS_CONSUME,
+                         K_MSEC(100)) > 0) {
+            for (uint8_t i = 0u; i < KEYS_COUNT; i++) {
+                if (mask & BIT(i)) {
+                    printf_P(PSTR("key %u pressed at %lu\n"), i, keys[i].timestamp);
+                }
+            }
+        }
+
+        if (k_sem_take(&encoder_sem, K_NO_WAIT) == 0) {
+            printf_P(PSTR("encoder: %d\n"), encoder.position);
+        }
+    }
+}
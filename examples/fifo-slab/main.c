@@ -79,6 +79,8 @@ void consumer_thread(void *arg)
 {
     ARG_UNUSED(arg);
 
+    uint8_t received = 0u;
+
     while (1) {
         struct block *mem = (struct block *)k_fifo_get(&fifo, K_FOREVER);
         if (mem != NULL) {
@@ -90,6 +92,14 @@ void consumer_thread(void *arg)
             k_sched_unlock();
 
             k_mem_slab_free(&myslab, (void *)mem);
+
+#if MEM_SLAB_COMPILATION_TIME
+            if ((++received % BLOCK_COUNT) == 0u) {
+                k_sched_lock();
+                k_mem_slab_stats_dump_all();
+                k_sched_unlock();
+            }
+#endif
         }
 
         k_sleep(K_SECONDS(1));
@@ -14,8 +14,54 @@
                 text:        1398 B       256 KB      0.53%
                 data:          30 B         8 KB      0.37%
 */
+
+/* Print the sizes of the kernel objects at startup (sample_footprint_report) */
+#ifndef FOOTPRINT_REPORT
+#define FOOTPRINT_REPORT 0
+#endif
+
+#if FOOTPRINT_REPORT
+static void report_size(const char *name, size_t size)
+{
+    serial_print_p(name);
+    serial_print_p(PSTR(": "));
+    serial_u16(size);
+    serial_transmit('\n');
+}
+
+/* RAM used by the kernel objects, see CONFIG_THREAD_COMPACT for the
+ * thread control block. */
+static void footprint_report(void)
+{
+    report_size(PSTR("struct k_thread"), sizeof(struct k_thread));
+    report_size(PSTR("struct z_kernel"), sizeof(struct z_kernel));
+    report_size(PSTR("struct k_sem"), sizeof(struct k_sem));
+    report_size(PSTR("struct k_mutex"), sizeof(struct k_mutex));
+    report_size(PSTR("struct k_signal"), sizeof(struct k_signal));
+    report_size(PSTR("struct k_flags"), sizeof(struct k_flags));
+    report_size(PSTR("struct k_fifo"), sizeof(struct k_fifo));
+    report_size(PSTR("struct k_msgq"), sizeof(struct k_msgq));
+    report_size(PSTR("struct k_mem_slab"), sizeof(struct k_mem_slab));
+    report_size(PSTR("struct k_timer"), sizeof(struct k_timer));
+    report_size(PSTR("struct k_event"), sizeof(struct k_event));
+    report_size(PSTR("struct k_work"), sizeof(struct k_work));
+    report_size(PSTR("struct k_pt"), sizeof(struct k_pt));
+
+#if CONFIG_AVRTOS_LINKER_SCRIPT
+    const uint8_t threads = &__k_threads_end - &__k_threads_start;
+
+    report_size(PSTR("threads"), threads);
+    report_size(PSTR("threads control blocks"), threads * sizeof(struct k_thread));
+#endif
+}
+#endif /* FOOTPRINT_REPORT */
+
 int main(void)
 {
+#if FOOTPRINT_REPORT
+    footprint_report();
+#endif
+
     for (;;) {
         serial_print_p(PSTR("Hello\n"));
         k_wait(K_SECONDS(1), K_WAIT_MODE_IDLE);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/drivers/gpio.h>
+#include <avrtos/drivers/timer.h>
+
+K_SEM_DEFINE(sem, 0, 255u);
+K_FLAGS_DEFINE(flags, 0u);
+
+K_POST_SEM_DEFINE(sem_post, sem);
+K_POST_FLAGS_DEFINE(flags_post, flags);
+
+static void flags_thread(void *arg);
+
+K_THREAD_DEFINE(fth, flags_thread, 0x100, K_PREEMPTIVE, NULL, 'f');
+
+static volatile uint8_t irq_count;
+
+/* The wake-up is only posted from the ISR, the semaphore is given from
+ * k_post_yield_from_isr() at the end of the handler. */
+ISR(TIMER3_COMPA_vect)
+{
+    GPIOB->PIN = BIT(5u);
+
+    k_post_submit(&sem_post, 0u);
+
+    k_post_yield_from_isr();
+}
+
+/* Bursts of wake-ups are coalesced, the flags are set once on the next
+ * thread switch or system tick. */
+ISR(TIMER4_COMPA_vect)
+{
+    irq_count++;
+
+    k_post_submit(&flags_post, BIT(irq_count & 0x3u));
+}
+
+int main(void)
+{
+    gpiol_init(GPIOB, 0xF0u, 0x00u);
+
+    struct timer_config timer_cfg = {
+        .counter   = TIMER_CALC_COUNTER_VALUE(500000u, 1024u),
+        .mode      = TIMER_MODE_CTC,
+        .prescaler = TIMER_PRESCALER_1024,
+        .timsk     = BIT(OCIEnA),
+    };
+    ll_timer16_init(TIMER3_DEVICE, timer_get_index(TIMER3_DEVICE), &timer_cfg);
+
+    timer_cfg.counter = TIMER_CALC_COUNTER_VALUE(100000u, 1024u);
+    ll_timer16_init(TIMER4_DEVICE, timer_get_index(TIMER4_DEVICE), &timer_cfg);
+
+    for (;;) {
+        k_sem_take(&sem, K_FOREVER);
+
+        GPIOB->PIN = BIT(7u);
+
+        serial_printl("IRQ !");
+    }
+}
+
+static void flags_thread(void *arg)
+{
+    ARG_UNUSED(arg);
+
+    for (;;) {
+        k_flags_value_t mask = 0x0Fu;
+        k_flags_poll(&flags, &mask, K_FLAGS_SET_ALL | K_FLAGS_CONSUME, K_FOREVER);
+
+        printf_P(PSTR("flags %x (irq %u)\n"), mask, irq_count);
+    }
+}
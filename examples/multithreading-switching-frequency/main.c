@@ -32,9 +32,15 @@
 // set to 1 to have 10kHz switching frequency
 #define SET_10kHz_SWITCHING_FREQUENCY 0
 
-// precize calculation : cycles, etc...
+// set to 1 to measure the cost of a context switch in CPU cycles (Timer 1
+// running at F_CPU) instead of toggling the led, results are printed on the
+// serial console.
+#ifndef CYCLE_COUNT_BENCHMARK
+#define CYCLE_COUNT_BENCHMARK 0
+#endif
 
 #include <avrtos/avrtos.h>
+#include <avrtos/drivers/timer.h>
 #include <avrtos/misc/led.h>
 #include <avrtos/misc/serial.h>
 
@@ -42,6 +48,113 @@
 
 void thread_led(void *p);
 
+#if CYCLE_COUNT_BENCHMARK
+
+#define ITERATIONS 1000u
+
+struct stats {
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+};
+
+/* Preemptive, so that the sysclock interrupt is able to switch threads */
+K_THREAD_DEFINE_STOPPED(ledon, thread_led, 0x100, K_PREEMPTIVE, NULL, 'O');
+
+static void stats_add(struct stats *st, uint16_t cycles)
+{
+    st->min = MIN(st->min, cycles);
+    st->max = MAX(st->max, cycles);
+    st->sum += cycles;
+}
+
+static void
+stats_print(const char *label, struct stats *st, uint16_t overhead, uint8_t div)
+{
+    printf_P(PSTR("%-16s min %u avg %lu max %u cycles\n"),
+             label,
+             (st->min - overhead) / div,
+             (st->sum / ITERATIONS - overhead) / div,
+             (st->max - overhead) / div);
+}
+
+/* The sysclock interrupt may preempt a measurement, which shows in max. */
+static uint16_t measure(void)
+{
+    const uint16_t t0 = ll_timer16_get_tcnt(TIMER1_DEVICE);
+    k_yield();
+    return ll_timer16_get_tcnt(TIMER1_DEVICE) - t0;
+}
+
+/* A gap between two consecutive reads of the counter is an interrupt, the
+ * sysclock one being the only enabled. */
+static uint16_t measure_tick(uint16_t overhead)
+{
+    uint16_t t0 = ll_timer16_get_tcnt(TIMER1_DEVICE);
+
+    for (;;) {
+        const uint16_t t1 = ll_timer16_get_tcnt(TIMER1_DEVICE);
+        if ((uint16_t)(t1 - t0) > overhead + 32u) {
+            return t1 - t0;
+        }
+        t0 = t1;
+    }
+}
+
+int main(void)
+{
+    struct stats overhead = {UINT16_MAX, 0u, 0u};
+    struct stats alone    = {UINT16_MAX, 0u, 0u};
+    struct stats tick     = {UINT16_MAX, 0u, 0u};
+    struct stats pingpong = {UINT16_MAX, 0u, 0u};
+
+    serial_init();
+
+    ll_timer16_start(TIMER1_DEVICE, TIMER_PRESCALER_1);
+
+    for (uint16_t i = 0u; i < ITERATIONS; i++) {
+        const uint16_t t0 = ll_timer16_get_tcnt(TIMER1_DEVICE);
+        stats_add(&overhead, ll_timer16_get_tcnt(TIMER1_DEVICE) - t0);
+    }
+
+    /* No other thread ready: the yield returns without switching */
+    for (uint16_t i = 0u; i < ITERATIONS; i++) {
+        stats_add(&alone, measure());
+    }
+
+    /* Sysclock interrupts with no other thread ready: the interrupted
+     * thread is resumed without calling the scheduler (fast path) */
+    for (uint16_t i = 0u; i < ITERATIONS; i++) {
+        stats_add(&tick, measure_tick(overhead.min));
+    }
+
+    /* Each yield switches to the other thread and back (two switches) */
+    k_thread_start(&ledon);
+    for (uint16_t i = 0u; i < ITERATIONS; i++) {
+        stats_add(&pingpong, measure());
+    }
+
+    printf_P(PSTR("fast paths: %u cooperative: %u\n"),
+             CONFIG_KERNEL_SCHEDULER_FAST_PATHS,
+             CONFIG_KERNEL_COOPERATIVE_THREADS);
+    stats_print("yield (alone)", &alone, overhead.min, 1u);
+    stats_print("tick (alone)", &tick, overhead.min, 1u);
+    stats_print("context switch", &pingpong, overhead.min, 2u);
+
+    k_sleep(K_FOREVER);
+}
+
+void thread_led(void *arg)
+{
+    ARG_UNUSED(arg);
+
+    while (1) {
+        k_yield();
+    }
+}
+
+#else
+
 K_THREAD_DEFINE(ledon, thread_led, 0x100, K_PRIO_DEFAULT, NULL, 'O');
 
 int main(void)
@@ -69,3 +182,5 @@ void thread_led(void *arg)
         k_yield();
     }
 }
+
+#endif /* CYCLE_COUNT_BENCHMARK */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the number of CPU cycles taken by an uncontended
+ * k_mutex_lock()/k_mutex_unlock() pair, using TIMER3 clocked at F_CPU.
+ *
+ * The benchmark is built twice (CONFIG_KERNEL_MUTEX_FAST_PATH=0/1).
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/drivers/timer.h>
+
+#define ITERATIONS 100u
+
+K_MUTEX_DEFINE(mutex);
+
+static uint16_t measure(bool lock)
+{
+    const uint8_t key = irq_lock();
+
+    TIMER3_DEVICE->TCNTn = 0u;
+
+    for (uint8_t i = 0u; i < ITERATIONS; i++) {
+        if (lock) {
+            k_mutex_lock(&mutex, K_FOREVER);
+            k_mutex_unlock(&mutex);
+        } else {
+            /* Loop overhead only */
+            __asm__ __volatile__("" ::: "memory");
+        }
+    }
+
+    const uint16_t cycles = TIMER3_DEVICE->TCNTn;
+
+    irq_unlock(key);
+
+    return cycles;
+}
+
+int main(void)
+{
+    /* Normal mode, no prescaler: TCNT3 counts CPU cycles */
+    TIMER3_DEVICE->TCCRnA = 0u;
+    TIMER3_DEVICE->TCCRnB = BIT(CSn0);
+
+    for (;;) {
+        const uint16_t overhead = measure(false);
+        const uint16_t total    = measure(true);
+
+        printf_P(PSTR("fast path: %u lock/unlock: %u cycles (x%u) overhead: %u\n"),
+                 CONFIG_KERNEL_MUTEX_FAST_PATH, (total - overhead) / ITERATIONS,
+                 ITERATIONS, overhead);
+
+        k_sleep(K_SECONDS(1));
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Pipe Demo
+ * =========
+ * The main thread writes variable-length frames to a small pipe, a consumer
+ * thread reads whatever is available (at least one byte) and checks the
+ * received byte stream is continuous.
+ *
+ * Frames larger than the ring buffer of the pipe are transferred directly to
+ * the buffer of the waiting consumer.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+
+#include <avr/pgmspace.h>
+
+K_PIPE_DEFINE(pipe, 16u);
+
+void consumer_thread(void *arg);
+
+K_THREAD_DEFINE(consumer, consumer_thread, 0x100, K_PREEMPTIVE, NULL, 'C');
+
+int main(void)
+{
+    uint8_t frame[40u];
+    uint8_t seq = 0u;
+    uint8_t len = 1u;
+
+    for (;;) {
+        for (uint8_t i = 0u; i < len; i++) {
+            frame[i] = seq++;
+        }
+
+        int ret = k_pipe_write(&pipe, frame, len, len, K_FOREVER);
+        if (ret != len) {
+            printf_P(PSTR("W: write failed %d\n"), ret);
+        }
+
+        len = (len % sizeof(frame)) + 1u;
+
+        k_sleep(K_MSEC(20));
+    }
+}
+
+void consumer_thread(void *arg)
+{
+    uint8_t buf[24u];
+    uint8_t expected = 0u;
+    uint32_t total   = 0u;
+
+    for (;;) {
+        int ret = k_pipe_read(&pipe, buf, sizeof(buf), 1u, K_SECONDS(1));
+        if (ret < 0) {
+            printf_P(PSTR("R: read failed %d\n"), ret);
+            continue;
+        }
+
+        for (uint8_t i = 0u; i < (uint8_t)ret; i++) {
+            if (buf[i] != expected) {
+                printf_P(PSTR("R: discontinuity %u != %u\n"), buf[i], expected);
+                expected = buf[i];
+            }
+            expected++;
+        }
+
+        total += (uint8_t)ret;
+        if ((total & 0xFFu) < (uint8_t)ret) {
+            printf_P(PSTR("R: %lu bytes received\n"), total);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Stackless Tasks Demo
+ * ====================
+ * 48 protocol sessions run as stackless tasks on the stack of a single thread.
+ *
+ * The main thread simulates the reception of frames: it puts the identifier of
+ * the destination session in a message queue. A dispatcher task gets the
+ * identifiers from the message queue and wakes up the corresponding session,
+ * which "processes" the frame for a few milliseconds. A session which did not
+ * receive any frame for 2 seconds counts a timeout.
+ *
+ * A reporter task prints the totals every 5 seconds.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+
+#include <avr/pgmspace.h>
+
+#define SESSIONS_COUNT 48u
+
+struct session {
+    struct k_pt pt;
+    uint16_t rx;
+    uint16_t timeouts;
+};
+
+static struct session sessions[SESSIONS_COUNT];
+static struct k_pt dispatcher;
+static struct k_pt reporter;
+
+K_MSGQ_DEFINE(frames, sizeof(uint8_t), 8u);
+
+/* Only the dispatcher waits for an object (the others wait for events or
+ * timeouts), a few poll slots are enough. */
+K_PT_RUNNER_DEFINE(runner, 2u);
+
+K_THREAD_DEFINE(pt_thread, k_pt_runner_run, 0x100, K_COOPERATIVE, &runner, 'P');
+
+static int8_t session_handler(struct k_pt *pt)
+{
+    struct session *s = pt->arg;
+
+    K_PT_BEGIN(pt);
+
+    for (;;) {
+        K_PT_WAIT_EVENT(pt, K_SECONDS(2));
+        if (k_pt_timed_out(pt)) {
+            s->timeouts++;
+            continue;
+        }
+
+        s->rx++;
+
+        /* Processing */
+        K_PT_SLEEP(pt, K_MSEC(5));
+    }
+
+    K_PT_END(pt);
+}
+
+static int8_t dispatcher_handler(struct k_pt *pt)
+{
+    uint8_t id;
+    int8_t ret;
+
+    K_PT_BEGIN(pt);
+
+    for (;;) {
+        K_PT_MSGQ_GET(pt, &frames, &id, K_FOREVER, ret);
+        if ((ret == 0) && (id < SESSIONS_COUNT)) {
+            k_pt_wake(&sessions[id].pt);
+        }
+    }
+
+    K_PT_END(pt);
+}
+
+static int8_t reporter_handler(struct k_pt *pt)
+{
+    K_PT_BEGIN(pt);
+
+    for (;;) {
+        K_PT_SLEEP(pt, K_SECONDS(5));
+
+        uint32_t rx       = 0u;
+        uint32_t timeouts = 0u;
+        for (uint8_t i = 0u; i < SESSIONS_COUNT; i++) {
+            rx += sessions[i].rx;
+            timeouts += sessions[i].timeouts;
+        }
+
+        printf_P(PSTR("rx: %lu timeouts: %lu\n"), rx, timeouts);
+    }
+
+    K_PT_END(pt);
+}
+
+int main(void)
+{
+    uint8_t id = 0u;
+
+    for (uint8_t i = 0u; i < SESSIONS_COUNT; i++) {
+        k_pt_start(&runner, &sessions[i].pt, session_handler, &sessions[i]);
+    }
+    k_pt_start(&runner, &dispatcher, dispatcher_handler, NULL);
+    k_pt_start(&runner, &reporter, reporter_handler, NULL);
+
+    printf_P(PSTR("%u sessions, %u bytes each\n"), SESSIONS_COUNT,
+             sizeof(struct session));
+
+    for (;;) {
+        k_msgq_put(&frames, &id, K_FOREVER);
+
+        /* Skip sessions to make some of them time out */
+        id = (id + 7u) % (SESSIONS_COUNT + 8u);
+
+        k_sleep(K_MSEC(10));
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read-Write Lock Demo
+ * ====================
+ * A configuration table is read by three preemptive threads and updated
+ * every two seconds by the main thread.
+ *
+ * Readers hold the lock concurrently, even when preempted in the middle of a
+ * lookup. When the writer requests the lock, new readers are blocked until
+ * the update is done, the table is then never seen partially updated.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+
+#include <avr/pgmspace.h>
+
+#define TABLE_SIZE 8u
+
+static uint8_t table[TABLE_SIZE];
+
+K_RWLOCK_DEFINE(table_lock);
+
+void reader_thread(void *arg);
+
+K_THREAD_DEFINE(r1, reader_thread, 0x100, K_PREEMPTIVE, (void *)1, '1');
+K_THREAD_DEFINE(r2, reader_thread, 0x100, K_PREEMPTIVE, (void *)2, '2');
+K_THREAD_DEFINE(r3, reader_thread, 0x100, K_PREEMPTIVE, (void *)3, '3');
+
+int main(void)
+{
+    uint8_t generation = 0u;
+
+    for (;;) {
+        k_sleep(K_SECONDS(2));
+
+        k_rwlock_write_lock(&table_lock, K_FOREVER);
+
+        generation++;
+        for (uint8_t i = 0u; i < TABLE_SIZE; i++) {
+            table[i] = generation;
+        }
+
+        k_rwlock_write_unlock(&table_lock);
+
+        printf_P(PSTR("W: generation %u\n"), generation);
+    }
+}
+
+void reader_thread(void *arg)
+{
+    const uint8_t id = (uint8_t)(uint16_t)arg;
+
+    for (;;) {
+        k_rwlock_read_lock(&table_lock, K_FOREVER);
+
+        /* The table must be consistent while the lock is held */
+        const uint8_t first = table[0];
+        bool consistent     = true;
+        for (uint8_t i = 1u; i < TABLE_SIZE; i++) {
+            consistent &= (table[i] == first);
+            _delay_us(100);
+        }
+
+        k_rwlock_read_unlock(&table_lock);
+
+        if (!consistent) {
+            printf_P(PSTR("R%u: inconsistent table !\n"), id);
+        }
+
+        k_sleep(K_MSEC(10u * id));
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sample the TCN75 sensors found on the bus from a single acquisition thread:
+ * every 100 ms the reads of all the sensors are done in one I2C burst, and one
+ * sample (min/max/mean of 10 values) per sensor is printed every second.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/devices/tcn75.h>
+#include <avrtos/drivers/i2c.h>
+#include <avrtos/misc/serial.h>
+#include <avrtos/subsystems/sensor.h>
+
+#define I2C_DEVICE   I2C0_DEVICE
+#define TCN75_COUNT  8u
+#define PERIOD       K_MSEC(100)
+#define DECIMATION   10u
+
+K_MSGQ_DEFINE(samples, sizeof(struct sensor_sample), TCN75_COUNT);
+
+static struct sensor_engine engine;
+static struct tcn75_device devices[TCN75_COUNT];
+static struct tcn75_sensor sensors[TCN75_COUNT];
+
+static void acquisition_thread(void *arg)
+{
+    sensor_engine_run(arg);
+}
+
+K_THREAD_DEFINE_STOPPED(
+    acquisition, acquisition_thread, 0x100, K_COOPERATIVE, &engine, 'A');
+
+int main(void)
+{
+    uint8_t bitmap[16u];
+
+    struct i2c_config config = {
+        .prescaler = I2C_PRESCALER_1,
+        .twbr      = I2C_CALC_TWBR(I2C_PRESCALER_1, 400000),
+    };
+
+    i2c_init(I2C_DEVICE, config);
+    i2c_scan(I2C_DEVICE, bitmap);
+
+    sensor_engine_init(&engine, I2C_DEVICE, &samples, K_MSEC(5));
+
+    for (uint8_t i = 0u; i < TCN75_COUNT; i++) {
+        tcn75_init_context(&devices[i], i, TCN75_DEFAULT_CONFIG, I2C_DEVICE);
+        if (!(bitmap[devices[i].addr >> 3u] & BIT(devices[i].addr & 7u))) {
+            continue;
+        }
+
+        tcn75_configure(&devices[i]);
+        tcn75_sensor_init(&sensors[i], &devices[i], devices[i].addr);
+        sensor_register(&engine, &sensors[i].sensor, PERIOD, DECIMATION);
+
+        printf("tcn75 registered at 0x%02x\n", devices[i].addr);
+    }
+
+    k_thread_start(&acquisition);
+
+    for (;;) {
+        struct sensor_sample s;
+
+        k_msgq_get(&samples, &s, K_FOREVER);
+
+        printf("[%lu] 0x%02x: %d %d %d (x%u) dropped %u\n",
+               s.timestamp,
+               s.id,
+               s.min,
+               s.mean,
+               s.max,
+               s.count,
+               engine.dropped);
+    }
+}
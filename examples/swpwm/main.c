@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * 16 LEDs on PORTA and PORTC (ATmega2560) fading with a phase shift, driven
+ * by a 200Hz software PWM on timer 3. The CPU load of the PWM interrupts is
+ * printed every second.
+ */
+
+#include <avrtos/avrtos.h>
+#include <avrtos/debug.h>
+#include <avrtos/drivers/swpwm.h>
+
+#define LEDS_COUNT 16u
+#define PERIOD_US  5000u
+#define STEPS      64u
+
+/* Quadratic ramp, perceived as linear */
+static uint16_t fade(uint8_t step)
+{
+    const uint8_t x  = (step < STEPS / 2u) ? step : STEPS - 1u - step;
+    const uint32_t v = (uint32_t)x * x * (SWPWM_DUTY_MAX / ((STEPS / 2u) * (STEPS / 2u)));
+
+    return (uint16_t)MIN(v, SWPWM_DUTY_MAX);
+}
+
+int main(void)
+{
+    int8_t channels[LEDS_COUNT];
+
+    swpwm_init(PERIOD_US);
+
+    for (uint8_t i = 0u; i < LEDS_COUNT; i++) {
+        channels[i] = swpwm_channel_add(i < 8u ? GPIOA : GPIOC, i & 0x07u);
+    }
+
+    swpwm_start();
+
+    for (uint16_t t = 0u;; t++) {
+        for (uint8_t i = 0u; i < LEDS_COUNT; i++) {
+            swpwm_set(channels[i], fade((t + i * (STEPS / LEDS_COUNT)) % STEPS));
+        }
+        swpwm_update();
+
+        if ((t % 50u) == 0u) {
+            printf("load %u/1000\n", swpwm_load());
+        }
+
+        k_sleep(K_MSEC(20));
+    }
+}
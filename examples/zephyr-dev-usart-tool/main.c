@@ -60,7 +60,7 @@ void usart_ipc_callback(UART_Device *dev, struct usart_async_context *ctx)
     ARG_UNUSED(dev);
 
     if (ctx->evt == USART_EVENT_RX_COMPLETE) {
-        k_msgq_put(&ipc_msgq, ctx->rx.buf, K_NO_WAIT);
+        k_msgq_put(&ipc_msgq, ctx->rx.done, K_NO_WAIT);
     } else if (ctx->evt == USART_EVENT_TX_COMPLETE) {
         k_sem_give(&tx_finished_sem);
     }
@@ -26,6 +26,7 @@ const SOURCES: &[&str] = &[
     "../src/avrtos/dstruct/tdqueue.c",
     "../src/avrtos/alloc/default.c",
     "../src/avrtos/alloc/bump.c",
+    "../src/avrtos/alloc/tlsf.c",
     "../src/avrtos/alloc/slab.c",
     "../src/avrtos/misc/led.c",
     "../src/avrtos/misc/serial.c",
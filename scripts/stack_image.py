@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the initial stacks of the static threads at build time.
+
+The initial context of the threads defined with K_THREAD_DEFINE() is built by
+the compiler, which stores the addresses (entry point, context and return
+address) little-endian while they are popped big-endian by the context switch.
+The kernel swaps them at boot, and fills the stacks with canaries if
+CONFIG_THREAD_CANARIES is enabled.
+
+With CONFIG_THREAD_STACK_IMAGE enabled, this script patches the .data image of
+the ELF file after the link instead, then marks the image as patched so that
+the kernel skips these steps. The script does nothing if the ELF file was built
+without CONFIG_THREAD_STACK_IMAGE, or was already patched.
+
+Usage:
+
+    python3 scripts/stack_image.py build/examples/fifo/fifo.elf
+
+The .hex file must be generated from the patched ELF file.
+"""
+
+import argparse
+import struct
+import sys
+
+SHT_SYMTAB = 2
+
+# Offsets in struct z_callsaved_ctx
+CTX_THREAD_ENTRY = 15
+CTX_THREAD_CONTEXT = 17
+
+# Data addresses are offset in the AVR ELF address space
+DATA_OFFSET = 0x800000
+
+
+class Elf:
+    def __init__(self, data):
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("not a 32-bit little-endian ELF file")
+        self.data = data
+
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize)
+                    for i in range(shnum)]
+
+        names = sections[shstrndx]
+        self.sections = {}
+        for sh in sections:
+            self.sections[self._str(names[4], sh[0])] = sh
+
+        self.symbols = {}
+        for sh in sections:
+            if sh[1] != SHT_SYMTAB:
+                continue
+            strtab = sections[sh[6]][4]
+            for off in range(sh[4], sh[4] + sh[5], sh[9]):
+                name, value, size = struct.unpack_from("<III", data, off)
+                if name:
+                    self.symbols[self._str(strtab, name)] = (value, size)
+
+    def _str(self, table, offset):
+        end = self.data.index(b"\0", table + offset)
+        return self.data[table + offset:end].decode()
+
+    def offset(self, addr, length=1):
+        """File offset of a data address, the range must be in .data."""
+        _, _, _, sh_addr, sh_offset, sh_size = self.sections[".data"][:6]
+        addr |= DATA_OFFSET
+        if not sh_addr <= addr <= addr + length <= sh_addr + sh_size:
+            raise ValueError(f"0x{addr:x} not in .data")
+        return sh_offset + addr - sh_addr
+
+
+def swap16(data, off):
+    data[off], data[off + 1] = data[off + 1], data[off]
+
+
+def patch(elf):
+    data = elf.data
+    symbols = elf.symbols
+
+    desc = elf.offset(symbols["z_stack_image"][0], 6)
+    patched, thread_size, ctx_size, sentinel_size, canaries, canary = data[desc:desc + 6]
+    if patched:
+        print("Stack image already patched")
+        return
+
+    stacks = [value for name, value in symbols.items() if name.startswith("z_stack_buf_")]
+    main = symbols["z_thread_main"][0]
+    start = symbols["__k_threads_start"][0]
+    end = symbols["__k_threads_end"][0]
+
+    for thread in range(start, end, thread_size):
+        if thread == main:
+            continue
+
+        sp, = struct.unpack_from("<H", data, elf.offset(thread, 2))
+        ctx = elf.offset(sp + 1, ctx_size)
+
+        # Same as z_thread_finalize_stack_init()
+        swap16(data, ctx + CTX_THREAD_ENTRY)
+        swap16(data, ctx + CTX_THREAD_CONTEXT)
+        swap16(data, ctx + ctx_size - 2)  # pc
+
+        if canaries:
+            # Same as z_init_thread_stack_canaries()
+            base = [(addr, size) for addr, size in stacks
+                    if addr <= (sp + 1) | DATA_OFFSET < addr + size]
+            if not base:
+                raise ValueError(f"no stack found for thread at 0x{thread:x}")
+            stack = elf.offset(base[0][0] + sentinel_size)
+            data[stack:ctx] = bytes([canary]) * (ctx - stack)
+
+    data[desc] = 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the initial stacks of the "
+                                                 "static threads at build time.")
+    parser.add_argument("elf", help="ELF file, patched in place")
+    parser.add_argument("-o", "--output", help="Output ELF file (default: in place)")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as f:
+        elf = Elf(bytearray(f.read()))
+
+    if "z_stack_image" not in elf.symbols:
+        # Built without CONFIG_THREAD_STACK_IMAGE
+        return 0
+
+    try:
+        patch(elf)
+    except (KeyError, ValueError) as e:
+        # The kernel falls back to the initialization at boot
+        print(f"warning: stack image not generated: {e}", file=sys.stderr)
+        return 0
+
+    with open(args.output or args.elf, "wb") as f:
+        f.write(elf.data)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Static worst-case stack usage estimation.
+
+The stack usage of each function is read from the .su files generated by
+avr-gcc with -fstack-usage, the call graph is built from the disassembly of
+the ELF file (call/rcall/jmp/rjmp instructions). The worst-case stack usage of
+a thread is the deepest path of the call graph starting at its entry function,
+each call costing the size of the return address.
+
+-fstack-usage must be used without LTO, e.g. for a CMake build:
+
+    cmake -DCMAKE_BUILD_TYPE=Release \\
+          -DCMAKE_C_FLAGS_RELEASE="-Os -fno-lto -fstack-usage" ...
+
+Usage:
+
+    python3 scripts/stack_usage.py build/examples/fifo/fifo.elf \\
+        --su-dir build --entry main --entry consumer_thread:0x100
+
+Functions called indirectly (icall/eicall, e.g. callbacks) and recursive calls
+cannot be bounded statically, they are reported and must be accounted for
+manually (--extra option).
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# Size of a return address pushed by call/rcall
+PC_SIZE = {"avr6": 3}
+DEFAULT_PC_SIZE = 2
+
+# Registers saved on the stack of a thread by a context switch (call-saved
+# registers, SREG, ...), plus the return address (Z_CALLSAVED_CTX_SIZE)
+CONTEXT_SIZE = 19
+
+SU_LINE = re.compile(r"^(?P<loc>.+):(?P<func>[^:\s]+)\s+(?P<size>\d+)\s+(?P<kind>[\w,]+)$")
+FUNC_LINE = re.compile(r"^[0-9a-f]+ <(?P<name>[^>]+)>:$")
+CALL_LINE = re.compile(r"\s(?P<insn>r?call|r?jmp)\s+[^<*]*<(?P<target>[^>+]+)(\+0x[0-9a-f]+)?>")
+ICALL_LINE = re.compile(r"\s(e?icall|e?ijmp)\b")
+
+
+def parse_su_files(su_dir):
+    """Returns {function: (size, kind)} from all .su files found in su_dir."""
+    usage = {}
+    for root, _, files in os.walk(su_dir):
+        for name in files:
+            if not name.endswith(".su"):
+                continue
+            with open(os.path.join(root, name), "r", encoding="utf-8") as f:
+                for line in f:
+                    m = SU_LINE.match(line.strip())
+                    if not m:
+                        continue
+                    func = m.group("func")
+                    size = int(m.group("size"))
+                    # Static functions with the same name: keep the worst
+                    if func not in usage or usage[func][0] < size:
+                        usage[func] = (size, m.group("kind"))
+    return usage
+
+
+def parse_call_graph(elf, objdump):
+    """Returns ({function: set(callees)}, set(functions with indirect calls))."""
+    out = subprocess.run([objdump, "-d", elf], check=True, capture_output=True, text=True).stdout
+
+    graph = {}
+    indirect = set()
+    current = None
+
+    for line in out.splitlines():
+        m = FUNC_LINE.match(line)
+        if m:
+            current = m.group("name")
+            graph.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        m = CALL_LINE.search(line)
+        if m:
+            target = m.group("target")
+            # Jumps within the function are not calls
+            if target != current:
+                graph[current].add(target)
+        elif ICALL_LINE.search(line):
+            indirect.add(current)
+
+    return graph, indirect
+
+
+class Analyzer:
+    def __init__(self, usage, graph, indirect, pc_size):
+        self.usage = usage
+        self.graph = graph
+        self.indirect = indirect
+        self.pc_size = pc_size
+        self.cache = {}
+        self.unknown = set()
+        self.recursive = set()
+        self.dynamic = set()
+
+    def frame(self, func):
+        if func in self.usage:
+            size, kind = self.usage[func]
+            if "dynamic" in kind:
+                self.dynamic.add(func)
+            return size
+        # Assembly or library functions without .su information
+        self.unknown.add(func)
+        return 0
+
+    def worst(self, func, path=()):
+        """Returns (worst-case stack usage, deepest call path) of func."""
+        size, deepest_path, _ = self._worst(func, path)
+        return size, deepest_path
+
+    def _worst(self, func, path):
+        """Returns (worst-case stack usage, deepest call path, whether a recursion
+        was cut under func) of func."""
+        if func in path:
+            self.recursive.add(func)
+            return 0, [], True
+        if func in self.cache:
+            return self.cache[func] + (False,)
+
+        deepest, deepest_path, cut = 0, [], False
+        for callee in sorted(self.graph.get(func, ())):
+            size, callee_path, callee_cut = self._worst(callee, path + (func,))
+            cut |= callee_cut
+            if size + self.pc_size > deepest:
+                deepest, deepest_path = size + self.pc_size, callee_path
+
+        result = (self.frame(func) + deepest, [func] + deepest_path)
+        # A result truncated by a recursion cut depends on the path it was
+        # reached from, only the results computed without any cut are cached
+        if not cut:
+            self.cache[func] = result
+        return result + (cut,)
+
+
+def parse_entry(arg):
+    if ":" in arg:
+        name, size = arg.split(":", 1)
+        return name, int(size, 0)
+    return arg, None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Estimate worst-case stack usage of threads.")
+    parser.add_argument("elf", help="ELF file (built with -fstack-usage, without LTO)")
+    parser.add_argument("--su-dir", required=True, help="Directory containing the .su files")
+    parser.add_argument("--entry", action="append", required=True, type=parse_entry,
+                        help="Thread entry function, optionally with its stack size "
+                             "(e.g. consumer_thread:0x100)")
+    parser.add_argument("--arch", default="avr5", help="AVR architecture (return address size)")
+    parser.add_argument("--isr", action="store_true",
+                        help="Add the worst interrupt handler (__vector_*) to each thread")
+    parser.add_argument("--extra", type=int, default=0,
+                        help="Bytes added to each thread (e.g. indirect calls)")
+    parser.add_argument("--objdump", default="avr-objdump", help="objdump executable")
+    parser.add_argument("--verbose", action="store_true", help="Print the deepest call path")
+    args = parser.parse_args()
+
+    usage = parse_su_files(args.su_dir)
+    if not usage:
+        print(f"No .su file found in {args.su_dir}, build with -fstack-usage", file=sys.stderr)
+        return 1
+
+    graph, indirect = parse_call_graph(args.elf, args.objdump)
+    analyzer = Analyzer(usage, graph, indirect, PC_SIZE.get(args.arch, DEFAULT_PC_SIZE))
+
+    isr_worst, isr_name = 0, None
+    if args.isr:
+        for func in graph:
+            if func.startswith("__vector_"):
+                size, _ = analyzer.worst(func)
+                if size > isr_worst:
+                    isr_worst, isr_name = size, func
+        if isr_name:
+            print(f"Worst interrupt: {isr_name} {isr_worst} bytes")
+
+    status = 0
+    print(f"{'entry':<32} {'worst':>6} {'stack':>6} {'margin':>7}")
+    for name, stack_size in args.entry:
+        if name not in graph:
+            print(f"{name:<32} not found in {args.elf}", file=sys.stderr)
+            status = 1
+            continue
+
+        size, path = analyzer.worst(name)
+        total = size + CONTEXT_SIZE + analyzer.pc_size + isr_worst + args.extra
+        path_indirect = [f for f in path if f in indirect]
+
+        line = f"{name:<32} {total:>6}"
+        if stack_size is not None:
+            margin = stack_size - total
+            line += f" {stack_size:>6} {margin:>7}"
+            if margin < 0:
+                status = 1
+        if path_indirect:
+            line += " (indirect calls: " + ", ".join(path_indirect) + ")"
+        print(line)
+
+        if args.verbose:
+            print("    " + " -> ".join(path))
+
+    for label, funcs in (("Recursive", analyzer.recursive),
+                         ("Dynamic stack", analyzer.dynamic),
+                         ("Indirect calls", analyzer.indirect & set(analyzer.cache)),
+                         ("No stack usage information", analyzer.unknown)):
+        if funcs:
+            print(f"{label}: " + ", ".join(sorted(funcs)))
+
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
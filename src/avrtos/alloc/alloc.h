@@ -5,17 +5,26 @@
  */
 
 /**
- * This header provides EXPERIMENTAL memory allocation functions, including standard
- * and aligned memory allocation. The current default allocator is a BUMP ALLOCATOR,
- * which means:
+ * This header provides memory allocation functions, including standard, aligned
+ * memory allocation and reallocation. The default allocator is a TLSF (Two-Level
+ * Segregated Fit) allocator, which means:
  *
- *  - Memory is allocated sequentially from a preallocated buffer.
- *  - Individual memory blocks cannot be freed; only a full reset is possible.
- *  - Allocation is fast (O(1)) !
+ *  - Allocation and deallocation are bounded in time (O(1)) !
+ *  - Freed blocks are merged with their free neighbours immediately.
+ *  - Each block has a 4-byte header, sizes are rounded to 4 bytes.
  *
- * @warning **Experimental Feature:** The bump allocator is currently the default
- * allocator. It does not support freeing
- * individual allocations (`k_free` is a no-op in this implementation).
+ * The allocator is thread-safe (interrupts are disabled during the short
+ * critical sections) and can be used from ISRs.
+ *
+ * Small allocations (up to 8, 16, 32 or 64 bytes) can be served by size classes
+ * backed by memory slabs (CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_*): these are
+ * allocated and freed in a few tens of cycles without fragmenting the heap.
+ * The heap is used when the class is exhausted, for larger or aligned
+ * allocations.
+ *
+ * With CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF=0, the EXPERIMENTAL bump allocator is
+ * used instead: individual allocations cannot be freed (`k_free` is a no-op),
+ * only a full reset is possible.
  *
  * ## Memory Space and Configuration
  *
@@ -37,6 +46,19 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+struct alloc_stats;
+
+/**
+ * @brief Statistics of a size class of the default allocator
+ */
+struct k_malloc_class_stats {
+    uint16_t block_size; /**< Largest allocation served by the class */
+    uint8_t count;       /**< Number of blocks of the class */
+    uint8_t used;        /**< Number of blocks currently allocated */
+    uint8_t max_used;    /**< Maximum number of blocks allocated at once */
+    uint16_t fallbacks;  /**< Allocations served by the heap, class exhausted */
+};
+
 /**
  * @brief Allocate memory using default allocator
  *
@@ -49,10 +71,24 @@ void *k_malloc(size_t size);
 /**
  * @brief Free memory using default allocator
  *
- * @param ptr Pointer to memory to free
+ * @param ptr Pointer to memory to free, can be NULL
  */
 void k_free(void *ptr);
 
+/**
+ * @brief Resize memory allocated with the default allocator
+ *
+ * Content is preserved up to the minimum of the old and new sizes.
+ *
+ * @note Not supported by the bump allocator (NULL is returned unless ptr is NULL).
+ *
+ * @param ptr Pointer to memory to resize, NULL behaves as k_malloc()
+ * @param size New size of memory, 0 behaves as k_free()
+ * @return void* Pointer to resized memory
+ * @return NULL on error, the original memory is then left untouched
+ */
+void *k_realloc(void *ptr, size_t size);
+
 /**
  * @brief Allocate aligned memory using default allocator
  *
@@ -79,13 +115,42 @@ void *z_malloc(size_t size, uint8_t align);
  */
 void z_global_allocator_reset(void);
 
+/**
+ * @brief Initialize the default allocator, called on kernel initialization
+ */
+void z_global_allocator_init(void);
+
 /**
  * @brief Get statistics of the default allocator
  *
- * @param stats Pointer to a structure to store statistics
+ * @param total Pointer to store the total size of the heap
+ * @param used Pointer to store the amount of allocated memory
+ * @param free Pointer to store the amount of free memory
  */
 void k_global_allocator_stats_get(size_t *total, size_t *used, size_t *free);
 
+/**
+ * @brief Get detailed statistics of the default allocator
+ *
+ * In addition to k_global_allocator_stats_get(), the largest free block and
+ * the number of free blocks give the fragmentation of the heap.
+ *
+ * @param stats Pointer to a structure to store statistics
+ */
+void k_global_allocator_stats(struct alloc_stats *stats);
+
+/**
+ * @brief Get statistics of a size class of the default allocator
+ *
+ * Classes are indexed by increasing block size, only enabled classes are
+ * counted. The heap statistics do not include the size classes.
+ *
+ * @param index Index of the size class
+ * @param stats Pointer to a structure to store statistics
+ * @return int8_t 0 on success, -EINVAL if the class does not exist
+ */
+int8_t k_malloc_class_stats_get(uint8_t index, struct k_malloc_class_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,17 @@ struct alloc_stats {
      * @brief Amount of free (unallocated) memory
      */
     size_t free;
+
+    /**
+     * @brief Size of the largest free block (free memory is fragmented if
+     * smaller than free)
+     */
+    size_t largest_free;
+
+    /**
+     * @brief Number of free blocks
+     */
+    size_t free_blocks;
 };
 
 typedef struct allocator_api {
@@ -59,4 +59,7 @@ void bump_stats(struct bump_allocator *a, struct alloc_stats *stats)
     stats->total = a->size;
     stats->used  = a->next - a->buf;
     stats->free  = a->size - stats->used;
+
+    stats->largest_free = stats->free;
+    stats->free_blocks  = stats->free ? 1u : 0u;
 }
\ No newline at end of file
@@ -6,21 +6,122 @@
 
 /** Default allocator */
 
+#include <string.h>
+
 #include <avrtos/kernel.h>
+#include <avrtos/mem_slab.h>
 
 #include "alloc.h"
 #include "alloc_private.h"
 #include "bump.h"
+#include "tlsf.h"
 
 #define K_MODULE K_MODULE_ALLOC
 
 #if CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE > 0
+
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+TLSF_ALLOC_DEFINE(z_global_allocator, CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE);
+#else
 #warning "Global allocator is enabled and uses the bump allocator implementation"
 
-/* Current global allocator relies on the bump allocator, which is totally
- * experimental !
- */
+/* The bump allocator is totally experimental ! */
 BUMP_ALLOC_DEFINE(z_global_allocator, CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE);
+#endif
+
+#if Z_GLOBAL_ALLOCATOR_CLASSES
+/* Size classes front-end: small allocations are served by memory slabs, which
+ * are allocated and freed in constant time without fragmentation. */
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8 > 0
+K_MEM_SLAB_DEFINE(z_malloc_slab_8, 8u, CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8);
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16 > 0
+K_MEM_SLAB_DEFINE(z_malloc_slab_16, 16u, CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16);
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32 > 0
+K_MEM_SLAB_DEFINE(z_malloc_slab_32, 32u, CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32);
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64 > 0
+K_MEM_SLAB_DEFINE(z_malloc_slab_64, 64u, CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64);
+#endif
+
+struct z_malloc_class {
+    struct slab_allocator *slab;
+    uint8_t max_used;
+    uint16_t fallbacks;
+};
+
+/* Sorted by increasing block size */
+static struct z_malloc_class z_malloc_classes[Z_GLOBAL_ALLOCATOR_CLASSES] = {
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8 > 0
+    {.slab = &z_malloc_slab_8.allocator},
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16 > 0
+    {.slab = &z_malloc_slab_16.allocator},
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32 > 0
+    {.slab = &z_malloc_slab_32.allocator},
+#endif
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64 > 0
+    {.slab = &z_malloc_slab_64.allocator},
+#endif
+};
+
+/* Get the class whose slab owns the memory, by address range */
+static struct z_malloc_class *z_malloc_class_of(void *ptr)
+{
+    for (uint8_t i = 0u; i < Z_GLOBAL_ALLOCATOR_CLASSES; i++) {
+        struct slab_allocator *const slab = z_malloc_classes[i].slab;
+        uint8_t *const buf                = slab->buffer;
+
+        if (((uint8_t *)ptr >= buf) &&
+            ((uint8_t *)ptr < buf + (size_t)slab->block_size * slab->count)) {
+            return &z_malloc_classes[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Allocate from the smallest class fitting the size, interrupts are disabled */
+static void *z_malloc_class_alloc(size_t size)
+{
+    for (uint8_t i = 0u; i < Z_GLOBAL_ALLOCATOR_CLASSES; i++) {
+        struct z_malloc_class *const cls = &z_malloc_classes[i];
+
+        if (size <= cls->slab->block_size) {
+            void *const ptr = slab_alloc(cls->slab);
+
+            if (ptr != NULL) {
+                cls->max_used =
+                    MAX(cls->max_used, cls->slab->count - cls->slab->free_count);
+            } else {
+                cls->fallbacks++;
+            }
+
+            return ptr;
+        }
+    }
+
+    return NULL;
+}
+#endif /* Z_GLOBAL_ALLOCATOR_CLASSES */
+
+void z_global_allocator_init(void)
+{
+#if Z_GLOBAL_ALLOCATOR_CLASSES && !CONFIG_AVRTOS_LINKER_SCRIPT
+    /* Otherwise done by z_mem_slab_init_module() */
+    for (uint8_t i = 0u; i < Z_GLOBAL_ALLOCATOR_CLASSES; i++) {
+        z_slab_alloc_finalize_init(z_malloc_classes[i].slab);
+    }
+#endif
+
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+    const int8_t ret = tlsf_reset(&z_global_allocator);
+    __ASSERT_TRUE(ret == 0);
+    (void)ret;
+#endif
+}
 
 void *z_malloc(size_t size, uint8_t align)
 {
@@ -29,9 +130,24 @@ void *z_malloc(size_t size, uint8_t align)
         return NULL;
     }
 
+    void *ptr         = NULL;
     const uint8_t key = irq_lock();
 
-    void *ptr = bump_alloc(&z_global_allocator, size, align);
+#if Z_GLOBAL_ALLOCATOR_CLASSES
+    /* Slab blocks are not aligned */
+    if (align == Z_NO_ALIGN) {
+        ptr = z_malloc_class_alloc(size);
+    }
+
+    if (ptr == NULL)
+#endif
+    {
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+        ptr = tlsf_alloc(&z_global_allocator, size, align);
+#else
+        ptr = bump_alloc(&z_global_allocator, size, align);
+#endif
+    }
 
     irq_unlock(key);
 
@@ -44,31 +160,132 @@ void *k_malloc(size_t size)
     return z_malloc(size, Z_NO_ALIGN);
 }
 
+void *k_realloc(void *ptr, size_t size)
+{
+#if Z_GLOBAL_ALLOCATOR_CLASSES
+    struct z_malloc_class *const cls = ptr ? z_malloc_class_of(ptr) : NULL;
+
+    if (cls != NULL) {
+        const size_t block_size = cls->slab->block_size;
+        void *new_ptr;
+
+        if ((size != 0u) && (size <= block_size)) {
+            return ptr;
+        }
+
+        new_ptr = k_malloc(size);
+        if (new_ptr != NULL) {
+            memcpy(new_ptr, ptr, block_size);
+        }
+        if ((new_ptr != NULL) || (size == 0u)) {
+            k_free(ptr);
+        }
+
+        return new_ptr;
+    }
+#endif
+
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+    const uint8_t key = irq_lock();
+
+    ptr = tlsf_realloc(&z_global_allocator, ptr, size);
+
+    irq_unlock(key);
+
+    return ptr;
+#else
+    /* The bump allocator does not track the size of the blocks */
+    return ptr ? NULL : k_malloc(size);
+#endif
+}
+
 void k_free(void *ptr)
 {
-    (void)ptr;
+    if (ptr == NULL) {
+        return;
+    }
+
+    const uint8_t key = irq_lock();
+
+#if Z_GLOBAL_ALLOCATOR_CLASSES
+    struct z_malloc_class *const cls = z_malloc_class_of(ptr);
+
+    if (cls != NULL) {
+        slab_free(cls->slab, ptr);
+    } else
+#endif
+    {
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+        tlsf_free(&z_global_allocator, ptr);
+#endif
+    }
+
+    irq_unlock(key);
 }
 
 void z_global_allocator_reset(void)
 {
     const uint8_t key = irq_lock();
 
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+    tlsf_reset(&z_global_allocator);
+#else
     bump_reset(&z_global_allocator);
+#endif
 
     irq_unlock(key);
 }
 
-void k_global_allocator_stats_get(size_t *total, size_t *used, size_t *free)
+void k_global_allocator_stats(struct alloc_stats *stats)
 {
+    __ASSERT_NOTNULL(stats);
+
     const uint8_t key = irq_lock();
 
-    struct alloc_stats stats;
-    bump_stats(&z_global_allocator, &stats);
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+    tlsf_stats(&z_global_allocator, stats);
+#else
+    bump_stats(&z_global_allocator, stats);
+#endif
 
     irq_unlock(key);
+}
+
+void k_global_allocator_stats_get(size_t *total, size_t *used, size_t *free)
+{
+    struct alloc_stats stats;
+
+    k_global_allocator_stats(&stats);
 
     *total = stats.total;
     *used  = stats.used;
     *free  = stats.free;
 }
-#endif
\ No newline at end of file
+
+int8_t k_malloc_class_stats_get(uint8_t index, struct k_malloc_class_stats *stats)
+{
+#if Z_GLOBAL_ALLOCATOR_CLASSES
+    if (!z_user(stats && (index < Z_GLOBAL_ALLOCATOR_CLASSES)))
+        return -EINVAL;
+
+    const uint8_t key = irq_lock();
+
+    const struct z_malloc_class *const cls = &z_malloc_classes[index];
+
+    stats->block_size = cls->slab->block_size;
+    stats->count      = cls->slab->count;
+    stats->used       = cls->slab->count - cls->slab->free_count;
+    stats->max_used   = cls->max_used;
+    stats->fallbacks  = cls->fallbacks;
+
+    irq_unlock(key);
+
+    return 0;
+#else
+    (void)index;
+    (void)stats;
+
+    return -EINVAL;
+#endif
+}
+#endif
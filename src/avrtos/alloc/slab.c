@@ -33,6 +33,12 @@ void z_slab_alloc_finalize_init(struct slab_allocator *a)
         a->free_list = (struct snode *)p;
         p += a->block_size; /* Move to the next block */
     }
+
+    a->free_count = a->count;
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    a->max_used = 0u;
+    a->failures = 0u;
+#endif
 }
 
 int8_t
@@ -64,6 +70,9 @@ void *slab_alloc(struct slab_allocator *a)
     if (a->free_list == NULL) {
         /* No free memory blocks available */
         mem = NULL;
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+        a->failures++;
+#endif
     } else {
         /* Allocate a block from the free list,
          * assuming that the free list is not empty.
@@ -72,6 +81,10 @@ void *slab_alloc(struct slab_allocator *a)
          */
         mem          = (void *)a->free_list;
         a->free_list = a->free_list->next;
+        a->free_count--;
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+        a->max_used = MAX(a->max_used, a->count - a->free_count);
+#endif
     }
 
     return mem;
@@ -85,6 +98,53 @@ void slab_free(struct slab_allocator *a, void *ptr)
     /* Add the block back to the free list */
     ((struct snode *)ptr)->next = a->free_list;
     a->free_list                = (struct snode *)ptr;
+    a->free_count++;
+}
+
+uint8_t slab_alloc_many(struct slab_allocator *a, void **mem, uint8_t count)
+{
+    __ASSERT_NOTNULL(a);
+    __ASSERT_NOTNULL(mem);
+
+    struct snode *node = a->free_list;
+    uint8_t n;
+
+    for (n = 0u; (n < count) && (node != NULL); n++) {
+        mem[n] = node;
+        node   = node->next;
+    }
+
+    /* Detach the whole chain at once */
+    a->free_list = node;
+    a->free_count -= n;
+
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    if (n < count) {
+        a->failures++;
+    }
+    a->max_used = MAX(a->max_used, a->count - a->free_count);
+#endif
+
+    return n;
+}
+
+void slab_free_many(struct slab_allocator *a, void **mem, uint8_t count)
+{
+    __ASSERT_NOTNULL(a);
+    __ASSERT_NOTNULL(mem);
+
+    if (count == 0u) {
+        return;
+    }
+
+    /* Link the blocks together, then splice the chain to the free list */
+    for (uint8_t i = 0u; i < count - 1u; i++) {
+        ((struct snode *)mem[i])->next = mem[i + 1u];
+    }
+
+    ((struct snode *)mem[count - 1u])->next = a->free_list;
+    a->free_list                            = mem[0];
+    a->free_count += count;
 }
 
 void slab_reset(struct slab_allocator *a)
@@ -107,10 +167,12 @@ void slab_stats(struct slab_allocator *a, struct alloc_stats *stats)
     __ASSERT_NOTNULL(a);
     __ASSERT_NOTNULL(stats);
 
-    const uint8_t free_nb =
-        a->free_list ? (slist_count((struct slist *)a->free_list) + 1) : 0;
+    const uint8_t free_nb = a->free_count;
 
     stats->total = a->block_size * a->count;
     stats->free  = free_nb * a->block_size;
     stats->used  = stats->total - stats->free;
+
+    stats->largest_free = free_nb ? a->block_size : 0u;
+    stats->free_blocks  = free_nb;
 }
\ No newline at end of file
@@ -38,6 +38,7 @@ extern "C" {
 #include <stdint.h>
 
 #include <avrtos/alloc/api.h>
+#include <avrtos/defines.h>
 #include <avrtos/dstruct/slist.h>
 
 /**
@@ -47,7 +48,8 @@ extern "C" {
  * and freed. The memory blocks are managed using a singly linked list that
  * tracks the free blocks.
  *
- * Allocation and deallocation operations are performed in constant time (O(1)).
+ * Allocation and deallocation operations are performed in constant time (O(1)),
+ * as well as statistics which are maintained incrementally.
  *
  * @note Maximum number of blocks is 255.
  * @note Maximum block size is 65535 bytes
@@ -57,6 +59,11 @@ struct slab_allocator {
     uint8_t count;           /**< Total number of blocks in the slab */
     uint16_t block_size;     /**< Size of each block in bytes */
     struct snode *free_list; /**< Pointer to the list of free blocks */
+    uint8_t free_count;      /**< Number of blocks in the free list */
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    uint8_t max_used;  /**< Maximum number of blocks allocated at once */
+    uint16_t failures; /**< Number of allocations which found the slab empty */
+#endif
 };
 
 /**
@@ -89,6 +96,30 @@ void *slab_alloc(struct slab_allocator *a);
  */
 void slab_free(struct slab_allocator *a, void *ptr);
 
+/**
+ * @brief Allocate several slabs at once
+ *
+ * The chain of blocks is detached from the free list in a single pass.
+ *
+ * @param a Pointer to slab allocator structure
+ * @param mem Array receiving the pointers to the allocated slabs
+ * @param count Number of slabs to allocate
+ * @return uint8_t Number of slabs allocated, less than count if the slab
+ * allocator ran out of blocks
+ */
+uint8_t slab_alloc_many(struct slab_allocator *a, void **mem, uint8_t count);
+
+/**
+ * @brief Free several slabs at once
+ *
+ * The blocks are linked together and the chain is spliced to the free list.
+ *
+ * @param a Pointer to slab allocator structure
+ * @param mem Array of pointers to the slabs to free
+ * @param count Number of slabs to free
+ */
+void slab_free_many(struct slab_allocator *a, void **mem, uint8_t count);
+
 /**
  * @brief Reset slab allocator
  *
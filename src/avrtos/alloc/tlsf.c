@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Implementation inspired by the TLSF allocator of Matthew Conte
+ * (http://tlsf.baisoku.org), itself based on the original paper of M. Masmano,
+ * I. Ripoll et al.: "TLSF: a New Dynamic Memory Allocator for Real-Time
+ * Systems".
+ *
+ * Note: This file does not depend on the kernel, so that it can be tested
+ * natively (tests/native).
+ */
+
+#include <avrtos/defines.h>
+#include <avrtos/errno.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "tlsf.h"
+
+#define Z_TLSF_BLOCK_FREE      0x1u
+#define Z_TLSF_BLOCK_PREV_FREE 0x2u
+#define Z_TLSF_BLOCK_FLAGS     (Z_TLSF_BLOCK_FREE | Z_TLSF_BLOCK_PREV_FREE)
+
+/* Header overhead of a block (used or free) */
+#define Z_TLSF_HDR_SIZE offsetof(struct z_tlsf_block, next_free)
+
+/* Minimum payload of a block: the free-list links */
+#define Z_TLSF_BLOCK_SIZE_MIN (sizeof(struct z_tlsf_block) - Z_TLSF_HDR_SIZE)
+
+/* Blocks smaller than this are all mapped to the first first-level list */
+#define Z_TLSF_SMALL_BLOCK_SIZE ((size_t)1u << TLSF_FL_INDEX_SHIFT)
+
+#define Z_TLSF_ALIGN_UP(x, align)   (((x) + ((align) - 1u)) & ~((size_t)(align) - 1u))
+#define Z_TLSF_ALIGN_DOWN(x, align) ((x) & ~((size_t)(align) - 1u))
+
+__STATIC_ASSERT(TLSF_ALIGN >= 4u, "Two lower bits of the block size are flags");
+__STATIC_ASSERT((Z_TLSF_HDR_SIZE % TLSF_ALIGN) == 0u, "Unaligned block header");
+__STATIC_ASSERT(TLSF_FL_INDEX_COUNT <= 16u, "First-level bitmap too small");
+
+/* Index of the most significant bit set, x must not be 0 */
+static inline uint8_t z_tlsf_fls(size_t x)
+{
+    return (uint8_t)(sizeof(unsigned long) * 8u - 1u - __builtin_clzl((unsigned long)x));
+}
+
+/* Index of the least significant bit set, x must not be 0 */
+static inline uint8_t z_tlsf_ffs(uint16_t x)
+{
+    return (uint8_t)__builtin_ctz(x);
+}
+
+static inline size_t z_tlsf_block_size(const struct z_tlsf_block *block)
+{
+    return block->size & ~(size_t)Z_TLSF_BLOCK_FLAGS;
+}
+
+static inline void z_tlsf_block_set_size(struct z_tlsf_block *block, size_t size)
+{
+    block->size = size | (block->size & Z_TLSF_BLOCK_FLAGS);
+}
+
+static inline bool z_tlsf_block_is_free(const struct z_tlsf_block *block)
+{
+    return (block->size & Z_TLSF_BLOCK_FREE) != 0u;
+}
+
+static inline bool z_tlsf_block_is_prev_free(const struct z_tlsf_block *block)
+{
+    return (block->size & Z_TLSF_BLOCK_PREV_FREE) != 0u;
+}
+
+static inline void *z_tlsf_block_to_ptr(struct z_tlsf_block *block)
+{
+    return (uint8_t *)block + Z_TLSF_HDR_SIZE;
+}
+
+static inline struct z_tlsf_block *z_tlsf_block_from_ptr(void *ptr)
+{
+    return (struct z_tlsf_block *)((uint8_t *)ptr - Z_TLSF_HDR_SIZE);
+}
+
+static inline struct z_tlsf_block *z_tlsf_block_next(struct z_tlsf_block *block)
+{
+    return (struct z_tlsf_block *)((uint8_t *)z_tlsf_block_to_ptr(block) +
+                                   z_tlsf_block_size(block));
+}
+
+/* Get the next physical block and link it back to the block */
+static inline struct z_tlsf_block *z_tlsf_block_link_next(struct z_tlsf_block *block)
+{
+    struct z_tlsf_block *const next = z_tlsf_block_next(block);
+    next->prev_phys                 = block;
+    return next;
+}
+
+static void z_tlsf_block_mark_as_free(struct z_tlsf_block *block)
+{
+    struct z_tlsf_block *const next = z_tlsf_block_link_next(block);
+    next->size |= Z_TLSF_BLOCK_PREV_FREE;
+    block->size |= Z_TLSF_BLOCK_FREE;
+}
+
+static void z_tlsf_block_mark_as_used(struct z_tlsf_block *block)
+{
+    struct z_tlsf_block *const next = z_tlsf_block_next(block);
+    next->size &= ~(size_t)Z_TLSF_BLOCK_PREV_FREE;
+    block->size &= ~(size_t)Z_TLSF_BLOCK_FREE;
+}
+
+/* Adjust a request to a valid block size, 0 if the request is too large */
+static size_t z_tlsf_adjust_request(size_t size)
+{
+    if ((size == 0u) || (size >= TLSF_BLOCK_SIZE_MAX)) {
+        return 0u;
+    }
+
+    size = Z_TLSF_ALIGN_UP(size, TLSF_ALIGN);
+
+    return MAX(size, Z_TLSF_BLOCK_SIZE_MIN);
+}
+
+/* Get the list of a block size (the list the block is inserted in) */
+static void z_tlsf_mapping_insert(size_t size, uint8_t *fl, uint8_t *sl)
+{
+    if (size < Z_TLSF_SMALL_BLOCK_SIZE) {
+        *fl = 0u;
+        *sl = (uint8_t)(size / (Z_TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+    } else {
+        const uint8_t f = z_tlsf_fls(size);
+        *sl = (uint8_t)((size >> (f - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT);
+        *fl = (uint8_t)(f - (TLSF_FL_INDEX_SHIFT - 1u));
+    }
+}
+
+/* Get the first list whose blocks all fit the size (good fit) */
+static void z_tlsf_mapping_search(size_t size, uint8_t *fl, uint8_t *sl)
+{
+    if (size >= Z_TLSF_SMALL_BLOCK_SIZE) {
+        size += ((size_t)1u << (z_tlsf_fls(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1u;
+    }
+
+    z_tlsf_mapping_insert(size, fl, sl);
+}
+
+static void z_tlsf_insert_free_block(struct tlsf_allocator *a, struct z_tlsf_block *block)
+{
+    uint8_t fl, sl;
+    z_tlsf_mapping_insert(z_tlsf_block_size(block), &fl, &sl);
+
+    struct z_tlsf_block *const current = a->heads[fl][sl];
+
+    block->next_free = current;
+    block->prev_free = NULL;
+    if (current != NULL) {
+        current->prev_free = block;
+    }
+
+    a->heads[fl][sl] = block;
+    a->fl_bitmap |= (uint16_t)(1u << fl);
+    a->sl_bitmap[fl] |= (uint8_t)(1u << sl);
+
+    a->free += z_tlsf_block_size(block);
+    a->free_blocks++;
+}
+
+static void z_tlsf_remove_free_block(struct tlsf_allocator *a, struct z_tlsf_block *block)
+{
+    uint8_t fl, sl;
+    z_tlsf_mapping_insert(z_tlsf_block_size(block), &fl, &sl);
+
+    struct z_tlsf_block *const prev = block->prev_free;
+    struct z_tlsf_block *const next = block->next_free;
+
+    if (next != NULL) {
+        next->prev_free = prev;
+    }
+
+    if (prev != NULL) {
+        prev->next_free = next;
+    } else {
+        a->heads[fl][sl] = next;
+
+        if (next == NULL) {
+            a->sl_bitmap[fl] &= (uint8_t)~(1u << sl);
+            if (a->sl_bitmap[fl] == 0u) {
+                a->fl_bitmap &= (uint16_t)~(1u << fl);
+            }
+        }
+    }
+
+    a->free -= z_tlsf_block_size(block);
+    a->free_blocks--;
+}
+
+static struct z_tlsf_block *z_tlsf_locate_free(struct tlsf_allocator *a, size_t size)
+{
+    uint8_t fl, sl;
+
+    if (size == 0u) {
+        return NULL;
+    }
+
+    z_tlsf_mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_FL_INDEX_COUNT) {
+        return NULL;
+    }
+
+    /* Search the list of the size, or a larger list of the same first level */
+    uint8_t sl_map = a->sl_bitmap[fl] & (uint8_t)(0xFFu << sl);
+    if (sl_map == 0u) {
+        /* Search a larger first level */
+        const uint16_t fl_map = a->fl_bitmap & (uint16_t)(0xFFFFu << (fl + 1u));
+        if (fl_map == 0u) {
+            return NULL;
+        }
+
+        fl     = z_tlsf_ffs(fl_map);
+        sl_map = a->sl_bitmap[fl];
+    }
+    sl = z_tlsf_ffs(sl_map);
+
+    struct z_tlsf_block *const block = a->heads[fl][sl];
+    z_tlsf_remove_free_block(a, block);
+
+    return block;
+}
+
+/* Check whether the remainder of the block would make a valid block */
+static inline bool z_tlsf_block_can_split(struct z_tlsf_block *block, size_t size)
+{
+    return z_tlsf_block_size(block) >= sizeof(struct z_tlsf_block) + size;
+}
+
+/* Split the block at size, and return the remaining (free) block */
+static struct z_tlsf_block *z_tlsf_block_split(struct z_tlsf_block *block, size_t size)
+{
+    struct z_tlsf_block *const remaining =
+        (struct z_tlsf_block *)((uint8_t *)z_tlsf_block_to_ptr(block) + size);
+
+    remaining->prev_phys = block;
+    remaining->size      = z_tlsf_block_size(block) - (size + Z_TLSF_HDR_SIZE);
+    z_tlsf_block_set_size(block, size);
+    z_tlsf_block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/* Merge the block into its previous physical block */
+static struct z_tlsf_block *z_tlsf_block_absorb(struct z_tlsf_block *prev,
+                                                struct z_tlsf_block *block)
+{
+    prev->size += z_tlsf_block_size(block) + Z_TLSF_HDR_SIZE;
+    z_tlsf_block_link_next(prev);
+    return prev;
+}
+
+static struct z_tlsf_block *z_tlsf_merge_prev(struct tlsf_allocator *a,
+                                              struct z_tlsf_block *block)
+{
+    if (z_tlsf_block_is_prev_free(block)) {
+        struct z_tlsf_block *const prev = block->prev_phys;
+        z_tlsf_remove_free_block(a, prev);
+        block = z_tlsf_block_absorb(prev, block);
+    }
+
+    return block;
+}
+
+static struct z_tlsf_block *z_tlsf_merge_next(struct tlsf_allocator *a,
+                                              struct z_tlsf_block *block)
+{
+    struct z_tlsf_block *const next = z_tlsf_block_next(block);
+
+    if (z_tlsf_block_is_free(next)) {
+        z_tlsf_remove_free_block(a, next);
+        block = z_tlsf_block_absorb(block, next);
+    }
+
+    return block;
+}
+
+/* Give back the end of a free block to the pool */
+static void
+z_tlsf_trim_free(struct tlsf_allocator *a, struct z_tlsf_block *block, size_t size)
+{
+    if (z_tlsf_block_can_split(block, size)) {
+        struct z_tlsf_block *const remaining = z_tlsf_block_split(block, size);
+        remaining->size |= Z_TLSF_BLOCK_PREV_FREE;
+        z_tlsf_insert_free_block(a, remaining);
+    }
+}
+
+/* Give back the end of a used block to the pool */
+static void
+z_tlsf_trim_used(struct tlsf_allocator *a, struct z_tlsf_block *block, size_t size)
+{
+    if (z_tlsf_block_can_split(block, size)) {
+        struct z_tlsf_block *remaining = z_tlsf_block_split(block, size);
+        remaining->size &= ~(size_t)Z_TLSF_BLOCK_PREV_FREE;
+        remaining = z_tlsf_merge_next(a, remaining);
+        z_tlsf_insert_free_block(a, remaining);
+    }
+}
+
+/* Give back the beginning of a free block to the pool */
+static struct z_tlsf_block *z_tlsf_trim_free_leading(struct tlsf_allocator *a,
+                                                     struct z_tlsf_block *block,
+                                                     size_t size)
+{
+    struct z_tlsf_block *remaining = block;
+
+    if (z_tlsf_block_can_split(block, size)) {
+        remaining = z_tlsf_block_split(block, size - Z_TLSF_HDR_SIZE);
+        remaining->size |= Z_TLSF_BLOCK_PREV_FREE;
+        z_tlsf_insert_free_block(a, block);
+    }
+
+    return remaining;
+}
+
+static void *
+z_tlsf_prepare_used(struct tlsf_allocator *a, struct z_tlsf_block *block, size_t size)
+{
+    z_tlsf_trim_free(a, block, size);
+    z_tlsf_block_mark_as_used(block);
+
+    return z_tlsf_block_to_ptr(block);
+}
+
+int8_t tlsf_init(struct tlsf_allocator *a, uint8_t *buf, size_t size)
+{
+    if (!a || !buf) {
+        return -EINVAL;
+    }
+
+    a->buf  = buf;
+    a->size = size;
+
+    return tlsf_reset(a);
+}
+
+int8_t tlsf_reset(struct tlsf_allocator *a)
+{
+    if (!a || !a->buf) {
+        return -EINVAL;
+    }
+
+    uint8_t *const pool = (uint8_t *)Z_TLSF_ALIGN_UP((uintptr_t)a->buf, TLSF_ALIGN);
+    const size_t offset = (size_t)(pool - a->buf);
+
+    if (a->size < offset + 2u * Z_TLSF_HDR_SIZE + Z_TLSF_BLOCK_SIZE_MIN) {
+        return -EINVAL;
+    }
+
+    /* Room for the first block header and the sentinel */
+    const size_t capacity =
+        Z_TLSF_ALIGN_DOWN(a->size - offset - 2u * Z_TLSF_HDR_SIZE, TLSF_ALIGN);
+    if (capacity >= TLSF_BLOCK_SIZE_MAX) {
+        return -EINVAL;
+    }
+
+    memset(a->sl_bitmap, 0, sizeof(a->sl_bitmap));
+    memset(a->heads, 0, sizeof(a->heads));
+    a->fl_bitmap   = 0u;
+    a->free        = 0u;
+    a->free_blocks = 0u;
+    a->capacity    = capacity;
+
+    struct z_tlsf_block *const block = (struct z_tlsf_block *)pool;
+    block->prev_phys                 = NULL;
+    block->size                      = capacity;
+    z_tlsf_block_mark_as_free(block);
+    z_tlsf_insert_free_block(a, block);
+
+    /* Zero-size used sentinel, stops merging at the end of the pool */
+    struct z_tlsf_block *const sentinel = z_tlsf_block_link_next(block);
+    sentinel->size                      = Z_TLSF_BLOCK_PREV_FREE;
+
+    return 0;
+}
+
+void *tlsf_alloc(struct tlsf_allocator *a, size_t size, uint8_t align)
+{
+    if (!a || !align || (align & (align - 1u))) {
+        return NULL;
+    }
+
+    const size_t adjust = z_tlsf_adjust_request(size);
+    if (adjust == 0u) {
+        return NULL;
+    }
+
+    if (align <= TLSF_ALIGN) {
+        struct z_tlsf_block *const block = z_tlsf_locate_free(a, adjust);
+        return block ? z_tlsf_prepare_used(a, block, adjust) : NULL;
+    }
+
+    /* Over-allocate so that a leading gap can be given back as a free block */
+    const size_t gap_min = sizeof(struct z_tlsf_block);
+    const size_t with_gap =
+        z_tlsf_adjust_request(adjust + align + gap_min);
+    struct z_tlsf_block *block = z_tlsf_locate_free(a, with_gap);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    uint8_t *const ptr = z_tlsf_block_to_ptr(block);
+    uintptr_t aligned  = Z_TLSF_ALIGN_UP((uintptr_t)ptr, align);
+    size_t gap         = (size_t)(aligned - (uintptr_t)ptr);
+
+    /* The gap must be large enough to make a free block */
+    if ((gap != 0u) && (gap < gap_min)) {
+        aligned = Z_TLSF_ALIGN_UP((uintptr_t)ptr + gap_min, align);
+        gap     = (size_t)(aligned - (uintptr_t)ptr);
+    }
+
+    if (gap != 0u) {
+        block = z_tlsf_trim_free_leading(a, block, gap);
+    }
+
+    return z_tlsf_prepare_used(a, block, adjust);
+}
+
+void tlsf_free(struct tlsf_allocator *a, void *ptr)
+{
+    if (!a || !ptr) {
+        return;
+    }
+
+    struct z_tlsf_block *block = z_tlsf_block_from_ptr(ptr);
+
+    z_tlsf_block_mark_as_free(block);
+    block = z_tlsf_merge_prev(a, block);
+    block = z_tlsf_merge_next(a, block);
+    z_tlsf_insert_free_block(a, block);
+}
+
+void *tlsf_realloc(struct tlsf_allocator *a, void *ptr, size_t size)
+{
+    if (!a) {
+        return NULL;
+    }
+
+    if (ptr == NULL) {
+        return tlsf_alloc(a, size, Z_NO_ALIGN);
+    }
+
+    if (size == 0u) {
+        tlsf_free(a, ptr);
+        return NULL;
+    }
+
+    struct z_tlsf_block *const block = z_tlsf_block_from_ptr(ptr);
+    struct z_tlsf_block *const next  = z_tlsf_block_next(block);
+
+    const size_t cursize  = z_tlsf_block_size(block);
+    const size_t combined = cursize + z_tlsf_block_size(next) + Z_TLSF_HDR_SIZE;
+    const size_t adjust   = z_tlsf_adjust_request(size);
+
+    if (adjust == 0u) {
+        return NULL;
+    }
+
+    if ((adjust > cursize) && (!z_tlsf_block_is_free(next) || (adjust > combined))) {
+        /* Cannot grow in place */
+        void *const p = tlsf_alloc(a, size, Z_NO_ALIGN);
+        if (p != NULL) {
+            memcpy(p, ptr, MIN(cursize, size));
+            tlsf_free(a, ptr);
+        }
+
+        return p;
+    }
+
+    if (adjust > cursize) {
+        z_tlsf_merge_next(a, block);
+        z_tlsf_block_mark_as_used(block);
+    }
+
+    z_tlsf_trim_used(a, block, adjust);
+
+    return ptr;
+}
+
+size_t tlsf_usable_size(void *ptr)
+{
+    return ptr ? z_tlsf_block_size(z_tlsf_block_from_ptr(ptr)) : 0u;
+}
+
+void tlsf_stats(struct tlsf_allocator *a, struct alloc_stats *stats)
+{
+    if (!a || !stats) {
+        return;
+    }
+
+    stats->total        = a->capacity;
+    stats->free         = a->free;
+    stats->used         = a->capacity - a->free;
+    stats->free_blocks  = a->free_blocks;
+    stats->largest_free = 0u;
+
+    /* The largest free block is in the highest non-empty list */
+    if (a->fl_bitmap != 0u) {
+        const uint8_t fl = z_tlsf_fls(a->fl_bitmap);
+        const uint8_t sl = z_tlsf_fls(a->sl_bitmap[fl]);
+
+        for (struct z_tlsf_block *block = a->heads[fl][sl]; block != NULL;
+             block                      = block->next_free) {
+            stats->largest_free = MAX(stats->largest_free, z_tlsf_block_size(block));
+        }
+    }
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * TLSF Allocator (Two-Level Segregated Fit)
+ *
+ * A general-purpose allocator with O(1) allocation and deallocation times,
+ * whatever the state of the pool. Free blocks are kept in segregated lists,
+ * indexed by a first level (power of two of the block size) and a second
+ * level (linear subdivision of the power of two). Two bitmaps track non-empty
+ * lists so that a suitable free block is found with two "find first set"
+ * operations. Adjacent free blocks are merged immediately on free.
+ *
+ * Each block is preceded by a header of two words (4 bytes on AVR): the
+ * address of the previous physical block and the size of the block, whose two
+ * lower bits flag whether the block and its previous physical neighbour are
+ * free. Free blocks additionally store the free-list links in their payload.
+ *
+ *  | Header     | Payload              | Header     | Payload    | Sentinel
+ *  +------------+----------------------+------------+------------+------------+
+ *  | prev, size | Used block           | prev, size | Free block | prev, 0    |
+ *  +------------+----------------------+------------+------------+------------+
+ *
+ * Block sizes are multiples of TLSF_ALIGN, the minimum payload is the size of
+ * the free-list links (2 pointers). The largest block is limited to 32 KiB.
+ *
+ * The TLSF allocator API is NOT thread-safe.
+ */
+
+#ifndef _AVRTOS_ALLOC_TLSF_H
+#define _AVRTOS_ALLOC_TLSF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <avrtos/alloc/alloc_private.h>
+#include <avrtos/alloc/api.h>
+
+/**
+ * @brief Granularity of the block sizes, also the alignment of the payloads.
+ *
+ * Two lower bits of the block size are used as flags, 4 is the minimum.
+ */
+#if __SIZEOF_POINTER__ > 4
+#define TLSF_ALIGN_LOG2 3u
+#else
+#define TLSF_ALIGN_LOG2 2u
+#endif
+#define TLSF_ALIGN (1u << TLSF_ALIGN_LOG2)
+
+/**
+ * @brief Number of second-level lists per first-level (log2).
+ *
+ * 4 lists per power of two keep the control structure small (~110 bytes on
+ * AVR) while bounding the internal fragmentation to 25%.
+ */
+#define TLSF_SL_INDEX_COUNT_LOG2 2u
+#define TLSF_SL_INDEX_COUNT      (1u << TLSF_SL_INDEX_COUNT_LOG2)
+
+/* Blocks smaller than 1 << TLSF_FL_INDEX_SHIFT are all in the first level. */
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_INDEX_MAX   15u
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1u)
+
+/**
+ * @brief Maximum size of a block (exclusive).
+ */
+#define TLSF_BLOCK_SIZE_MAX ((size_t)1u << TLSF_FL_INDEX_MAX)
+
+/**
+ * @brief TLSF block header.
+ *
+ * Free-list links are only valid while the block is free, they are part of the
+ * payload of used blocks.
+ */
+struct z_tlsf_block {
+    struct z_tlsf_block *prev_phys; /**< Previous physical block */
+    size_t size;                    /**< Payload size and flags */
+    struct z_tlsf_block *next_free; /**< Next free block in the list */
+    struct z_tlsf_block *prev_free; /**< Previous free block in the list */
+};
+
+/**
+ * @brief TLSF allocator structure
+ *
+ * The control structure is kept outside of the managed memory buffer.
+ */
+struct tlsf_allocator {
+    uint8_t *buf;        /**< Pointer to memory buffer */
+    size_t size;         /**< Size of memory buffer */
+    size_t capacity;     /**< Payload size of the initial free block */
+    size_t free;         /**< Sum of the payload sizes of the free blocks */
+    size_t free_blocks;  /**< Number of free blocks */
+    uint16_t fl_bitmap;  /**< Non-empty first-level lists */
+    uint8_t sl_bitmap[TLSF_FL_INDEX_COUNT]; /**< Non-empty second-level lists */
+    struct z_tlsf_block *heads[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+};
+
+/**
+ * @brief Define a buffer and a TLSF allocator at compile time
+ *
+ * The allocator must be initialized at runtime with tlsf_reset() before use.
+ *
+ * @param name Name of TLSF allocator
+ * @param size Size of memory buffer
+ */
+#define TLSF_ALLOC_DEFINE(name, size)                                                    \
+    uint8_t name##_buf[size];                                                            \
+    struct tlsf_allocator name = TLSF_ALLOC_INIT(name##_buf, size)
+
+/**
+ * @brief Partially initialize a TLSF allocator at compile time
+ *
+ * @param _buf Pointer to memory buffer
+ * @param _size Size of memory buffer
+ */
+#define TLSF_ALLOC_INIT(_buf, _size)                                                     \
+    {                                                                                    \
+        .buf = _buf, .size = _size,                                                      \
+    }
+
+/**
+ * @brief Initialize TLSF allocator at runtime
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @param buf Pointer to memory buffer
+ * @param size Size of memory buffer
+ * @return int8_t 0 on success, -EINVAL if the buffer is too small or too large
+ */
+int8_t tlsf_init(struct tlsf_allocator *a, uint8_t *buf, size_t size);
+
+/**
+ * @brief Allocate memory from TLSF allocator
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @param size Size of memory to allocate (in bytes), must be greater than 0
+ * @param align Alignment of memory, must be a power of 2
+ * @return void* Pointer to allocated memory, NULL on error
+ */
+void *tlsf_alloc(struct tlsf_allocator *a, size_t size, uint8_t align);
+
+/**
+ * @brief Free memory allocated from TLSF allocator
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @param ptr Pointer to memory to free, can be NULL
+ */
+void tlsf_free(struct tlsf_allocator *a, void *ptr);
+
+/**
+ * @brief Resize memory allocated from TLSF allocator
+ *
+ * The block is resized in place when possible (shrinking, or growing into
+ * the next free block), otherwise a new block is allocated, the data copied
+ * and the old block freed.
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @param ptr Pointer to memory to resize, NULL behaves as tlsf_alloc()
+ * @param size New size, 0 behaves as tlsf_free()
+ * @return void* Pointer to resized memory, NULL on error (the original
+ * memory is then left untouched)
+ */
+void *tlsf_realloc(struct tlsf_allocator *a, void *ptr, size_t size);
+
+/**
+ * @brief Get the usable size of an allocated memory block
+ *
+ * @param ptr Pointer to allocated memory
+ * @return size_t Usable size, at least the requested size
+ */
+size_t tlsf_usable_size(void *ptr);
+
+/**
+ * @brief Reset TLSF allocator, freeing all memory
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @return int8_t 0 on success, -EINVAL if the buffer is too small or too large
+ */
+int8_t tlsf_reset(struct tlsf_allocator *a);
+
+/**
+ * @brief Get TLSF allocator statistics
+ *
+ * "used" includes the block headers, "largest_free" is the payload size of the
+ * largest free block. As requests are rounded up to the next list, the largest
+ * allocation guaranteed to succeed can be up to 25% smaller.
+ *
+ * @param a Pointer to TLSF allocator structure
+ * @param stats Pointer to statistics structure
+ */
+void tlsf_stats(struct tlsf_allocator *a, struct alloc_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -54,6 +54,12 @@ extern "C" {
 #define K_MODULE_DRIVERS_TIMERS 20
 #define K_MODULE_DEVICE         21
 
+#define K_MODULE_POST   22
+#define K_MODULE_RWLOCK 23
+#define K_MODULE_PIPE   24
+#define K_MODULE_BUF    25
+#define K_MODULE_PT     26
+
 #define K_MODULE_APPLICATION 32
 
 // assertions codes
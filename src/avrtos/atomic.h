@@ -8,6 +8,10 @@
  * AVR architectures have very limited support for atomic instructions.
  * As a result, atomic operations must be implemented by temporarily disabling
  * interrupts to ensure that operations are not interrupted.
+ *
+ * atomic_t is 8-bit (atomic8_t), 16-bit values and pointers have their own
+ * operations (atomic16_*() and atomic_ptr_*()), each one saves SREG, disables
+ * the interrupts for the read-modify-write sequence and restores SREG.
  */
 
 #ifndef _AVRTOS_ATOMIC_H_
@@ -37,6 +41,15 @@ extern "C" {
 typedef uint8_t atomic_val_t;
 typedef uint8_t atomic_t;
 
+typedef atomic_val_t atomic8_val_t;
+typedef atomic_t atomic8_t;
+
+typedef uint16_t atomic16_val_t;
+typedef uint16_t atomic16_t;
+
+#define K_ATOMIC16_INIT(val)         ((atomic16_t)(val))
+#define K_ATOMIC16_DEFINE(name, val) atomic16_t name = K_ATOMIC16_INIT(val)
+
 /**
  * @brief Get the current value of an atomic variable.
  *
@@ -209,6 +222,114 @@ __kernel bool atomic_cas(atomic_t *target, atomic_val_t cmd, atomic_val_t val);
  */
 __kernel bool atomic_cas2(atomic_t *target, atomic_val_t cmd, atomic_val_t val);
 
+/**
+ * @brief Get the current value of a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @return The current value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_get(atomic16_t *target);
+
+/**
+ * @brief Set the value of a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @param value The value to set.
+ * @return The old value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_set(atomic16_t *target, atomic16_val_t value);
+
+/**
+ * @brief Add a value to a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @param value Value to add.
+ * @return The old value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_add(atomic16_t *target, atomic16_val_t value);
+
+/**
+ * @brief Increment a 16-bit atomic variable by one and return the new value.
+ *
+ * @param target Pointer to the atomic variable.
+ * @return The new value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_inc(atomic16_t *target);
+
+/**
+ * @brief Decrement a 16-bit atomic variable by one and return the new value.
+ *
+ * @param target Pointer to the atomic variable.
+ * @return The new value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_dec(atomic16_t *target);
+
+/**
+ * @brief Perform a bitwise OR on a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @param value Value to OR with the atomic variable.
+ * @return The old value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_or(atomic16_t *target, atomic16_val_t value);
+
+/**
+ * @brief Perform a bitwise AND on a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @param value Value to AND with the atomic variable.
+ * @return The old value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_and(atomic16_t *target, atomic16_val_t value);
+
+/**
+ * @brief Perform a bitwise XOR on a 16-bit atomic variable.
+ *
+ * @param target Pointer to the atomic variable.
+ * @param value Value to XOR with the atomic variable.
+ * @return The old value of the atomic variable.
+ */
+__kernel atomic16_val_t atomic16_xor(atomic16_t *target, atomic16_val_t value);
+
+/**
+ * @brief Compare and set operation on a 16-bit atomic variable.
+ *
+ * @see atomic_cas
+ *
+ * @param target Pointer to the atomic variable.
+ * @param cmd The value to compare against.
+ * @param val The value to set if the comparison is successful.
+ * @return True if the atomic variable was updated, false otherwise.
+ */
+__kernel bool atomic16_cas(atomic16_t *target, atomic16_val_t cmd, atomic16_val_t val);
+
+/**
+ * @brief Get the current value of a pointer shared with ISRs.
+ *
+ * @param target Pointer to the pointer.
+ * @return The current value of the pointer.
+ */
+__kernel void *atomic_ptr_get(void *const *target);
+
+/**
+ * @brief Set the value of a pointer shared with ISRs (exchange).
+ *
+ * @param target Pointer to the pointer.
+ * @param value The value to set.
+ * @return The old value of the pointer.
+ */
+__kernel void *atomic_ptr_set(void **target, void *value);
+
+/**
+ * @brief Compare and set operation on a pointer shared with ISRs.
+ *
+ * @param target Pointer to the pointer.
+ * @param cmd The value to compare against.
+ * @param val The value to set if the comparison is successful.
+ * @return True if the pointer was updated, false otherwise.
+ */
+__kernel bool atomic_ptr_cas(void **target, void *cmd, void *val);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@
 #include "dstruct/dlist.h"
 #include "dstruct/tqueue.h"
 #include "dstruct/debug.h"
+#include "dstruct/lflist.h"
 
 #include "atomic.h"
 #include "ring.h"
@@ -38,6 +39,7 @@
 
 #include "workqueue.h"
 #include "mutex.h"
+#include "rwlock.h"
 #include "semaphore.h"
 #include "timer.h"
 #include "event.h"
@@ -45,8 +47,12 @@
 #include "fifo.h"
 #include "mem_slab.h"
 #include "msgq.h"
+#include "pipe.h"
+#include "buf.h"
+#include "pt.h"
 #include "flags.h"
 #include "poll.h"
+#include "post.h"
 
 #include "rust_helpers.h"
 #include "stdout.h"
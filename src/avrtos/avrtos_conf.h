@@ -89,7 +89,8 @@
 //   k_thread_static_create_and_schedule().
 // - The following macros are still usable but require manual initialization:
 //   K_TIMER_DEFINE(), K_MEM_SLAB_DEFINE().
-// - Disables functions: k_dump_stack_canaries(), k_thread_dump_all().
+// - Disables functions: k_dump_stack_canaries(), k_thread_dump_all(),
+//   k_mem_slab_stats_dump_all().
 //
 // Note: The Arduino framework with Arduino IDE requires this option to be disabled,
 // as it is not possible to provide a custom linker script.
@@ -202,6 +203,53 @@
 #define CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE 0
 #endif
 
+//
+// Select the implementation of the global (default) allocator.
+//
+// 0: Bump allocator (experimental, k_free() is a no-op)
+// 1: TLSF allocator (O(1) allocation/free, ~110 bytes of control structure)
+//
+#ifndef CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF
+#define CONFIG_KERNEL_GLOBAL_ALLOCATOR_TLSF 1
+#endif
+
+//
+// Number of blocks of the size classes of the global allocator. Allocations
+// of up to 8, 16, 32 or 64 bytes are served by dedicated memory slabs, falling
+// back to the heap when the class is exhausted. Blocks memory is reserved in
+// addition to CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE.
+//
+// 0: Size class disabled
+// n: Size class enabled with n blocks (max 255)
+//
+#ifndef CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8
+#define CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8 0
+#endif
+
+#ifndef CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16
+#define CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16 0
+#endif
+
+#ifndef CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32
+#define CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32 0
+#endif
+
+#ifndef CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64
+#define CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64 0
+#endif
+
+//
+// Maintain usage statistics of slab allocators and memory slabs: maximum
+// number of blocks allocated at once, failed allocations and number of blocks
+// handed over directly to waiting threads (k_mem_slab_stats_get()).
+//
+// 0: Only the number of free blocks is maintained
+// 1: All statistics are maintained (4 more bytes per slab)
+//
+#ifndef CONFIG_KERNEL_MEM_SLAB_STATS
+#define CONFIG_KERNEL_MEM_SLAB_STATS 0
+#endif
+
 //
 // Default SREG value for other threads on stack creation.
 // The main thread's default SREG is always 0.
@@ -249,6 +297,22 @@
 #define CONFIG_KERNEL_SCHEDULER_COMPARE_THREADS_BEFORE_SWITCH 1
 #endif
 
+//
+// Skip the scheduler when the current thread is the only ready thread:
+// - k_yield() returns immediately (unless CONFIG_KERNEL_DEFERRED_POST is
+//   enabled, posts are then processed by the scheduler).
+// - The system tick returns to the interrupted thread without saving its
+//   call-saved context.
+//
+// Adds a few instructions to each k_yield() call site.
+//
+// 0: Scheduler always called.
+// 1: Scheduler skipped when there is nothing to switch to.
+//
+#ifndef CONFIG_KERNEL_SCHEDULER_FAST_PATHS
+#define CONFIG_KERNEL_SCHEDULER_FAST_PATHS 0
+#endif
+
 //
 // Enable or disable cooperative threads. This feature allows threads to not be preempted
 // by the scheduler when they are ready.
@@ -516,6 +580,42 @@
 #define CONFIG_THREAD_MAIN_MONITOR 0
 #endif
 
+//
+// Compact thread control block (struct k_thread).
+//
+// The stack information (end address and size, 4 bytes) is only kept if
+// required by CONFIG_THREAD_CANARIES, CONFIG_THREAD_STACK_SENTINEL,
+// CONFIG_THREAD_MONITOR or CONFIG_THREAD_MAIN_MONITOR, and the thread symbol
+// (1 byte) is removed: K_THREAD_SYMBOL() is then derived from the index of the
+// thread in the .k_threads section.
+//
+// 0: Full thread control block.
+// 1: Compact thread control block.
+//
+#ifndef CONFIG_THREAD_COMPACT
+#define CONFIG_THREAD_COMPACT 0
+#endif
+
+//
+// Build the initial stacks of the static threads (K_THREAD_DEFINE) at
+// compile time.
+//
+// The initial context of each thread is stored little-endian by the compiler
+// and is swapped at boot, stacks canaries are also written at boot. When
+// enabled, scripts/stack_image.py patches the .data image of the ELF file
+// after the link (big-endian context and canaries), so that the kernel
+// initialization does not depend on the total stacks size. The runtime
+// initialization is kept as a fallback if the ELF file was not patched.
+//
+// Requires CONFIG_AVRTOS_LINKER_SCRIPT.
+//
+// 0: Initial stacks are finalized at boot.
+// 1: Initial stacks are generated at build time.
+//
+#ifndef CONFIG_THREAD_STACK_IMAGE
+#define CONFIG_THREAD_STACK_IMAGE 0
+#endif
+
 //
 // Enable the system workqueue.
 //
@@ -608,6 +708,19 @@
 #define CONFIG_KERNEL_EVENTS_ALLOW_NO_WAIT 1
 #endif
 
+//
+// Enable deferred posts (k_post_* functions).
+// - ISRs can post a wake-up (semaphore give, flags set, signal raise) in O(1)
+//   without taking the kernel path. Posted wake-ups are processed in a batch
+//   on the next thread switch, system tick or k_post_yield_from_isr() call.
+//
+// 0: Deferred posts are disabled.
+// 1: Deferred posts are enabled.
+//
+#ifndef CONFIG_KERNEL_DEFERRED_POST
+#define CONFIG_KERNEL_DEFERRED_POST 0
+#endif
+
 //
 // Automatic initialization of the serial console.
 //
@@ -705,6 +818,47 @@
 #define CONFIG_KERNEL_ATOMIC_API 1
 #endif
 
+//
+// Enable the uncontended fast path of mutexes.
+// - k_mutex_lock() acquires a free mutex with a single atomic compare-and-swap
+//   on the lock byte, k_mutex_unlock() releases it the same way if no thread
+//   is waiting. The IRQ-locked path is only taken on contention.
+// - Requires CONFIG_KERNEL_ATOMIC_API.
+// - With CONFIG_KERNEL_REENTRANCY, the maximum lock count is reduced to 127.
+//
+// 0: Mutex fast path disabled.
+// 1: Mutex fast path enabled.
+//
+#ifndef CONFIG_KERNEL_MUTEX_FAST_PATH
+#define CONFIG_KERNEL_MUTEX_FAST_PATH 0
+#endif
+
+//
+// Lock the scheduler for the thread holding a read-write lock for writing.
+// - The writer cannot be preempted while updating the protected data, which
+//   bounds the time readers and other writers are blocked.
+//
+// 0: The writer can be preempted.
+// 1: The scheduler is locked while holding a read-write lock for writing.
+//
+#ifndef CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK
+#define CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK 0
+#endif
+
+//
+// Algorithm of the pseudo-random number generator (k_prng).
+// - The LFSR generator produces 16 bits per call (two 32-bit LFSRs).
+// - xorshift32 and xoshiro128** produce 32 bits per call, xoshiro128** has a
+//   better statistical quality for a state of 16 bytes.
+//
+// 0: LFSR (legacy).
+// 1: xorshift32.
+// 2: xoshiro128**.
+//
+#ifndef CONFIG_KERNEL_PRNG_ALGORITHM
+#define CONFIG_KERNEL_PRNG_ALGORITHM 0
+#endif
+
 //
 // Use UART0 RX interrupt as preemptive signal
 // Note: Reserved for debug purpose
@@ -826,6 +980,18 @@
 #define CONFIG_DRIVERS_USART3_ASYNC 0
 #endif
 
+//
+// Report the completion of the USART asynchronous transfers through kernel
+// semaphores, in addition to the optional callback. The threads wait for the
+// completions with usart_rx_wait() and usart_tx_wait().
+//
+// 0: Completions are only reported through the callback (interrupt context)
+// 1: Completions are also reported through semaphores
+//
+#ifndef CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+#define CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS 0
+#endif
+
 //
 // Enable high level support for timer0
 //
@@ -886,6 +1052,105 @@
 #define CONFIG_DRIVERS_TIMER5_API 0
 #endif
 
+//
+// External interrupts (INTn) handled by the EXTI dispatch layer
+//
+// The driver defines ISR(INTn_vect) for each bit n set, the edges of the pins
+// registered with exti_line_register() are dispatched to their callback,
+// semaphore or flags, optionally debounced (requires CONFIG_KERNEL_EVENTS).
+//
+// 0: EXTI dispatch is disabled
+// 1 << n: ISR(INTn_vect) is handled by the driver
+//
+// Example: with CONFIG_EXTI_DISPATCH_EXTI_MASK=0x03, INT0 and INT1 are
+// handled by the driver
+//
+#ifndef CONFIG_EXTI_DISPATCH_EXTI_MASK
+#define CONFIG_EXTI_DISPATCH_EXTI_MASK 0
+#endif
+
+//
+// Pin change interrupt groups handled by the EXTI dispatch layer
+//
+// The driver defines ISR(PCINTn_vect) for each bit n set, the pin which
+// changed in the group is found from the previous state of the port and the
+// edge is dispatched to the line registered with pci_line_register().
+//
+// 0: PCI dispatch is disabled
+// 1 << n: ISR(PCINTn_vect) is handled by the driver
+//
+#ifndef CONFIG_EXTI_DISPATCH_PCI_MASK
+#define CONFIG_EXTI_DISPATCH_PCI_MASK 0
+#endif
+
+//
+// Enable the interrupt-driven ADC scan
+//
+// The driver defines ISR(ADC_vect), a list of channels is converted in turn
+// (timer auto-trigger or back-to-back conversions) and the values are handed
+// to a thread by blocks.
+//
+// 0: ADC scan is disabled
+// 1: ADC scan is enabled
+//
+#ifndef CONFIG_ADC_SCAN
+#define CONFIG_ADC_SCAN 0
+#endif
+
+//
+// 16 bits timers used for input capture
+//
+// The driver defines ISR(TIMERn_CAPT_vect) and ISR(TIMERn_OVF_vect) for each
+// bit n set, the timer cannot be used for anything else (see capture.h).
+//
+// 0: Input capture is disabled
+// 1 << n: Input capture is enabled on timer n
+//
+// Example: with CONFIG_TIMER_CAPTURE_MASK=0x20, input capture is enabled on
+// timer 5 (ICP5)
+//
+#ifndef CONFIG_TIMER_CAPTURE_MASK
+#define CONFIG_TIMER_CAPTURE_MASK 0
+#endif
+
+//
+// Enable the software PWM (see swpwm.h)
+//
+// The driver defines ISR(TIMERn_COMPA_vect) for the timer CONFIG_SWPWM_TIMER.
+//
+// 0: Software PWM is disabled
+// 1: Software PWM is enabled
+//
+#ifndef CONFIG_SWPWM
+#define CONFIG_SWPWM 0
+#endif
+
+//
+// 16 bits timer used by the software PWM
+//
+// 1: Timer 1 (16 bits).
+// 3: Timer 3 (16 bits), ATmega2560/ATmega328PB/...
+// 4: Timer 4 (16 bits), ATmega2560/ATmega328PB/...
+// 5: Timer 5 (16 bits), ATmega2560/...
+//
+#ifndef CONFIG_SWPWM_TIMER
+#define CONFIG_SWPWM_TIMER 3
+#endif
+
+//
+// Maximum number of software PWM channels
+//
+#ifndef CONFIG_SWPWM_CHANNELS
+#define CONFIG_SWPWM_CHANNELS 16
+#endif
+
+//
+// Maximum number of GPIO ports used by the software PWM channels
+//
+#ifndef CONFIG_SWPWM_PORTS
+#define CONFIG_SWPWM_PORTS 3
+#endif
+
 //
 // SD card block size in bytes
 //
@@ -1132,6 +1397,33 @@
 #define CONFIG_I2C_LAST_ERROR 1
 #endif
 
+//
+// Enable the I2C transaction queue (i2c_submit()).
+//
+// Transactions (sequences of messages of any length) are queued and processed
+// back-to-back from the TWI interrupt, their completion is signalled with a
+// semaphore. The i2c_master_*() functions then sleep until the end of their
+// transaction (whatever CONFIG_I2C_BLOCKING) and CONFIG_I2C_MAX_BUF_LEN_BITS
+// is ignored.
+//
+// Requires CONFIG_I2C_INTERRUPT_DRIVEN.
+//
+// 0: I2C transaction queue is disabled
+// 1: I2C transaction queue is enabled
+//
+#ifndef CONFIG_I2C_QUEUE
+#define CONFIG_I2C_QUEUE 0
+#endif
+
+//
+// Maximum time (in milliseconds) the sensor acquisition engine waits for the
+// next completion of a burst of reads, the reads still in progress are then
+// reported as failed (e.g. stalled bus).
+//
+#ifndef CONFIG_SENSOR_BURST_TIMEOUT_MS
+#define CONFIG_SENSOR_BURST_TIMEOUT_MS 100
+#endif
+
 //
 // Enable I2C driver debug
 //
@@ -1148,7 +1440,6 @@
 // 1: 8 bits (default)
 // 2: 16 bits
 // 4: 32 bits
-// 8: 64 bits
 //
 #ifndef CONFIG_KERNEL_FLAGS_SIZE
 #define CONFIG_KERNEL_FLAGS_SIZE 1
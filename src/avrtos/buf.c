@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "buf.h"
+
+#include <string.h>
+
+#include "kernel.h"
+#include "kernel_private.h"
+
+#define K_MODULE K_MODULE_BUF
+
+int8_t k_buf_pool_init(struct k_buf_pool *pool, struct k_mem_slab *slab)
+{
+    if (!z_user(pool && slab && (slab->allocator.block_size > sizeof(struct k_buf))))
+        return -EINVAL;
+
+    pool->slab      = slab;
+    pool->data_size = slab->allocator.block_size - sizeof(struct k_buf);
+
+    return 0;
+}
+
+struct k_buf *k_buf_alloc(struct k_buf_pool *pool, k_timeout_t timeout)
+{
+    if (!z_user(pool))
+        return NULL;
+
+    struct k_buf *buf;
+
+    if (k_mem_slab_alloc(pool->slab, (void **)&buf, timeout) != 0) {
+        return NULL;
+    }
+
+    buf->_tie.next = NULL;
+    buf->frags     = NULL;
+    buf->pool      = pool;
+    buf->data      = buf->__buf;
+    buf->len       = 0u;
+    buf->size      = pool->data_size;
+    buf->ref       = 1u;
+
+    return buf;
+}
+
+struct k_buf *k_buf_ref(struct k_buf *buf)
+{
+    __ASSERT_NOTNULL(buf);
+
+    const uint8_t key = irq_lock();
+
+    __ASSERT_TRUE(buf->ref != 0u && buf->ref != UINT8_MAX);
+    buf->ref++;
+
+    irq_unlock(key);
+
+    return buf;
+}
+
+void k_buf_unref(struct k_buf *buf)
+{
+    while (buf != NULL) {
+        struct k_buf *const frags = buf->frags;
+
+        const uint8_t key = irq_lock();
+
+        __ASSERT_TRUE(buf->ref != 0u);
+        const uint8_t ref = --buf->ref;
+
+        irq_unlock(key);
+
+        if (ref != 0u) {
+            break;
+        }
+
+        /* Last reference released, also release the one held on the fragments */
+        k_mem_slab_free(buf->pool->slab, buf);
+        buf = frags;
+    }
+}
+
+void k_buf_reserve(struct k_buf *buf, uint16_t headroom)
+{
+    __ASSERT_NOTNULL(buf);
+    __ASSERT_TRUE((buf->len == 0u) && (headroom <= buf->size));
+
+    buf->data = buf->__buf + headroom;
+}
+
+void *k_buf_add(struct k_buf *buf, uint16_t len)
+{
+    __ASSERT_NOTNULL(buf);
+
+    if (len > k_buf_tailroom(buf)) {
+        return NULL;
+    }
+
+    uint8_t *const tail = buf->data + buf->len;
+    buf->len += len;
+
+    return tail;
+}
+
+void *k_buf_add_mem(struct k_buf *buf, const void *mem, uint16_t len)
+{
+    void *const tail = k_buf_add(buf, len);
+
+    if (tail != NULL) {
+        memcpy(tail, mem, len);
+    }
+
+    return tail;
+}
+
+void *k_buf_remove(struct k_buf *buf, uint16_t len)
+{
+    __ASSERT_NOTNULL(buf);
+
+    if (len > buf->len) {
+        return NULL;
+    }
+
+    buf->len -= len;
+
+    return buf->data + buf->len;
+}
+
+void *k_buf_push(struct k_buf *buf, uint16_t len)
+{
+    __ASSERT_NOTNULL(buf);
+
+    if (len > k_buf_headroom(buf)) {
+        return NULL;
+    }
+
+    buf->data -= len;
+    buf->len += len;
+
+    return buf->data;
+}
+
+void *k_buf_pull(struct k_buf *buf, uint16_t len)
+{
+    __ASSERT_NOTNULL(buf);
+
+    if (len > buf->len) {
+        return NULL;
+    }
+
+    uint8_t *const head = buf->data;
+    buf->data += len;
+    buf->len -= len;
+
+    return head;
+}
+
+void k_buf_frag_add(struct k_buf *head, struct k_buf *frag)
+{
+    __ASSERT_NOTNULL(head);
+    __ASSERT_NOTNULL(frag);
+
+    while (head->frags != NULL) {
+        head = head->frags;
+    }
+
+    head->frags = frag;
+}
+
+struct k_buf *k_buf_frag_del(struct k_buf *parent, struct k_buf *frag)
+{
+    __ASSERT_NOTNULL(frag);
+
+    struct k_buf *const next = frag->frags;
+
+    if (parent != NULL) {
+        __ASSERT_TRUE(parent->frags == frag);
+        parent->frags = next;
+    }
+
+    /* Only release the removed fragment */
+    frag->frags = NULL;
+    k_buf_unref(frag);
+
+    return next;
+}
+
+size_t k_buf_frags_len(struct k_buf *buf)
+{
+    size_t len = 0u;
+
+    for (; buf != NULL; buf = buf->frags) {
+        len += buf->len;
+    }
+
+    return len;
+}
+
+size_t k_buf_linearize(void *dst, size_t len, struct k_buf *buf, size_t offset)
+{
+    uint8_t *const out = dst;
+    size_t copied      = 0u;
+
+    for (; (buf != NULL) && (copied < len); buf = buf->frags) {
+        if (offset >= buf->len) {
+            /* Skip the whole fragment */
+            offset -= buf->len;
+            continue;
+        }
+
+        const size_t n = MIN(len - copied, (size_t)(buf->len - offset));
+        memcpy(&out[copied], buf->data + offset, n);
+        copied += n;
+        offset = 0u;
+    }
+
+    return copied;
+}
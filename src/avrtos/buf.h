@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Buffers
+ *
+ * A buffer (k_buf) is a reference-counted block allocated from a buffer pool
+ * (k_buf_pool), which is a memory slab of fixed-size blocks. The data of a
+ * buffer can be extended at both ends: headroom is reserved when the buffer
+ * is allocated, so that lower layers can prepend their headers without moving
+ * the payload.
+ *
+ *  | struct k_buf | headroom | data (len)          | tailroom |
+ *                 ^          ^
+ *                 __buf      data
+ *
+ * Buffers are designed for zero-copy pipelines, e.g. from a reception ISR to a
+ * parser, a logger and an uplink:
+ * - A buffer can be handed over through a k_fifo (k_buf_put() / k_buf_get()).
+ * - Each additional consumer takes a reference (k_buf_ref()), the buffer is
+ *   returned to its pool when the last reference is released (k_buf_unref()).
+ * - Payloads larger than a block are chained as fragments (k_buf_frag_add()),
+ *   the head of the chain owns a reference to each of its fragments.
+ *
+ * Example Usage:
+ *
+ *   K_BUF_POOL_DEFINE(rx_pool, 8u, 32u);
+ *
+ *   struct k_buf *buf = k_buf_alloc(&rx_pool, K_NO_WAIT);
+ *   k_buf_reserve(buf, 4u);
+ *   k_buf_add_mem(buf, payload, payload_len);
+ *   memcpy(k_buf_push(buf, 2u), header, 2u);
+ *   k_buf_put(&rx_fifo, buf);
+ *
+ * Limitations:
+ * - A buffer can only be in one k_fifo at a time, consumers sharing a buffer
+ *   should exchange pointers instead (e.g. through a k_msgq).
+ * - Data of a buffer shared by several consumers must be considered read-only.
+ * - The number of references is limited to 255.
+ *
+ * Related configuration options:
+ *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks
+ *  - CONFIG_AVRTOS_LINKER_SCRIPT: Pools memory slabs are initialized
+ *    automatically (k_buf_pool_init() required otherwise).
+ */
+
+#ifndef _AVRTOS_BUF_H_
+#define _AVRTOS_BUF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dstruct/slist.h"
+#include "fifo.h"
+#include "kernel.h"
+#include "mem_slab.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Buffer pool structure
+ */
+struct k_buf_pool {
+    struct k_mem_slab *slab; ///< Memory slab of the buffers
+    uint16_t data_size;      ///< Data size of each buffer
+};
+
+/**
+ * @brief Buffer structure
+ */
+struct k_buf {
+    struct snode _tie;       ///< Tie for k_fifo hand-off (private)
+    struct k_buf *frags;     ///< Next fragment of the chain
+    struct k_buf_pool *pool; ///< Pool the buffer belongs to
+    uint8_t *data;           ///< Start of the data
+    uint16_t len;            ///< Length of the data
+    uint16_t size;           ///< Size of the storage
+    uint8_t ref;             ///< Number of references
+    uint8_t __buf[];         ///< Storage
+};
+
+/**
+ * @brief Statically define and initialize a buffer pool.
+ *
+ * @param _name Name of the buffer pool.
+ * @param _count Number of buffers in the pool (max 255).
+ * @param _data_size Data size of each buffer (headroom included).
+ */
+#define K_BUF_POOL_DEFINE(_name, _count, _data_size)                                     \
+    K_MEM_SLAB_DEFINE(z_buf_slab_##_name, sizeof(struct k_buf) + (_data_size), _count);  \
+    struct k_buf_pool _name = {                                                          \
+        .slab      = &z_buf_slab_##_name,                                                \
+        .data_size = _data_size,                                                         \
+    }
+
+/**
+ * @brief Initialize a buffer pool at runtime.
+ *
+ * @param pool Pointer to the buffer pool.
+ * @param slab Memory slab to allocate the buffers from, the block size must
+ * be greater than sizeof(struct k_buf).
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_buf_pool_init(struct k_buf_pool *pool, struct k_mem_slab *slab);
+
+/**
+ * @brief Allocate a buffer from a pool.
+ *
+ * The buffer is empty, has no headroom and holds one reference.
+ *
+ * Safety: This function is safe to call from an ISR context if the timeout
+ * is K_NO_WAIT.
+ *
+ * @param pool Pointer to the buffer pool.
+ * @param timeout Maximum time to wait for a buffer to become available.
+ * @return Pointer to the buffer, or NULL if none could be allocated.
+ */
+__kernel struct k_buf *k_buf_alloc(struct k_buf_pool *pool, k_timeout_t timeout);
+
+/**
+ * @brief Take a reference on a buffer.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param buf Pointer to the buffer.
+ * @return The buffer.
+ */
+__kernel struct k_buf *k_buf_ref(struct k_buf *buf);
+
+/**
+ * @brief Release a reference on a buffer.
+ *
+ * When the last reference is released, the buffer is returned to its pool and
+ * the references it holds on its fragments are released.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param buf Pointer to the buffer.
+ */
+__kernel void k_buf_unref(struct k_buf *buf);
+
+/**
+ * @brief Reserve headroom in an empty buffer.
+ *
+ * @param buf Pointer to the buffer, must be empty.
+ * @param headroom Number of bytes to reserve at the beginning of the buffer.
+ */
+__kernel void k_buf_reserve(struct k_buf *buf, uint16_t headroom);
+
+/**
+ * @brief Get the headroom of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @return Number of bytes which can be prepended with k_buf_push().
+ */
+static inline uint16_t k_buf_headroom(struct k_buf *buf)
+{
+    return (uint16_t)(buf->data - buf->__buf);
+}
+
+/**
+ * @brief Get the tailroom of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @return Number of bytes which can be appended with k_buf_add().
+ */
+static inline uint16_t k_buf_tailroom(struct k_buf *buf)
+{
+    return buf->size - k_buf_headroom(buf) - buf->len;
+}
+
+/**
+ * @brief Append data to the end of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @param len Number of bytes to append.
+ * @return Pointer to the appended area, NULL if the tailroom is too small.
+ */
+__kernel void *k_buf_add(struct k_buf *buf, uint16_t len);
+
+/**
+ * @brief Copy data to the end of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @param mem Data to copy.
+ * @param len Number of bytes to copy.
+ * @return Pointer to the appended area, NULL if the tailroom is too small.
+ */
+__kernel void *k_buf_add_mem(struct k_buf *buf, const void *mem, uint16_t len);
+
+/**
+ * @brief Remove data from the end of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @param len Number of bytes to remove.
+ * @return Pointer to the removed area, NULL if the buffer is too short.
+ */
+__kernel void *k_buf_remove(struct k_buf *buf, uint16_t len);
+
+/**
+ * @brief Prepend data to the beginning of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @param len Number of bytes to prepend.
+ * @return Pointer to the new beginning of the data, NULL if the headroom is
+ * too small.
+ */
+__kernel void *k_buf_push(struct k_buf *buf, uint16_t len);
+
+/**
+ * @brief Remove data from the beginning of a buffer.
+ *
+ * @param buf Pointer to the buffer.
+ * @param len Number of bytes to remove.
+ * @return Pointer to the removed area (the previous beginning of the data),
+ * NULL if the buffer is too short.
+ */
+__kernel void *k_buf_pull(struct k_buf *buf, uint16_t len);
+
+/**
+ * @brief Append a fragment to the end of a chain.
+ *
+ * The chain takes over the reference of the caller on the fragment.
+ *
+ * @param head Head of the chain.
+ * @param frag Fragment (or chain of fragments) to append.
+ */
+__kernel void k_buf_frag_add(struct k_buf *head, struct k_buf *frag);
+
+/**
+ * @brief Remove a fragment from a chain and release its reference.
+ *
+ * @param parent Fragment preceding the fragment to remove, NULL if the
+ * fragment is the head of the chain.
+ * @param frag Fragment to remove.
+ * @return The fragment following the removed one, or NULL.
+ */
+__kernel struct k_buf *k_buf_frag_del(struct k_buf *parent, struct k_buf *frag);
+
+/**
+ * @brief Get the total length of the data of a chain.
+ *
+ * @param buf Head of the chain.
+ * @return Sum of the data lengths of the fragments.
+ */
+__kernel size_t k_buf_frags_len(struct k_buf *buf);
+
+/**
+ * @brief Copy the data of a chain to a linear buffer.
+ *
+ * @param dst Destination buffer.
+ * @param len Size of the destination buffer.
+ * @param buf Head of the chain.
+ * @param offset Offset in the data of the chain to start copying from.
+ * @return Number of bytes copied.
+ */
+__kernel size_t k_buf_linearize(void *dst, size_t len, struct k_buf *buf, size_t offset);
+
+/**
+ * @brief Hand a buffer (or chain) over through a FIFO.
+ *
+ * The receiver takes over the reference of the caller.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param fifo Pointer to the FIFO.
+ * @param buf Pointer to the buffer.
+ * @return The thread that was woken up, or NULL if no threads were waiting.
+ */
+static inline struct k_thread *k_buf_put(struct k_fifo *fifo, struct k_buf *buf)
+{
+    return k_fifo_put(fifo, &buf->_tie);
+}
+
+/**
+ * @brief Get a buffer (or chain) from a FIFO.
+ *
+ * @param fifo Pointer to the FIFO.
+ * @param timeout Maximum time to wait for a buffer.
+ * @return Pointer to the buffer, or NULL on timeout.
+ */
+static inline struct k_buf *k_buf_get(struct k_fifo *fifo, k_timeout_t timeout)
+{
+    return CONTAINER_OF(k_fifo_get(fifo, timeout), struct k_buf, _tie);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_BUF_H_ */
@@ -6,8 +6,14 @@
 
 #include "canaries.h"
 
+#include "errno.h"
+#include "kernel_private.h"
 #include "misc/serial.h"
 
+/* Stack information is not stored with CONFIG_THREAD_COMPACT, unless
+ * CONFIG_THREAD_CANARIES is enabled */
+#if Z_THREAD_STACK_INFO
+
 void z_init_thread_stack_canaries(struct k_thread *thread)
 {
     for (uint8_t *addr = Z_THREAD_STACK_START_USABLE(thread);
@@ -24,7 +30,13 @@ void z_init_stacks_canaries(void)
 {
     struct k_thread *thread;
 
+    const bool patched = z_stack_image_patched();
+
     for (thread = &__k_threads_start; thread < &__k_threads_end; thread++) {
+        /* Only the main thread stack is not part of the image */
+        if (patched && !Z_THREAD_IS_MAIN(thread)) {
+            continue;
+        }
         z_init_thread_stack_canaries(thread);
     }
 }
@@ -47,13 +59,52 @@ void *z_stack_canaries(struct k_thread *thread)
     return preserved;
 }
 
+void k_stack_scan_init(struct k_stack_scan *scan, struct k_thread *thread)
+{
+    scan->thread = thread;
+    scan->pos    = Z_THREAD_STACK_START_USABLE(thread);
+}
+
+int16_t k_stack_scan_step(struct k_stack_scan *scan, uint8_t budget)
+{
+    struct k_thread *const thread = scan->thread;
+    uint8_t *const start          = Z_THREAD_STACK_START_USABLE(thread);
+    uint8_t *const end            = start + Z_STACK_SIZE_USABLE(thread->stack.size);
+    uint8_t *pos                  = scan->pos;
+
+    /* Restart if the previous scan completed */
+    if (pos == NULL) {
+        pos = start;
+    }
+
+    while (budget-- != 0u) {
+        if ((pos == end) || (*pos != CONFIG_THREAD_CANARIES_SYMBOL)) {
+            scan->pos = NULL;
+            return (int16_t)(end - pos);
+        }
+        pos++;
+    }
+
+    scan->pos = pos;
+
+    return -EAGAIN;
+}
+
+size_t k_thread_stack_highwater(struct k_thread *thread)
+{
+    uint8_t *const start = (uint8_t *)Z_THREAD_STACK_START_USABLE(thread);
+
+    return Z_STACK_SIZE_USABLE(thread->stack.size) -
+           ((uint8_t *)z_stack_canaries(thread) - start);
+}
+
 void k_print_stack_canaries(struct k_thread *thread)
 {
     uint8_t *addr         = (uint8_t *)z_stack_canaries(thread);
     size_t canaries_found = addr - (uint8_t *)Z_THREAD_STACK_START_USABLE(thread);
 
     serial_transmit('[');
-    serial_transmit(thread->symbol);
+    serial_transmit(K_THREAD_SYMBOL(thread));
     serial_print_p(PSTR("] CANARIES @"));
     serial_hex16((uint16_t)addr);
     serial_print_p(PSTR(" ["));
@@ -76,3 +127,5 @@ void k_print_current_canaries(void)
 {
     k_print_stack_canaries(z_ker.current);
 }
+
+#endif /* Z_THREAD_STACK_INFO */
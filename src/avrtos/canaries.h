@@ -20,11 +20,33 @@
  *
  * This can be coupled with the stack sentinel feature.
  *
+ * The stack high-water mark can be measured incrementally with a stack scan
+ * (k_stack_scan_init() / k_stack_scan_step()): each step checks a bounded
+ * number of bytes, so that scanning large stacks (e.g. from the idle thread or
+ * a low priority thread) does not delay the other threads. A canary which is
+ * overwritten is never restored, the high-water mark found is therefore a
+ * lower bound of the maximum stack usage, exact at the time the scan completed.
+ *
+ * Example Usage:
+ *
+ *   struct k_stack_scan scan;
+ *   k_stack_scan_init(&scan, &thread);
+ *   while ((ret = k_stack_scan_step(&scan, 32u)) == -EAGAIN) {
+ *       k_yield();
+ *   }
+ *
+ * The static worst-case stack usage of the thread entry functions can be
+ * estimated on the host with scripts/stack_usage.py (see the script help).
+ *
  * Related configuration options:
  * - CONFIG_THREAD_CANARIES: Enable to use stack canaries for stack usage monitoring.
  * - CONFIG_AVRTOS_LINKER_SCRIPT: Enable to use the linker script to statically
  *   initialize stack canaries for all threads.
  * - CONFIG_THREAD_CANARIES_SYMBOL: The symbol used to fill the stack canaries.
+ *
+ * Limitations:
+ * - Stack data equal to CONFIG_THREAD_CANARIES_SYMBOL located right after the
+ *   last canary is counted as unused.
  */
 
 #ifndef _AVRTOS_CANARIES_H_
@@ -71,6 +93,46 @@ __kernel void z_init_stacks_canaries(void);
  */
 void *z_stack_canaries(struct k_thread *thread);
 
+/**
+ * @brief Incremental stack scan state
+ */
+struct k_stack_scan {
+    struct k_thread *thread; ///< Thread whose stack is scanned
+    uint8_t *pos;            ///< Next byte to check
+};
+
+/**
+ * @brief Initialize (or restart) an incremental stack scan.
+ *
+ * @param scan Pointer to the scan state.
+ * @param thread Thread whose stack is scanned.
+ */
+void k_stack_scan_init(struct k_stack_scan *scan, struct k_thread *thread);
+
+/**
+ * @brief Check the next bytes of a stack scan.
+ *
+ * Once complete, the scan is restarted by the next call.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param scan Pointer to the scan state.
+ * @param budget Maximum number of bytes to check.
+ * @return int16_t Stack high-water mark in bytes when the scan is complete,
+ * -EAGAIN if the scan is not complete yet.
+ */
+int16_t k_stack_scan_step(struct k_stack_scan *scan, uint8_t budget);
+
+/**
+ * @brief Get the stack high-water mark of a thread.
+ *
+ * The whole stack is scanned at once, interrupts are not disabled.
+ *
+ * @param thread Pointer to the thread.
+ * @return size_t Maximum number of stack bytes used so far (sentinel excluded).
+ */
+size_t k_thread_stack_highwater(struct k_thread *thread);
+
 /**
  * @brief Print stack canary information for a specific thread.
  *
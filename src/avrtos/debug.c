@@ -18,6 +18,10 @@
 
 uint16_t k_thread_usage(struct k_thread *thread)
 {
+#if !Z_THREAD_STACK_INFO
+    ARG_UNUSED(thread);
+    return 0u;
+#else
     if (NULL == thread->sp) {
         return 0u;
     } else if (thread == z_ker.current) {
@@ -33,6 +37,7 @@ uint16_t k_thread_usage(struct k_thread *thread)
         // empty stack : thread->stack.end == thread->sp
         return ((uint16_t)thread->stack.end) - ((uint16_t)thread->sp);
     }
+#endif /* Z_THREAD_STACK_INFO */
 }
 
 #if CONFIG_AVRTOS_LINKER_SCRIPT
@@ -63,7 +68,7 @@ void k_thread_dump_hex(struct k_thread *thread)
 
 void k_thread_dump(struct k_thread *thread)
 {
-    serial_transmit(thread->symbol);
+    serial_transmit(K_THREAD_SYMBOL(thread));
     serial_print_p(PSTR(" 0x"));
     serial_hex16((const uint16_t)thread);
 
@@ -98,33 +103,39 @@ void k_thread_dump(struct k_thread *thread)
     serial_transmit(thread->flags & Z_THREAD_PEND_CANCELED_MSK ? 'Y' : '_');
     serial_transmit(thread->flags & Z_THREAD_WAKEUP_SCHED_MSK ? 'W' : '_');
 
+#if Z_THREAD_STACK_INFO
     serial_print_p(PSTR(" : SP "));
     serial_u16(k_thread_usage(thread));
     serial_transmit('/');
     serial_u16(thread->stack.size);
     serial_print_p(PSTR(":0x"));
     serial_hex16((uint16_t)thread->stack.end);
+#endif
     serial_transmit('\n');
 }
 
 void *z_thread_get_return_addr(struct k_thread *thread)
 {
+#if Z_THREAD_STACK_INFO
     if (thread == z_ker.current) {
         uint16_t return_addr_reverted = *((uint16_t *)((uint16_t)thread->stack.end - 2u));
 
         return (void *)K_SWAP_ENDIANNESS(return_addr_reverted);
     }
+#else
+    ARG_UNUSED(thread);
+#endif
     return NULL;
 }
 
 void z_thread_symbol_runqueue(struct dnode *item)
 {
-    serial_transmit(CONTAINER_OF(item, struct k_thread, tie.runqueue)->symbol);
+    serial_transmit(K_THREAD_SYMBOL(CONTAINER_OF(item, struct k_thread, tie.runqueue)));
 }
 
 void z_thread_symbol_events_queue(struct titem *item)
 {
-    serial_transmit(CONTAINER_OF(item, struct k_thread, tie.event)->symbol);
+    serial_transmit(K_THREAD_SYMBOL(CONTAINER_OF(item, struct k_thread, tie.event)));
 }
 
 void z_print_runqueue(void)
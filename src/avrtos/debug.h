@@ -28,10 +28,10 @@ extern "C" {
 
 #define __Z_DBG_HELPER_TH(thread, chr)                                                   \
     serial_transmit(chr);                                                                \
-    serial_transmit(thread->symbol)
+    serial_transmit(K_THREAD_SYMBOL(thread))
 
 #define __Z_DBG_HELPER_TH_R(thread, chr)                                                 \
-    serial_transmit(thread->symbol);                                                     \
+    serial_transmit(K_THREAD_SYMBOL(thread));                                            \
     serial_transmit(chr)
 
 #if CONFIG_KERNEL_SCHEDULER_DEBUG
@@ -42,7 +42,7 @@ extern "C" {
 #define __Z_DBG_SCHED_SUSPENDED(thread) serial_transmit('~')
 #define __Z_DBG_SCHED_NEXT_THREAD()     serial_transmit('>')
 #define __Z_DBG_SCHED_SKIP_IDLE()       serial_print_p(PSTR("p"))
-#define __Z_DBG_SCHED_NEXT(thread)      serial_transmit(thread->symbol)
+#define __Z_DBG_SCHED_NEXT(thread)      serial_transmit(K_THREAD_SYMBOL(thread))
 #define __Z_DBG_WAKEUP(thread)          __Z_DBG_HELPER_TH(thread, '@')
 
 #define __Z_DBG_MUTEX_LOCKED(thread)   __Z_DBG_HELPER_TH(thread, '}')
@@ -47,6 +47,21 @@
     "CONFIG_SYSTEM_WORKQUEUE_COOPERATIVE is required with CONFIG_KERNEL_COOPERATIVE_THREADS"
 #endif
 
+#if CONFIG_KERNEL_MUTEX_FAST_PATH && !CONFIG_KERNEL_ATOMIC_API
+#error "CONFIG_KERNEL_MUTEX_FAST_PATH requires CONFIG_KERNEL_ATOMIC_API"
+#endif
+
+#define Z_GLOBAL_ALLOCATOR_CLASSES                                                       \
+    ((CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_8 > 0) +                                      \
+     (CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_16 > 0) +                                     \
+     (CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_32 > 0) +                                     \
+     (CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_64 > 0))
+
+#if Z_GLOBAL_ALLOCATOR_CLASSES && !CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE
+#error                                                                                   \
+    "CONFIG_KERNEL_GLOBAL_ALLOCATOR_CLASS_* require CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE"
+#endif
+
 #if CONFIG_SYSTEM_WORKQUEUE_COOPERATIVE
 #define CONFIG_SYSTEM_WORKQUEUE_PRIORITY K_COOPERATIVE
 #else
@@ -276,6 +291,16 @@ typedef struct {
 // set
 #define Z_THREAD_STACK_START(name) ((uint8_t *)(&z_stack_buf_##name))
 
+/* Whether struct k_thread holds the stack information and the symbol */
+#if !CONFIG_THREAD_COMPACT || CONFIG_THREAD_CANARIES || CONFIG_THREAD_STACK_SENTINEL ||  \
+    CONFIG_THREAD_MONITOR || CONFIG_THREAD_MAIN_MONITOR
+#define Z_THREAD_STACK_INFO 1
+#else
+#define Z_THREAD_STACK_INFO 0
+#endif
+
+#define Z_THREAD_SYMBOL (!CONFIG_THREAD_COMPACT)
+
 #define Z_THREAD_STACK_SIZE(name) (sizeof(z_stack_buf_##name))
 
 #define Z_STACK_INIT_SP_FROM_NAME(name, stack_size)                                      \
@@ -336,6 +361,22 @@ typedef struct {
 #define Z_THREAD_join_waitqueue_INITIALIZER(_name) /* empty */
 #endif
 
+#if Z_THREAD_STACK_INFO
+#define Z_THREAD_stack_INITIALIZER(_name, stack_size)                                    \
+    .stack = {                                                                           \
+        .end  = (void *)Z_STACK_END(Z_THREAD_STACK_START(_name), stack_size),            \
+        .size = (stack_size),                                                            \
+    },
+#else
+#define Z_THREAD_stack_INITIALIZER(_name, stack_size) /* empty */
+#endif
+
+#if Z_THREAD_SYMBOL
+#define Z_THREAD_symbol_INITIALIZER(sym) .symbol = sym,
+#else
+#define Z_THREAD_symbol_INITIALIZER(sym) /* empty */
+#endif
+
 #define Z_THREAD_INITIALIZER(_name, stack_size, _flags, sym)                             \
     struct k_thread _name = {                                                            \
         .sp        = (void *)Z_STACK_INIT_SP_FROM_NAME(_name, stack_size),               \
@@ -343,14 +384,10 @@ typedef struct {
         .tie       = {.runqueue = DITEM_INIT(NULL)},                                     \
         .wqhandle  = WQHANDLE_INIT(),                                                    \
         .swap_data = NULL,                                                               \
-        .stack =                                                                         \
-            {                                                                            \
-                .end  = (void *)Z_STACK_END(Z_THREAD_STACK_START(_name), stack_size),    \
-                .size = (stack_size),                                                    \
-            },                                                                           \
-        .symbol = sym,                                                                   \
-        Z_THREAD_sched_lock_cnt_INITIALIZER()                                            \
-            Z_THREAD_join_waitqueue_INITIALIZER(_name)}
+        Z_THREAD_stack_INITIALIZER(_name, stack_size)                                    \
+            Z_THREAD_symbol_INITIALIZER(sym)                                             \
+                Z_THREAD_sched_lock_cnt_INITIALIZER()                                    \
+                    Z_THREAD_join_waitqueue_INITIALIZER(_name)}
 
 #if CONFIG_AVRTOS_LINKER_SCRIPT
 #define Z_THREAD_DEFINE(name, entry, stack_size, prio_flag, context_p, symbol,           \
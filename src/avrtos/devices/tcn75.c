@@ -96,3 +96,28 @@ int16_t tcn75_select_read(struct tcn75_device *tcn75)
 
     return temperature;
 }
+
+static int8_t tcn75_sensor_decode(struct sensor *sensor, int16_t *value)
+{
+    struct tcn75_sensor *const ts = CONTAINER_OF(sensor, struct tcn75_sensor, sensor);
+
+    *value = tcn75_temp2int16(ts->buf[0], ts->buf[1]);
+
+    return 0;
+}
+
+int8_t tcn75_sensor_init(struct tcn75_sensor *ts, struct tcn75_device *tcn75, uint8_t id)
+{
+    if (!z_user(ts && tcn75))
+        return -EINVAL;
+
+    ts->reg     = TCN75_TEMPERATURE_REGISTER;
+    ts->msgs[0] = (struct i2c_msg){.buf = &ts->reg, .len = 1u, .flags = I2C_MSG_WRITE};
+    ts->msgs[1] = (struct i2c_msg){.buf = ts->buf, .len = 2u, .flags = I2C_MSG_READ};
+
+    ts->sensor.xfer   = (struct i2c_xfer)I2C_XFER_INIT(tcn75->addr, ts->msgs, 2u, NULL);
+    ts->sensor.decode = tcn75_sensor_decode;
+    ts->sensor.id     = id;
+
+    return 0;
+}
@@ -12,6 +12,7 @@
 
 #include <avrtos/drivers/i2c.h>
 #include <avrtos/kernel.h>
+#include <avrtos/subsystems/sensor.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -117,6 +118,29 @@ int16_t tcn75_read(struct tcn75_device *tcn75);
  */
 int16_t tcn75_select_read(struct tcn75_device *tcn75);
 
+/**
+ * @brief TCN75 sensor for the sensor acquisition engine
+ */
+struct tcn75_sensor {
+    struct sensor sensor;
+    uint8_t reg;
+    uint8_t buf[2u];
+    struct i2c_msg msgs[2u];
+};
+
+/**
+ * @brief Initialize a TCN75 sensor for the sensor acquisition engine, values
+ * are temperatures in 0.01°C resolution.
+ *
+ * The sensor must then be registered with sensor_register().
+ *
+ * @param ts TCN75 sensor to initialize
+ * @param tcn75 initialized (and configured) TCN75 context
+ * @param id Identifier of the samples
+ * @return int8_t 0 if success, negative value otherwise
+ */
+int8_t tcn75_sensor_init(struct tcn75_sensor *ts, struct tcn75_device *tcn75, uint8_t id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "adc.h"
+
+#include <avrtos/drivers/timer.h>
+#include <avrtos/systime.h>
+
+#if CONFIG_ADC_SCAN
+/* Running scan */
+static struct adc_scan *z_adc_scan;
+#endif
+
+__always_inline void adc_set_channel(uint8_t channel)
+{
+    ADC_DEVICE->ADMUXn = (ADC_DEVICE->ADMUXn & ~ADC_MUX_MASK) | (channel & ADC_MUX_MASK);
+#if defined(MUX5)
+    if (channel & ADC_MUX5_FLAG) {
+        ADC_DEVICE->ADCSRB |= BIT(MUX5);
+    } else {
+        ADC_DEVICE->ADCSRB &= ~BIT(MUX5);
+    }
+#endif
+}
+
+int8_t adc_init(const struct adc_config *config)
+{
+    if (!z_user(config && (config->prescaler != 0u)))
+        return -EINVAL;
+
+#if defined(PRR0)
+    PRR0 &= ~BIT(PRADC);
+#elif defined(PRR)
+    PRR &= ~BIT(PRADC);
+#endif
+
+    ADC_DEVICE->ADMUXn = config->ref << ADC_REFS_SHIFT;
+    ADC_DEVICE->ADCSRB = 0u;
+    ADC_DEVICE->ADCSRA = BIT(ADEN) | config->prescaler;
+
+    return 0;
+}
+
+void adc_deinit(void)
+{
+    ADC_DEVICE->ADCSRA = 0u;
+
+#if defined(PRR0)
+    PRR0 |= BIT(PRADC);
+#elif defined(PRR)
+    PRR |= BIT(PRADC);
+#endif
+}
+
+int16_t adc_read(uint8_t channel)
+{
+#if CONFIG_ADC_SCAN
+    if (z_adc_scan != NULL)
+        return -EBUSY;
+#endif
+
+    adc_set_channel(channel);
+
+    ADC_DEVICE->ADCSRA |= BIT(ADSC);
+    while (ADC_DEVICE->ADCSRA & BIT(ADSC))
+        ;
+
+    return (int16_t)ADC_DEVICE->ADCn;
+}
+
+int8_t adc_entropy(uint8_t channel, uint32_t *entropy)
+{
+    uint32_t e = 0u;
+
+    if (!z_user(entropy))
+        return -EINVAL;
+
+    for (uint8_t i = 0u; i < 32u; i++) {
+        const int16_t value = adc_read(channel);
+        if (value < 0)
+            return (int8_t)value;
+
+        /* The noise is in the least significant bits, the LSB of each
+         * conversion ends up at a different position */
+        e = ((e << 1u) | (e >> 31u)) ^ (uint16_t)value;
+    }
+
+    *entropy = e;
+
+    return 0;
+}
+
+#if CONFIG_ADC_SCAN
+
+/**
+ * @brief Configure and start the timer of the trigger.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+static int8_t adc_trigger_start(adc_trigger_t trigger, uint32_t period_us)
+{
+    uint16_t counter;
+    int8_t prescaler;
+
+    struct timer_config cfg = {
+        .mode  = TIMER_MODE_CTC,
+        .timsk = 0u,
+    };
+
+    switch (trigger) {
+    case ADC_TRIGGER_CONTINUOUS:
+        return 0;
+#if defined(TIMER0_DEVICE)
+    case ADC_TRIGGER_TIMER0_COMPA:
+        if (CONFIG_KERNEL_SYSLOCK_HW_TIMER == TIMER0_INDEX)
+            return -EINVAL;
+
+        prescaler = timer_calc_prescaler(TIMER0_INDEX, period_us, &counter);
+        if (prescaler < 0)
+            return prescaler;
+
+        cfg.prescaler = prescaler;
+        cfg.counter   = counter;
+        ll_timer8_init(TIMER0_DEVICE, TIMER0_INDEX, &cfg);
+        return 0;
+#endif
+#if defined(TIMER1_DEVICE)
+    case ADC_TRIGGER_TIMER1_COMPB:
+        if (CONFIG_KERNEL_SYSLOCK_HW_TIMER == TIMER1_INDEX)
+            return -EINVAL;
+
+        prescaler = timer_calc_prescaler(TIMER1_INDEX, period_us, &counter);
+        if (prescaler < 0)
+            return prescaler;
+
+        /* Compare match B at the TOP of the CTC mode (OCR1A) */
+        ll_timer16_write_reg16(&TIMER1_DEVICE->OCRnB, counter);
+        cfg.prescaler = prescaler;
+        cfg.counter   = counter;
+        ll_timer16_init(TIMER1_DEVICE, TIMER1_INDEX, &cfg);
+        return 0;
+#endif
+    default:
+        return -EINVAL;
+    }
+}
+
+static void adc_trigger_stop(adc_trigger_t trigger)
+{
+    switch (trigger) {
+#if defined(TIMER0_DEVICE)
+    case ADC_TRIGGER_TIMER0_COMPA:
+        ll_timer8_stop(TIMER0_DEVICE);
+        break;
+#endif
+#if defined(TIMER1_DEVICE)
+    case ADC_TRIGGER_TIMER1_COMPB:
+        ll_timer16_stop(TIMER1_DEVICE);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+int8_t adc_scan_start(struct adc_scan *scan)
+{
+    if (!z_user(scan && scan->channels && (scan->channels_count != 0u) &&
+                scan->blocks[0u] && scan->blocks[1u] && (scan->block_len != 0u) &&
+                (scan->block_len % scan->channels_count == 0u) &&
+                (scan->oversampling <= ADC_OVERSAMPLING_MAX)))
+        return -EINVAL;
+
+    if (z_adc_scan != NULL)
+        return -EBUSY;
+
+    k_fifo_init(&scan->full);
+    scan->overruns = 0u;
+    scan->current  = scan->blocks[0u];
+    scan->released = BIT(1u);
+    scan->pos      = 0u;
+    scan->acc      = 0u;
+    scan->channel  = 0u;
+    scan->conv     = 0u;
+
+    for (uint8_t i = 0u; i < scan->channels_count; i++) {
+        const uint8_t channel = scan->channels[i];
+        if ((channel & ADC_MUX_MASK) < 8u) {
+            /* Digital input buffers of the analog pins */
+            if (channel & ADC_MUX5_FLAG) {
+                ADC_DEVICE->DIDR2n |= BIT(channel & 0x07u);
+            } else {
+                ADC_DEVICE->DIDR0n |= BIT(channel & 0x07u);
+            }
+        }
+    }
+
+    adc_set_channel(scan->channels[0u]);
+    z_adc_scan = scan;
+
+    ADC_DEVICE->ADCSRB = (ADC_DEVICE->ADCSRB & ~ADC_ADTS_MASK) | scan->trigger;
+    ADC_DEVICE->ADCSRA |= BIT(ADIF) | BIT(ADIE);
+
+    if (scan->trigger == ADC_TRIGGER_CONTINUOUS) {
+        ADC_DEVICE->ADCSRA |= BIT(ADSC);
+        return 0;
+    }
+
+    ADC_DEVICE->ADCSRA |= BIT(ADATE);
+
+    const int8_t ret = adc_trigger_start(scan->trigger, scan->period_us);
+    if (ret != 0) {
+        adc_scan_stop();
+    }
+
+    return ret;
+}
+
+void adc_scan_stop(void)
+{
+    const uint8_t key = irq_lock();
+
+    ADC_DEVICE->ADCSRA &= ~(BIT(ADATE) | BIT(ADIE));
+
+    if (z_adc_scan != NULL) {
+        adc_trigger_stop(z_adc_scan->trigger);
+        z_adc_scan = NULL;
+    }
+
+    irq_unlock(key);
+
+    /* Wait for the end of an ongoing conversion */
+    while (ADC_DEVICE->ADCSRA & BIT(ADSC))
+        ;
+}
+
+struct adc_block *adc_scan_get(struct adc_scan *scan, k_timeout_t timeout)
+{
+    struct snode *const item = k_fifo_get(&scan->full, timeout);
+
+    return item ? CONTAINER_OF(item, struct adc_block, _tie) : NULL;
+}
+
+void adc_block_release(struct adc_scan *scan, struct adc_block *block)
+{
+    const uint8_t key = irq_lock();
+    scan->released |= BIT(block == scan->blocks[1u]);
+    irq_unlock(key);
+}
+
+ISR(ADC_vect)
+{
+    struct adc_scan *const scan = z_adc_scan;
+    struct k_thread *thread     = NULL;
+
+    /* The trigger is the rising edge of the timer flag, which is cleared here
+     * as the timer interrupt is not enabled */
+#if defined(TIMER0_DEVICE)
+    if (scan->trigger == ADC_TRIGGER_TIMER0_COMPA) {
+        TIFR0 = BIT(OCF0A);
+    }
+#endif
+#if defined(TIMER1_DEVICE)
+    if (scan->trigger == ADC_TRIGGER_TIMER1_COMPB) {
+        TIFR1 = BIT(OCF1B);
+    }
+#endif
+
+    scan->acc += ADC_DEVICE->ADCn;
+
+    if ((++scan->conv >> scan->oversampling) == 0u) {
+        /* Oversampling, convert the same channel again */
+        goto next;
+    }
+
+    const uint16_t value  = scan->acc >> scan->oversampling;
+    const uint8_t channel = scan->channel;
+
+    scan->acc  = 0u;
+    scan->conv = 0u;
+    if (++scan->channel == scan->channels_count) {
+        scan->channel = 0u;
+    }
+    adc_set_channel(scan->channels[scan->channel]);
+
+    if ((scan->current == NULL) && (channel == 0u) && scan->released) {
+        /* Blocks always start with the first channel */
+        const uint8_t index = (scan->released & BIT(0u)) ? 0u : 1u;
+        scan->released &= ~BIT(index);
+        scan->current = scan->blocks[index];
+        scan->pos     = 0u;
+    }
+
+    if (scan->current == NULL) {
+        scan->overruns++;
+        goto next;
+    }
+
+    scan->current->samples[scan->pos] = value;
+    if (++scan->pos == scan->block_len) {
+#if CONFIG_KERNEL_TICKS_COUNTER
+        scan->current->timestamp = k_ticks_get_32();
+#endif
+        thread        = k_fifo_put(&scan->full, &scan->current->_tie);
+        scan->current = NULL;
+    }
+
+next:
+    if (scan->trigger == ADC_TRIGGER_CONTINUOUS) {
+        ADC_DEVICE->ADCSRA |= BIT(ADSC);
+    }
+
+    k_yield_from_isr_cond(thread);
+}
+
+#endif /* CONFIG_ADC_SCAN */
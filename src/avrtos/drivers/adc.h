@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AVRTOS_DRIVERS_ADC_H_
+#define _AVRTOS_DRIVERS_ADC_H_
+
+#include <avrtos/drivers.h>
+#include <avrtos/dstruct/slist.h>
+#include <avrtos/fifo.h>
+#include <avrtos/kernel.h>
+
+/**
+ * ADC driver
+ *
+ * Single conversions are done with adc_read() (busy wait, ~100us).
+ *
+ * With CONFIG_ADC_SCAN, the driver handles ADC_vect and scans a list of
+ * channels in turn, each conversion being started by a timer compare match
+ * (auto-trigger) or back-to-back from the interrupt. 2^oversampling
+ * conversions of a channel are averaged into a value, values are stored
+ * interleaved by channel in two blocks: when a block is full it is handed to
+ * the thread through a k_fifo while the other one is filled (double
+ * buffering). The thread releases the block once processed, values are
+ * dropped (and counted) if no block is available.
+ *
+ * Example Usage:
+ *
+ *   static const uint8_t channels[] = {ADC_CHANNEL(0), ADC_CHANNEL(1)};
+ *   static uint16_t buf[2][64];
+ *   static struct adc_block blocks[2] = {ADC_BLOCK_INIT(buf[0]), ADC_BLOCK_INIT(buf[1])};
+ *   static struct adc_scan scan = {
+ *       .channels       = channels,
+ *       .channels_count = ARRAY_SIZE(channels),
+ *       .trigger        = ADC_TRIGGER_TIMER0_COMPA,
+ *       .period_us      = 250u, // 4 kS/s
+ *       .blocks         = {&blocks[0], &blocks[1]},
+ *       .block_len      = 64u,
+ *   };
+ *
+ *   const struct adc_config config = {
+ *       .ref       = ADC_REF_AVCC,
+ *       .prescaler = ADC_PRESCALER_128,
+ *   };
+ *   adc_init(&config);
+ *   adc_scan_start(&scan);
+ *
+ *   for (;;) {
+ *       struct adc_block *block = adc_scan_get(&scan, K_FOREVER);
+ *       // process block->samples[0..63]
+ *       adc_block_release(&scan, block);
+ *   }
+ *
+ * Limitations:
+ * - A single scan can run at a time, adc_read() is not available meanwhile.
+ * - The trigger timer is configured by the driver and cannot be shared, it
+ *   must not be the kernel sysclock timer (CONFIG_KERNEL_SYSLOCK_HW_TIMER).
+ * - A conversion takes 13 ADC clock cycles (e.g. 104us with
+ *   ADC_PRESCALER_128 at 16MHz), the trigger period must be longer.
+ *
+ * Related configuration options:
+ *  - CONFIG_ADC_SCAN: Enable the interrupt-driven scan
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * @brief ADC registers.
+ */
+typedef struct {
+    __IO uint16_t ADCn;  /* Data register (ADCL, ADCH) */
+    __IO uint8_t ADCSRA; /* Control and status register A */
+    __IO uint8_t ADCSRB; /* Control and status register B */
+    __IO uint8_t ADMUXn; /* Multiplexer selection register */
+    __IO uint8_t DIDR2n; /* Digital input disable register 2 (ADC8-15) */
+    __IO uint8_t DIDR0n; /* Digital input disable register 0 (ADC0-7) */
+} ADC_Device;
+
+#define ADC_BASE_ADDR (AVR_IO_BASE_ADDR + 0x0078u)
+#define ADC_DEVICE    ((ADC_Device *)ADC_BASE_ADDR)
+
+/* ADMUX/ADCSRB bits */
+#define ADC_MUX_MASK    0x1Fu
+#define ADC_MUX5_FLAG   0x20u /* MUX5 bit (ADCSRB) in channel values */
+#define ADC_REFS_SHIFT  6u
+#define ADC_ADTS_MASK   0x07u
+
+/**
+ * @brief Channel value of the analog input n (ADC0 to ADC15).
+ */
+#define ADC_CHANNEL(_n) ((((_n) & 0x08u) << 2u) | ((_n) & 0x07u))
+
+/* Maximum oversampling, 2^6 10-bit conversions fit the accumulator */
+#define ADC_OVERSAMPLING_MAX 6u
+
+typedef enum {
+    ADC_REF_AREF = 0u, /* AREF pin */
+    ADC_REF_AVCC = 1u, /* AVCC with external capacitor at AREF pin */
+#if defined(__AVR_ATmega2560__)
+    ADC_REF_INTERNAL_1V1  = 2u, /* Internal 1.1V reference */
+    ADC_REF_INTERNAL_2V56 = 3u, /* Internal 2.56V reference */
+#else
+    ADC_REF_INTERNAL_1V1 = 3u, /* Internal 1.1V reference */
+#endif
+} adc_ref_t;
+
+typedef enum {
+    ADC_PRESCALER_2   = 1u,
+    ADC_PRESCALER_4   = 2u,
+    ADC_PRESCALER_8   = 3u,
+    ADC_PRESCALER_16  = 4u,
+    ADC_PRESCALER_32  = 5u,
+    ADC_PRESCALER_64  = 6u,
+    ADC_PRESCALER_128 = 7u, /* 125kHz at 16MHz, full 10-bit resolution */
+} adc_prescaler_t;
+
+/**
+ * @brief Conversion start of the scan, values are the ADTS auto-trigger
+ * sources.
+ */
+typedef enum {
+    /* Conversions are started back-to-back from the interrupt */
+    ADC_TRIGGER_CONTINUOUS = 0u,
+    /* Timer 0 in CTC mode, a conversion every period_us */
+    ADC_TRIGGER_TIMER0_COMPA = 3u,
+    /* Timer 1 in CTC mode (OCR1B = OCR1A), a conversion every period_us */
+    ADC_TRIGGER_TIMER1_COMPB = 5u,
+} adc_trigger_t;
+
+struct adc_config {
+    adc_ref_t ref : 2u;
+    adc_prescaler_t prescaler : 3u;
+};
+
+/**
+ * @brief Block of values, interleaved by channel.
+ */
+struct adc_block {
+    struct snode _tie;  ///< k_fifo item (private)
+    uint16_t *samples;  ///< Buffer of block_len values
+#if CONFIG_KERNEL_TICKS_COUNTER
+    uint32_t timestamp; ///< Time (in ticks) of the last value of the block
+#endif
+};
+
+#define ADC_BLOCK_INIT(_buf)                                                             \
+    {                                                                                    \
+        ._tie = SNODE_INIT(), .samples = _buf,                                           \
+    }
+
+/**
+ * @brief Scan of a list of channels, the members before the private ones are
+ * set by the user.
+ */
+struct adc_scan {
+    const uint8_t *channels; ///< Channels converted in turn (ADC_CHANNEL())
+    uint8_t channels_count;  ///< Number of channels
+    uint8_t oversampling;    ///< log2 of the conversions averaged per value
+    adc_trigger_t trigger;   ///< Conversion start
+    uint32_t period_us;      ///< Conversion period (timer triggers)
+
+    struct adc_block *blocks[2u]; ///< Blocks filled in turn
+    uint16_t block_len;           ///< Values per block (multiple of channels_count)
+
+    struct k_fifo full;         ///< Blocks handed to the thread (private)
+    volatile uint16_t overruns; ///< Values dropped, no block was available
+
+    /* Interrupt state (private) */
+    struct adc_block *current;
+    uint16_t pos;
+    uint16_t acc;
+    uint8_t channel;
+    uint8_t conv;
+    volatile uint8_t released; ///< Bitmask of the released blocks
+};
+
+/**
+ * @brief Enable the ADC.
+ *
+ * @param config ADC configuration.
+ * @return 0 on success, -EINVAL if the configuration is invalid.
+ */
+int8_t adc_init(const struct adc_config *config);
+
+/**
+ * @brief Disable the ADC, the scan must be stopped.
+ */
+void adc_deinit(void);
+
+/**
+ * @brief Convert a channel, waits (busy) for the end of the conversion.
+ *
+ * @param channel Channel value (ADC_CHANNEL()).
+ * @return 10-bit value, or -EBUSY if a scan is running.
+ */
+int16_t adc_read(uint8_t channel);
+
+/**
+ * @brief Collect entropy from the noise of 32 conversions of a channel, e.g.
+ * to seed a PRNG with k_prng_mix().
+ *
+ * The noise is the highest on an unconnected input or on the internal
+ * bandgap reference, the result is not suitable for cryptography.
+ *
+ * @param channel Channel value (ADC_CHANNEL()).
+ * @param entropy Entropy collected.
+ * @return 0 on success, -EINVAL if an argument is invalid, -EBUSY if a scan
+ * is running.
+ */
+int8_t adc_entropy(uint8_t channel, uint32_t *entropy);
+
+/**
+ * @brief Start a scan, the ADC must be initialized.
+ *
+ * The digital inputs of the scanned analog pins are disabled.
+ *
+ * @param scan Scan, with its user members set.
+ * @return 0 on success, -EINVAL if an argument is invalid, -EBUSY if a scan
+ * is already running, -ENOTSUP if the trigger period is not supported.
+ */
+int8_t adc_scan_start(struct adc_scan *scan);
+
+/**
+ * @brief Stop the running scan (and its trigger timer).
+ *
+ * The blocks handed to the thread remain in the fifo.
+ */
+void adc_scan_stop(void);
+
+/**
+ * @brief Get the next full block of a scan.
+ *
+ * @param scan Scan.
+ * @param timeout Time to wait for a block.
+ * @return Block, or NULL on timeout.
+ */
+struct adc_block *adc_scan_get(struct adc_scan *scan, k_timeout_t timeout);
+
+/**
+ * @brief Give back a processed block to the scan.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param scan Scan.
+ * @param block Block returned by adc_scan_get().
+ */
+void adc_block_release(struct adc_scan *scan, struct adc_block *block);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _AVRTOS_DRIVERS_ADC_H_ */
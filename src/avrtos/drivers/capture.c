@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "capture.h"
+
+#if CONFIG_TIMER_CAPTURE_MASK
+
+#if CONFIG_TIMER_CAPTURE_MASK & BIT(CONFIG_KERNEL_SYSLOCK_HW_TIMER)
+#error "CONFIG_TIMER_CAPTURE_MASK includes the sysclock timer"
+#endif
+
+#if CONFIG_TIMER_CAPTURE_MASK & (BIT(0) | BIT(2))
+#error "CONFIG_TIMER_CAPTURE_MASK only supports 16 bits timers"
+#endif
+
+static struct timer_capture *captures[TIMERS_COUNT];
+
+int8_t timer_capture_start(uint8_t tim_idx,
+                           struct timer_capture *cap,
+                           timer_prescaler_t prescaler,
+                           uint8_t flags)
+{
+    if (!z_user(cap && cap->buf && (cap->size != 0u) && (cap->size <= 128u) &&
+                ((cap->size & (cap->size - 1u)) == 0u) && (cap->batch != 0u) &&
+                (cap->batch <= cap->size) && (prescaler >= TIMER_PRESCALER_1) &&
+                (prescaler <= TIMER_PRESCALER_1024) &&
+                (!(flags & TIMER_CAPTURE_BOTH) || !(cap->batch & 1u))))
+        return -EINVAL;
+
+    if (!(TIMER_INDEX_EXISTS(tim_idx) && (CONFIG_TIMER_CAPTURE_MASK & BIT(tim_idx))))
+        return -ENOTSUP;
+
+    if (captures[tim_idx] != NULL)
+        return -EBUSY;
+
+    TIMER16_Device *const dev = timer_get_device(tim_idx);
+
+    cap->tim_idx   = tim_idx;
+    cap->flags     = flags;
+    cap->prescaler = prescaler;
+    cap->head      = 0u;
+    cap->tail      = 0u;
+    cap->pending   = 0u;
+    cap->skip      = 0u;
+    cap->overflows = 0u;
+    cap->dropped   = 0u;
+    k_sem_init(&cap->sem, 0u, 1u);
+
+    const struct timer_config cfg = {
+        .mode      = TIMER_MODE_NORMAL,
+        .prescaler = 0u, /* stopped */
+        .counter   = 0u,
+        .timsk     = 0u,
+    };
+    ll_timer16_init(dev, tim_idx, &cfg);
+
+    if (flags & TIMER_CAPTURE_NOISE_CANCELLER) {
+        dev->TCCRnB |= BIT(ICNCn);
+    }
+
+    /* Pairs start with a rising edge */
+    if (!(flags & TIMER_CAPTURE_FALLING) || (flags & TIMER_CAPTURE_BOTH)) {
+        dev->TCCRnB |= BIT(ICESn);
+    }
+
+    const uint8_t key  = irq_lock();
+    captures[tim_idx] = cap;
+    ll_timer_clear_irq_flags(tim_idx);
+    ll_timer_set_enable_int_mask(tim_idx, BIT(ICIEn) | BIT(TOIEn));
+    ll_timer16_start(dev, prescaler);
+    irq_unlock(key);
+
+    return 0;
+}
+
+void timer_capture_stop(uint8_t tim_idx)
+{
+    if (!TIMER_INDEX_EXISTS(tim_idx) || !(CONFIG_TIMER_CAPTURE_MASK & BIT(tim_idx))) {
+        return;
+    }
+
+    TIMER16_Device *const dev = timer_get_device(tim_idx);
+
+    const uint8_t key = irq_lock();
+    ll_timer16_stop(dev);
+    ll_timer_clear_enable_int_mask(tim_idx);
+    captures[tim_idx] = NULL;
+    irq_unlock(key);
+}
+
+int16_t timer_capture_read(struct timer_capture *cap,
+                           uint32_t *ts,
+                           uint8_t count,
+                           k_timeout_t timeout)
+{
+    if (!z_user(cap && ts))
+        return -EINVAL;
+
+    while ((uint8_t)(cap->head - cap->tail) < cap->batch) {
+        if (k_sem_take(&cap->sem, timeout) != 0) {
+            return -EAGAIN;
+        }
+    }
+
+    uint8_t n = MIN(count, (uint8_t)(cap->head - cap->tail));
+    if (cap->flags & TIMER_CAPTURE_BOTH) {
+        /* Each edge is stored by its own interrupt, the falling edge of the
+         * last pair may not be captured yet: only complete pairs are read */
+        n &= ~1u;
+    }
+
+    const uint8_t mask = cap->size - 1u;
+    for (uint8_t i = 0u; i < n; i++) {
+        ts[i] = cap->buf[(uint8_t)(cap->tail + i) & mask];
+    }
+
+    /* Single byte write, the slots are released to the interrupt */
+    cap->tail += n;
+
+    return n;
+}
+
+int8_t timer_capture_measure(const struct timer_capture *cap,
+                             const uint32_t *ts,
+                             uint8_t count,
+                             struct timer_capture_measure *m)
+{
+    if (!z_user(cap && ts && m))
+        return -EINVAL;
+
+    if (cap->flags & TIMER_CAPTURE_BOTH) {
+        /* Rising edges at even indexes, the last pair gives the high time
+         * only */
+        if (count < 4u)
+            return -EINVAL;
+
+        const uint8_t periods = (count >> 1u) - 1u;
+        uint32_t high         = 0u;
+
+        for (uint8_t i = 0u; i < (periods << 1u); i += 2u) {
+            high += ts[i + 1u] - ts[i];
+        }
+
+        m->period = (ts[periods << 1u] - ts[0u]) / periods;
+        m->high   = high / periods;
+    } else {
+        if (count < 2u)
+            return -EINVAL;
+
+        m->period = (ts[count - 1u] - ts[0u]) / (count - 1u);
+        m->high   = 0u;
+    }
+
+    return 0;
+}
+
+static uint16_t timer_capture_prescaler_value(uint8_t prescaler)
+{
+    static const uint16_t values[] = {1u, 8u, 64u, 256u, 1024u};
+
+    return values[prescaler - TIMER_PRESCALER_1];
+}
+
+uint32_t timer_capture_frequency_mhz(const struct timer_capture *cap, uint32_t period)
+{
+    if (period == 0u)
+        return 0u;
+
+    const uint64_t clock =
+        (uint64_t)F_CPU * 1000u / timer_capture_prescaler_value(cap->prescaler);
+
+    return (uint32_t)(clock / period);
+}
+
+__always_inline void timer_capture_isr(uint8_t tim_idx, struct timer_capture *cap)
+{
+    TIMER16_Device *const dev = timer_get_device(tim_idx);
+    struct k_thread *thread   = NULL;
+
+    const uint16_t icr = ll_timer16_get_icr(dev);
+    uint16_t overflows = cap->overflows;
+
+    /* The overflow interrupt has a lower priority, an overflow pending
+     * before a capture in the first half of the counter is accounted here */
+    if ((TIFRn[tim_idx] & BIT(TOVn)) && (icr < 0x8000u)) {
+        overflows++;
+    }
+
+    const uint8_t free = cap->size - (uint8_t)(cap->head - cap->tail);
+
+    if (cap->flags & TIMER_CAPTURE_BOTH) {
+        const bool rising = dev->TCCRnB & BIT(ICESn);
+
+        dev->TCCRnB ^= BIT(ICESn);
+        /* Changing the edge may trigger a capture */
+        TIFRn[tim_idx] = BIT(ICFn);
+
+        if (rising) {
+            /* Room for the whole pair */
+            cap->skip = free < 2u;
+        }
+
+        if (cap->skip) {
+            cap->dropped++;
+            return;
+        }
+    } else if (free == 0u) {
+        cap->dropped++;
+        return;
+    }
+
+    cap->buf[cap->head & (cap->size - 1u)] = ((uint32_t)overflows << 16u) | icr;
+    cap->head++;
+
+    if (++cap->pending >= cap->batch) {
+        cap->pending = 0u;
+        thread       = k_sem_give(&cap->sem);
+    }
+
+    k_yield_from_isr_cond(thread);
+}
+
+#define Z_TIMER_CAPTURE_ISRS(_n)                                                         \
+    ISR(TIMER##_n##_CAPT_vect)                                                           \
+    {                                                                                    \
+        timer_capture_isr(_n, captures[_n]);                                             \
+    }                                                                                    \
+                                                                                         \
+    ISR(TIMER##_n##_OVF_vect)                                                            \
+    {                                                                                    \
+        captures[_n]->overflows++;                                                       \
+    }
+
+#if (CONFIG_TIMER_CAPTURE_MASK & BIT(1)) && defined(TIMER1_DEVICE)
+Z_TIMER_CAPTURE_ISRS(1)
+#endif
+#if (CONFIG_TIMER_CAPTURE_MASK & BIT(3)) && defined(TIMER3_DEVICE)
+Z_TIMER_CAPTURE_ISRS(3)
+#endif
+#if (CONFIG_TIMER_CAPTURE_MASK & BIT(4)) && defined(TIMER4_DEVICE)
+Z_TIMER_CAPTURE_ISRS(4)
+#endif
+#if (CONFIG_TIMER_CAPTURE_MASK & BIT(5)) && defined(TIMER5_DEVICE)
+Z_TIMER_CAPTURE_ISRS(5)
+#endif
+
+#endif /* CONFIG_TIMER_CAPTURE_MASK */
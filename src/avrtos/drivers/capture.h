@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AVRTOS_DRIVERS_CAPTURE_H_
+#define _AVRTOS_DRIVERS_CAPTURE_H_
+
+#include <avrtos/drivers/timer.h>
+#include <avrtos/kernel.h>
+#include <avrtos/semaphore.h>
+
+/**
+ * Input capture driver (16 bits timers)
+ *
+ * The timer runs in normal mode and the value of the counter is latched by
+ * the hardware on the edges of the ICPn pin. The driver handles
+ * TIMERn_CAPT_vect and TIMERn_OVF_vect for the timers selected with
+ * CONFIG_TIMER_CAPTURE_MASK: the captures are extended to 32 bits with the
+ * number of overflows and stored in a ring buffer. The thread is woken up once
+ * a batch of captures is available.
+ *
+ * With TIMER_CAPTURE_BOTH, the edge is toggled after each capture, the
+ * buffer contains (rising, falling) pairs of timestamps, a pair is dropped
+ * entirely if the buffer is full.
+ *
+ * Example Usage:
+ *
+ *   static uint32_t buf[16u];
+ *   static struct timer_capture cap = {.buf = buf, .size = 16u, .batch = 8u};
+ *   struct timer_capture_measure m;
+ *   uint32_t ts[8u];
+ *
+ *   timer_capture_start(1u, &cap, TIMER_PRESCALER_8, TIMER_CAPTURE_BOTH);
+ *
+ *   int16_t n = timer_capture_read(&cap, ts, 8u, K_FOREVER);
+ *   timer_capture_measure(&cap, ts, n, &m);
+ *   // frequency: timer_capture_frequency_mhz(&cap, m.period) / 1000 Hz
+ *   // duty: m.high * 100 / m.period %
+ *
+ * Limitations:
+ * - The timer cannot be used for anything else meanwhile, it must not be the
+ *   kernel sysclock timer (CONFIG_KERNEL_SYSLOCK_HW_TIMER).
+ * - Edges closer than the interrupt latency are lost (TIMER_CAPTURE_BOTH).
+ * - A measure over timestamps read after dropped captures is wrong, the
+ *   "dropped" counter of the context must be checked.
+ *
+ * Related configuration options:
+ *  - CONFIG_TIMER_CAPTURE_MASK: Timers handled by the driver
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Capture flags */
+#define TIMER_CAPTURE_RISING          0u      /**< Capture the rising edges */
+#define TIMER_CAPTURE_FALLING         BIT(0u) /**< Capture the falling edges */
+#define TIMER_CAPTURE_BOTH            BIT(1u) /**< Capture both edges, by pairs */
+#define TIMER_CAPTURE_NOISE_CANCELLER BIT(2u) /**< 4 samples input filter */
+
+/**
+ * @brief Input capture context.
+ *
+ * The buffer, its size and the batch are set by the user, the other members
+ * are private.
+ */
+struct timer_capture {
+    uint32_t *buf; ///< Ring buffer of timestamps
+    uint8_t size;  ///< Size of the buffer, power of 2 (at most 128)
+    uint8_t batch; ///< Captures waking up the thread (even with TIMER_CAPTURE_BOTH)
+
+    uint8_t tim_idx;
+    uint8_t flags;
+    uint8_t prescaler;
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    uint8_t pending;
+    uint8_t skip;
+    uint16_t overflows;
+    volatile uint16_t dropped; ///< Number of captures dropped (buffer full)
+    struct k_sem sem;
+};
+
+/**
+ * @brief Period and high time computed from a batch of captures, in timer
+ * ticks.
+ */
+struct timer_capture_measure {
+    uint32_t period; ///< Mean period
+    uint32_t high;   ///< Mean high time (TIMER_CAPTURE_BOTH only)
+};
+
+/**
+ * @brief Start capturing on a 16 bits timer.
+ *
+ * @param tim_idx Timer index, its bit must be set in CONFIG_TIMER_CAPTURE_MASK.
+ * @param cap Capture context, with its buffer, size and batch set.
+ * @param prescaler Timer prescaler (resolution of the timestamps).
+ * @param flags Edge (TIMER_CAPTURE_RISING, _FALLING or _BOTH) and options.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * timer is not handled by the driver, -EBUSY if the timer is capturing.
+ */
+int8_t timer_capture_start(uint8_t tim_idx,
+                           struct timer_capture *cap,
+                           timer_prescaler_t prescaler,
+                           uint8_t flags);
+
+/**
+ * @brief Stop capturing, the timer is stopped.
+ *
+ * @param tim_idx Timer index.
+ */
+void timer_capture_stop(uint8_t tim_idx);
+
+/**
+ * @brief Wait for a batch of captures and read them.
+ *
+ * With TIMER_CAPTURE_BOTH, an even number of timestamps is read, starting
+ * with a rising edge.
+ *
+ * @param cap Capture context.
+ * @param ts Timestamps read.
+ * @param count Maximum number of timestamps read.
+ * @param timeout Time to wait for the batch.
+ * @return Number of timestamps read, -EAGAIN on timeout.
+ */
+int16_t timer_capture_read(struct timer_capture *cap,
+                           uint32_t *ts,
+                           uint8_t count,
+                           k_timeout_t timeout);
+
+/**
+ * @brief Compute the mean period (and high time) of consecutive captures.
+ *
+ * @param cap Capture context the timestamps were read from.
+ * @param ts Timestamps.
+ * @param count Number of timestamps.
+ * @param m Measure to fill.
+ * @return 0 on success, -EINVAL if there are not enough timestamps.
+ */
+int8_t timer_capture_measure(const struct timer_capture *cap,
+                             const uint32_t *ts,
+                             uint8_t count,
+                             struct timer_capture_measure *m);
+
+/**
+ * @brief Convert a period in timer ticks to a frequency.
+ *
+ * @param cap Capture context.
+ * @param period Period in ticks of the timer.
+ * @return Frequency in mHz, 0 if the period is 0.
+ */
+uint32_t timer_capture_frequency_mhz(const struct timer_capture *cap, uint32_t period);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _AVRTOS_DRIVERS_CAPTURE_H_ */
@@ -6,6 +6,8 @@
 
 #include "exti.h"
 
+#include <avrtos/systime.h>
+
 int8_t exti_configure(uint8_t exti, uint8_t isc)
 {
     if (!z_user(exti < EXTI_COUNT))
@@ -23,4 +25,353 @@ int8_t exti_configure(uint8_t exti, uint8_t isc)
     EXTI_CTRL_DEVICE->EICRn[regn] = (eicrn & ~group_mask) | (isc << (group << 1u));
 
     return 0;
-}
\ No newline at end of file
+}
+
+#if CONFIG_EXTI_DISPATCH_EXTI_MASK || CONFIG_EXTI_DISPATCH_PCI_MASK
+
+#define EXTI_LINE_SRC_INT BIT(7u)
+
+/* Registered lines, tables of a disabled mask are optimized out */
+static struct exti_line *exti_lines[EXTI_COUNT];
+static struct exti_line *pci_lines[PCI_COUNT];
+
+/* Previous state of the ports, to find the pins which changed */
+static uint8_t pci_state[PCI_GROUPS_COUNT];
+
+static uint8_t pci_group_read(uint8_t group)
+{
+#if defined(__AVR_ATmega2560__)
+    switch (group) {
+    case PCINT_0_7:
+        return PINB;
+    case PCINT_8_15:
+        /* PCINT8 is PE0, PCINT9-15 are PJ0-6 */
+        return (uint8_t)(PINJ << 1u) | (PINE & BIT(PE0));
+    default:
+        return PINK;
+    }
+#else
+    switch (group) {
+    case PCINT_0_7:
+        return PINB;
+    case PCINT_8_15:
+        return PINC;
+    default:
+        return PIND;
+    }
+#endif
+}
+
+static uint8_t exti_pin_read(uint8_t exti)
+{
+#if defined(__AVR_ATmega2560__)
+    /* INT0-3 are PD0-3, INT4-7 are PE4-7 */
+    return ((exti < 4u ? PIND : PINE) >> exti) & 1u;
+#else
+    /* INT0-1 are PD2-3 */
+    return (PIND >> (exti + 2u)) & 1u;
+#endif
+}
+
+static uint8_t exti_line_read(struct exti_line *line)
+{
+    if (line->src & EXTI_LINE_SRC_INT) {
+        return exti_pin_read(line->src & ~EXTI_LINE_SRC_INT);
+    } else {
+        return (pci_group_read(line->src >> 3u) >> (line->src & 0x07u)) & 1u;
+    }
+}
+
+/**
+ * @brief Notify the change of level of a line.
+ *
+ * @return true if a thread was woken up.
+ */
+static bool exti_line_notify(struct exti_line *line, uint8_t level)
+{
+    bool woken = false;
+
+    line->level = level;
+
+    if (!(line->trigger & (level ? EXTI_TRIG_RISING : EXTI_TRIG_FALLING))) {
+        return false;
+    }
+
+    if (line->handler) {
+        line->handler(line, level);
+    }
+
+    if (line->sem) {
+        woken = k_sem_give(line->sem) != NULL;
+    }
+
+    if (line->flags) {
+        woken |= k_flags_notify(line->flags, line->flags_mask, K_FLAGS_SET) > 0;
+    }
+
+    return woken;
+}
+
+#if CONFIG_KERNEL_EVENTS
+static void exti_line_debounced(struct k_event *event)
+{
+    struct exti_line *const line = CONTAINER_OF(event, struct exti_line, event);
+    const uint8_t level          = exti_line_read(line);
+
+    /* Bounces back to the previous level are ignored */
+    if (level != line->level) {
+        exti_line_notify(line, level);
+    }
+}
+#endif
+
+/**
+ * @brief Handle an edge of a line, from its interrupt.
+ *
+ * @return true if a thread was woken up.
+ */
+static bool exti_line_edge(struct exti_line *line, uint8_t level)
+{
+#if CONFIG_KERNEL_EVENTS
+    if (line->debounce != 0u) {
+#if CONFIG_KERNEL_TICKS_COUNTER
+        if (!k_event_pending(&line->event)) {
+            line->timestamp = k_ticks_get_32();
+        }
+#endif
+
+        /* Every bounce restarts the delay */
+        k_event_cancel(&line->event);
+        k_event_schedule(&line->event, K_TICKS(line->debounce));
+        return false;
+    }
+#endif
+
+#if CONFIG_KERNEL_TICKS_COUNTER
+    line->timestamp = k_ticks_get_32();
+#endif
+
+    return exti_line_notify(line, level);
+}
+
+static int8_t exti_line_init(struct exti_line *line,
+                             uint8_t src,
+                             uint8_t trigger,
+                             k_timeout_t debounce)
+{
+    if (!z_user(line && (trigger & EXTI_TRIG_BOTH)))
+        return -EINVAL;
+
+    line->debounce = K_TIMEOUT_TICKS(debounce);
+    line->trigger  = trigger;
+    line->src      = src;
+
+    if (line->debounce != 0u) {
+#if CONFIG_KERNEL_EVENTS
+        k_event_init(&line->event, exti_line_debounced);
+#else
+        return -ENOTSUP;
+#endif
+    }
+
+    line->level = exti_line_read(line);
+#if CONFIG_KERNEL_TICKS_COUNTER
+    line->timestamp = 0u;
+#endif
+
+    return 0;
+}
+
+int8_t exti_line_register(uint8_t exti,
+                          struct exti_line *line,
+                          uint8_t trigger,
+                          k_timeout_t debounce)
+{
+    if (!z_user(exti < EXTI_COUNT))
+        return -EINVAL;
+
+    if (!(CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(exti)))
+        return -ENOTSUP;
+
+    int8_t ret = exti_line_init(line, exti | EXTI_LINE_SRC_INT, trigger, debounce);
+    if (ret != 0)
+        return ret;
+
+    const uint8_t key = irq_lock();
+    if (exti_lines[exti] != NULL) {
+        ret = -EBUSY;
+    } else {
+        exti_lines[exti] = line;
+        exti_configure(exti, ISC_EDGE);
+        exti_clear_flag(exti);
+        exti_enable(exti);
+    }
+    irq_unlock(key);
+
+    return ret;
+}
+
+int8_t exti_line_unregister(uint8_t exti)
+{
+    if (!z_user(exti < EXTI_COUNT))
+        return -EINVAL;
+
+    if (!(CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(exti)))
+        return -ENOTSUP;
+
+    const uint8_t key = irq_lock();
+    exti_disable(exti);
+    if (exti_lines[exti] != NULL) {
+#if CONFIG_KERNEL_EVENTS
+        /* The event is only initialized for a debounced line */
+        if (exti_lines[exti]->debounce != 0u) {
+            k_event_cancel(&exti_lines[exti]->event);
+        }
+#endif
+        exti_lines[exti] = NULL;
+    }
+    irq_unlock(key);
+
+    return 0;
+}
+
+#if CONFIG_EXTI_DISPATCH_EXTI_MASK
+static bool exti_dispatch(uint8_t exti)
+{
+    struct exti_line *const line = exti_lines[exti];
+
+    if (line == NULL) {
+        return false;
+    }
+
+    return exti_line_edge(line, exti_pin_read(exti));
+}
+#endif /* CONFIG_EXTI_DISPATCH_EXTI_MASK */
+
+int8_t pci_line_register(uint8_t pci,
+                         struct exti_line *line,
+                         uint8_t trigger,
+                         k_timeout_t debounce)
+{
+    if (!z_user(pci < PCI_COUNT))
+        return -EINVAL;
+
+    const uint8_t group = pci >> 3u;
+    const uint8_t bit   = BIT(pci & 0x07u);
+
+    if (!(CONFIG_EXTI_DISPATCH_PCI_MASK & BIT(group)))
+        return -ENOTSUP;
+
+    int8_t ret = exti_line_init(line, pci, trigger, debounce);
+    if (ret != 0)
+        return ret;
+
+    const uint8_t key = irq_lock();
+    if (pci_lines[pci] != NULL) {
+        ret = -EBUSY;
+    } else {
+        pci_lines[pci] = line;
+
+        /* Only the state of this pin is refreshed, changes of the other pins
+         * of the group may be pending */
+        pci_state[group] = (pci_state[group] & ~bit) | (pci_group_read(group) & bit);
+
+        pci_pin_enable(pci);
+        if (!(PCICR & BIT(group))) {
+            pci_clear_flag(group);
+            pci_enable(group);
+        }
+    }
+    irq_unlock(key);
+
+    return ret;
+}
+
+int8_t pci_line_unregister(uint8_t pci)
+{
+    if (!z_user(pci < PCI_COUNT))
+        return -EINVAL;
+
+    if (!(CONFIG_EXTI_DISPATCH_PCI_MASK & BIT(pci >> 3u)))
+        return -ENOTSUP;
+
+    const uint8_t key = irq_lock();
+    pci_pin_disable(pci);
+    if (pci_lines[pci] != NULL) {
+#if CONFIG_KERNEL_EVENTS
+        /* The event is only initialized for a debounced line */
+        if (pci_lines[pci]->debounce != 0u) {
+            k_event_cancel(&pci_lines[pci]->event);
+        }
+#endif
+        pci_lines[pci] = NULL;
+    }
+    irq_unlock(key);
+
+    return 0;
+}
+
+#if CONFIG_EXTI_DISPATCH_PCI_MASK
+static bool pci_dispatch(uint8_t group)
+{
+    struct exti_line **lines = &pci_lines[group << 3u];
+    const uint8_t state      = pci_group_read(group);
+    uint8_t changed          = (state ^ pci_state[group]) & PCI_CTRL_DEVICE->PCMSK[group];
+    bool woken               = false;
+
+    pci_state[group] = state;
+
+    for (uint8_t line = 0u; changed != 0u; line++, changed >>= 1u) {
+        if ((changed & 1u) && (lines[line] != NULL)) {
+            woken |= exti_line_edge(lines[line], (state >> line) & 1u);
+        }
+    }
+
+    return woken;
+}
+#endif /* CONFIG_EXTI_DISPATCH_PCI_MASK */
+
+#define Z_EXTI_DISPATCH_ISR(_vect, _dispatch, _n)                                        \
+    ISR(_vect)                                                                           \
+    {                                                                                    \
+        if (_dispatch(_n)) {                                                             \
+            k_yield_from_isr();                                                          \
+        }                                                                                \
+    }
+
+#if CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(0)
+Z_EXTI_DISPATCH_ISR(INT0_vect, exti_dispatch, 0u)
+#endif
+#if CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(1)
+Z_EXTI_DISPATCH_ISR(INT1_vect, exti_dispatch, 1u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(2)) && defined(INT2_vect)
+Z_EXTI_DISPATCH_ISR(INT2_vect, exti_dispatch, 2u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(3)) && defined(INT3_vect)
+Z_EXTI_DISPATCH_ISR(INT3_vect, exti_dispatch, 3u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(4)) && defined(INT4_vect)
+Z_EXTI_DISPATCH_ISR(INT4_vect, exti_dispatch, 4u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(5)) && defined(INT5_vect)
+Z_EXTI_DISPATCH_ISR(INT5_vect, exti_dispatch, 5u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(6)) && defined(INT6_vect)
+Z_EXTI_DISPATCH_ISR(INT6_vect, exti_dispatch, 6u)
+#endif
+#if (CONFIG_EXTI_DISPATCH_EXTI_MASK & BIT(7)) && defined(INT7_vect)
+Z_EXTI_DISPATCH_ISR(INT7_vect, exti_dispatch, 7u)
+#endif
+
+#if CONFIG_EXTI_DISPATCH_PCI_MASK & BIT(0)
+Z_EXTI_DISPATCH_ISR(PCINT0_vect, pci_dispatch, PCINT_0_7)
+#endif
+#if CONFIG_EXTI_DISPATCH_PCI_MASK & BIT(1)
+Z_EXTI_DISPATCH_ISR(PCINT1_vect, pci_dispatch, PCINT_8_15)
+#endif
+#if CONFIG_EXTI_DISPATCH_PCI_MASK & BIT(2)
+Z_EXTI_DISPATCH_ISR(PCINT2_vect, pci_dispatch, PCINT_16_23)
+#endif
+
+#endif /* CONFIG_EXTI_DISPATCH_EXTI_MASK || CONFIG_EXTI_DISPATCH_PCI_MASK */
@@ -8,7 +8,10 @@
 #define _AVRTOS_DRIVERS_EXTI_H_
 
 #include <avrtos/drivers.h>
+#include <avrtos/event.h>
+#include <avrtos/flags.h>
 #include <avrtos/kernel.h>
+#include <avrtos/semaphore.h>
 
 /**
  * @brief Definitions for External Interrupt (EXTI) and Pin Change Interrupt (PCI)
@@ -277,6 +280,137 @@ __always_inline void pci_disable(uint8_t group)
     PCICR &= ~BIT(group);
 }
 
+/*
+ * EXTI/PCI dispatch
+ *
+ * The driver owns the interrupt vectors selected with
+ * CONFIG_EXTI_DISPATCH_EXTI_MASK and CONFIG_EXTI_DISPATCH_PCI_MASK, and
+ * dispatches the edges of the registered pins (struct exti_line). For the pin
+ * change interrupts, the pins which changed in the group are found by comparing
+ * the port to its previous state.
+ *
+ * On each edge (selected by the trigger of the line), the callback is called,
+ * the semaphore is given and the flags are notified. With a debouncing delay,
+ * every edge restarts a k_event and the line is notified from the tick
+ * interrupt if the level of the pin changed once the delay elapsed.
+ *
+ * Example Usage:
+ *
+ *   K_FLAGS_DEFINE(keys, 0u);
+ *   static struct exti_line key0 = {.flags = &keys, .flags_mask = BIT(0)};
+ *
+ *   pci_line_register(PCINT0, &key0, EXTI_TRIG_FALLING, K_MSEC(20));
+ *
+ *   // in a thread
+ *   k_flags_value_t mask = BIT(0);
+ *   k_flags_poll(&keys, &mask, K_FLAGS_SET_ANY | K_FLAGS_CONSUME, K_FOREVER);
+ *
+ * Limitations:
+ * - External interrupts are configured to trigger on any edge.
+ * - Two edges of a pin change faster than the interrupt latency are missed.
+ * - Debouncing delays are in ticks, the debounced level is sampled once.
+ *
+ * Related configuration options:
+ *  - CONFIG_EXTI_DISPATCH_EXTI_MASK: INTn vectors handled by the driver
+ *  - CONFIG_EXTI_DISPATCH_PCI_MASK: PCINTn vectors handled by the driver
+ *  - CONFIG_KERNEL_EVENTS: Required for debouncing
+ *  - CONFIG_KERNEL_UPTIME: Required for the edges timestamps
+ */
+
+/* Edges notified by a line */
+#define EXTI_TRIG_RISING  BIT(0) /**< Notify the rising edges */
+#define EXTI_TRIG_FALLING BIT(1) /**< Notify the falling edges */
+#define EXTI_TRIG_BOTH    (EXTI_TRIG_RISING | EXTI_TRIG_FALLING)
+
+struct exti_line;
+
+/**
+ * @brief Line callback, called from the interrupt (or from the tick interrupt
+ * if the line is debounced).
+ *
+ * @param line Line which changed.
+ * @param level New level of the pin.
+ */
+typedef void (*exti_handler_t)(struct exti_line *line, uint8_t level);
+
+/**
+ * @brief Pin registered to the dispatch layer.
+ *
+ * The callback, semaphore and flags are optional and set by the user before
+ * the registration, the other members are set by the driver.
+ */
+struct exti_line {
+    exti_handler_t handler;     ///< Callback, optional
+    struct k_sem *sem;          ///< Semaphore given on each edge, optional
+    struct k_flags *flags;      ///< Flags notified on each edge, optional
+    k_flags_value_t flags_mask; ///< Bits set in the flags
+
+    k_ticks_t debounce; ///< Debouncing delay (0: disabled)
+    uint8_t trigger;    ///< Notified edges (EXTI_TRIG_*)
+    uint8_t level;      ///< Last notified level of the pin
+    uint8_t src;        ///< INTn or PCINTn number (private)
+#if CONFIG_KERNEL_TICKS_COUNTER
+    uint32_t timestamp; ///< Time (in ticks) of the first edge of the last change
+#endif
+#if CONFIG_KERNEL_EVENTS
+    struct k_event event; ///< Debouncing event (private)
+#endif
+};
+
+/**
+ * @brief Register a line on an external interrupt and enable the interrupt.
+ *
+ * The interrupt is configured to trigger on any edge.
+ *
+ * @param exti EXTI number (e.g. INT0).
+ * @param line Line, with its callback, semaphore or flags set.
+ * @param trigger Notified edges (EXTI_TRIG_RISING, EXTI_TRIG_FALLING or both).
+ * @param debounce Debouncing delay, K_NO_WAIT to disable.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * vector is not handled by the driver or debouncing is not supported, -EBUSY
+ * if a line is already registered.
+ */
+int8_t exti_line_register(uint8_t exti,
+                          struct exti_line *line,
+                          uint8_t trigger,
+                          k_timeout_t debounce);
+
+/**
+ * @brief Disable an external interrupt and unregister its line.
+ *
+ * @param exti EXTI number.
+ * @return 0 on success, -EINVAL if the EXTI number is invalid, -ENOTSUP if the
+ * vector is not handled by the driver.
+ */
+int8_t exti_line_unregister(uint8_t exti);
+
+/**
+ * @brief Register a line on a pin change interrupt and enable the interrupt.
+ *
+ * @param pci Pin change interrupt number (e.g. PCINT17).
+ * @param line Line, with its callback, semaphore or flags set.
+ * @param trigger Notified edges (EXTI_TRIG_RISING, EXTI_TRIG_FALLING or both).
+ * @param debounce Debouncing delay, K_NO_WAIT to disable.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * vector is not handled by the driver or debouncing is not supported, -EBUSY
+ * if a line is already registered.
+ */
+int8_t pci_line_register(uint8_t pci,
+                         struct exti_line *line,
+                         uint8_t trigger,
+                         k_timeout_t debounce);
+
+/**
+ * @brief Disable a pin change interrupt and unregister its line.
+ *
+ * The interrupt of the group remains enabled.
+ *
+ * @param pci Pin change interrupt number.
+ * @return 0 on success, -EINVAL if the number is invalid, -ENOTSUP if the
+ * vector is not handled by the driver.
+ */
+int8_t pci_line_unregister(uint8_t pci);
+
 #if defined(__cplusplus)
 }
 #endif
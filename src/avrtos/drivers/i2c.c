@@ -11,6 +11,8 @@
 #include <avrtos/misc/serial.h>
 #include <avrtos/semaphore.h>
 
+#include <string.h>
+
 #include <avr/eeprom.h>
 #include <util/twi.h>
 
@@ -20,6 +22,10 @@
 #error "No I2C device enabled"
 #endif
 
+#if CONFIG_I2C_QUEUE && !CONFIG_I2C_INTERRUPT_DRIVEN
+#error "CONFIG_I2C_QUEUE requires CONFIG_I2C_INTERRUPT_DRIVEN"
+#endif
+
 #if defined(I2C0_DEVICE) && CONFIG_I2C0_ENABLED
 #define I2C0_DEVICE_ENABLED 1
 #define I2C0_INDEX          0
@@ -84,6 +90,18 @@ struct i2c_context {
 #if CONFIG_I2C_LAST_ERROR
     i2c_error_t error;
 #endif // CONFIG_I2C_LAST_ERROR
+
+#if CONFIG_I2C_QUEUE
+    /* Pending transactions */
+    struct slist queue;
+
+    /* Current transaction, message and position in the message (or probed
+     * address offset for a scan) */
+    struct i2c_xfer *xfer;
+    const struct i2c_msg *msg;
+    uint8_t msg_left;
+    uint16_t pos;
+#endif // CONFIG_I2C_QUEUE
 };
 
 #if CONFIG_I2C_LAST_ERROR
@@ -183,6 +201,11 @@ int8_t i2c_init(I2C_Device *dev, struct i2c_config config)
     // set internal pullups on SDA, SCL
     i2c_gpio_setup(dev_index, true);
 
+#if CONFIG_I2C_QUEUE
+    slist_init(&i2c_contexts[dev_index].queue);
+    i2c_contexts[dev_index].xfer = NULL;
+#endif
+
     dev->TWCRn                    = BIT(TWINT) | BIT(TWEN); // Enable device and interrupt
     i2c_contexts[dev_index].state = READY;
 
@@ -323,9 +346,290 @@ __always_inline void i2c_state_machine_loop(I2C_Device *dev, struct i2c_context
     } while (x->state != READY);
 }
 
+#if CONFIG_I2C_QUEUE
+static void xfer_start(struct i2c_context *x, struct i2c_xfer *xfer)
+{
+    x->xfer     = xfer;
+    x->msg      = xfer->msgs;
+    x->msg_left = xfer->count - 1u;
+    x->pos      = 0u;
+}
+
+/* Whether the next message continues the current transfer (same direction,
+ * no repeated start) */
+static bool msg_continues(struct i2c_context *x)
+{
+    const struct i2c_msg *const next = x->msg + 1u;
+
+    return (x->msg_left != 0u) && !(next->flags & I2C_MSG_RESTART) &&
+           ((next->flags & I2C_MSG_READ) == (x->msg->flags & I2C_MSG_READ));
+}
+
+static void msg_next(struct i2c_context *x)
+{
+    x->msg++;
+    x->msg_left--;
+    x->pos = 0u;
+}
+
+/* Whether the byte to be received is not the last one of the transfer */
+static bool read_ack(struct i2c_context *x)
+{
+    const uint16_t left = x->msg->len - x->pos;
+
+    return (left > 1u) || ((left == 1u) && msg_continues(x));
+}
+
+/* Returns the thread woken up by the completion, if any */
+static struct k_thread *
+xfer_complete(I2C_Device *dev, struct i2c_context *x, i2c_error_t error)
+{
+    struct i2c_xfer *const xfer = x->xfer;
+
+    xfer->error = error;
+    if (error != I2C_ERROR_NONE) {
+        xfer->status = -EIO;
+        if (xfer->errors != UINT8_MAX) {
+            xfer->errors++;
+        }
+    } else {
+        xfer->status = 0;
+    }
+    set_error(x, error);
+
+    struct snode *const next = slist_get(&x->queue);
+    if (next != NULL) {
+        /* Stop then start the next transaction */
+        xfer_start(x, CONTAINER_OF(next, struct i2c_xfer, _tie));
+        TWI_RESET(dev);
+    } else {
+        x->xfer = NULL;
+        transfer_stop(dev, x);
+    }
+
+    if (xfer->done != NULL) {
+        return k_sem_give(xfer->done);
+    }
+
+    return NULL;
+}
+
+static struct k_thread *scan_next(I2C_Device *dev, struct i2c_context *x)
+{
+    if (++x->pos < x->msg->len) {
+        /* Stop then probe the next address */
+        TWI_RESET(dev);
+        return NULL;
+    } else {
+        return xfer_complete(dev, x, I2C_ERROR_NONE);
+    }
+}
+
+/* Returns the thread woken up by the completion of a transaction, if any */
+static struct k_thread *i2c_queue_state_machine(I2C_Device *dev, struct i2c_context *x)
+{
+    const uint8_t status    = dev->TWSRn & TW_STATUS_MASK;
+    const bool scan         = x->xfer->flags & I2C_XFER_SCAN;
+    struct k_thread *thread = NULL;
+
+#if CONFIG_I2C_DEBUG
+    serial_hex(status);
+    serial_print("\n");
+#endif
+
+    switch (status) {
+    case TW_START: // Start condition transmitted
+    case TW_REP_START:
+        if (scan) {
+            dev->TWDRn = ((x->xfer->addr + x->pos) << 1) | TW_WRITE;
+        } else {
+            dev->TWDRn = (x->xfer->addr << 1) |
+                         ((x->msg->flags & I2C_MSG_READ) ? TW_READ : TW_WRITE);
+        }
+        TWI_REPLY(dev, 1u);
+        break;
+
+    case TW_MT_SLA_ACK: // SLA+W transmitted, ACK received
+        if (scan) {
+            const uint8_t addr = x->xfer->addr + x->pos;
+            x->msg->buf[addr >> 3u] |= BIT(addr & 7u);
+            thread = scan_next(dev, x);
+            break;
+        }
+        __fallthrough;
+    case TW_MT_DATA_ACK: // Data transmitted, ACK received
+        /* Skip the exhausted messages of the transfer */
+        while ((x->pos == x->msg->len) && msg_continues(x)) {
+            msg_next(x);
+        }
+
+        if (x->pos < x->msg->len) {
+            dev->TWDRn = x->msg->buf[x->pos++];
+            TWI_REPLY(dev, 1u);
+        } else if (x->msg_left != 0u) {
+            msg_next(x);
+            TWI_START(dev); /* Trigger a repeated start */
+        } else {
+            thread = xfer_complete(dev, x, I2C_ERROR_NONE);
+        }
+        break;
+
+    case TW_MR_DATA_ACK: // Data received, ACK returned
+        x->msg->buf[x->pos++] = dev->TWDRn;
+        if (x->pos == x->msg->len) {
+            /* The transfer continues as the byte was acknowledged */
+            msg_next(x);
+        }
+        __fallthrough;
+    case TW_MR_SLA_ACK: // SLA+R transmitted, ACK received
+        /* ACK if more data is expected (NACK otherwise) */
+        TWI_REPLY(dev, read_ack(x));
+        break;
+
+    case TW_MR_DATA_NACK: // Data received, NACK returned
+        x->msg->buf[x->pos++] = dev->TWDRn;
+        if (x->msg_left != 0u) {
+            msg_next(x);
+            TWI_START(dev); /* Trigger a repeated start */
+        } else {
+            thread = xfer_complete(dev, x, I2C_ERROR_NONE);
+        }
+        break;
+
+    case TW_MT_SLA_NACK: // SLA+W transmitted, NACK received
+        if (scan) {
+            thread = scan_next(dev, x);
+        } else {
+            thread = xfer_complete(dev, x, I2C_ERROR_ADDR);
+        }
+        break;
+
+    case TW_MT_DATA_NACK: // Data transmitted, NACK received
+        thread = xfer_complete(dev, x, I2C_ERROR_DATA);
+        break;
+
+    case TW_MR_SLA_NACK: // SLA+R transmitted, NACK received
+        thread = xfer_complete(dev, x, I2C_ERROR_ADDR);
+        break;
+
+    case TW_MT_ARB_LOST:
+        /* Restart the transaction once the bus is free */
+        xfer_start(x, x->xfer);
+        TWI_START(dev);
+        break;
+
+    // fatal
+    case TW_NO_INFO:
+    case TW_BUS_ERROR:
+    default:
+        thread = xfer_complete(dev, x, I2C_ERROR_BUS);
+        break;
+    }
+
+    return thread;
+}
+
+int8_t i2c_submit(I2C_Device *dev, struct i2c_xfer *xfer)
+{
+    struct i2c_context *const x = i2c_get_context(dev);
+
+    if (!z_user(x && xfer && xfer->msgs && (xfer->count != 0u)))
+        return -EINVAL;
+    if (x->state == UNINITIALIZED)
+        return -EINVAL;
+
+    if (xfer->flags & I2C_XFER_SCAN) {
+        const struct i2c_msg *const msg = &xfer->msgs[0u];
+        if (!z_user(msg->buf && (msg->len != 0u) &&
+                    ((uint16_t)xfer->addr + msg->len - 1u <= 0x7Fu)))
+            return -EINVAL;
+        memset(msg->buf, 0x00u, ((xfer->addr + msg->len - 1u) >> 3u) + 1u);
+    } else {
+        for (uint8_t i = 0u; i < xfer->count; i++) {
+            const struct i2c_msg *const msg = &xfer->msgs[i];
+            if (!z_user(msg->buf &&
+                        ((msg->len != 0u) || !(msg->flags & I2C_MSG_READ))))
+                return -EINVAL;
+        }
+    }
+
+    int8_t ret        = 0;
+    const uint8_t key = irq_lock();
+
+    if (xfer->status == -EINPROGRESS) {
+        ret = -EBUSY;
+    } else {
+        xfer->status = -EINPROGRESS;
+        if (x->xfer == NULL) {
+            xfer_start(x, xfer);
+            x->state = MASTER_TX;
+            TWI_START(dev);
+        } else {
+            slist_append(&x->queue, &xfer->_tie);
+        }
+    }
+
+    irq_unlock(key);
+
+    return ret;
+}
+
+int8_t i2c_transfer(I2C_Device *dev,
+                    uint8_t addr,
+                    const struct i2c_msg *msgs,
+                    uint8_t count)
+{
+    struct k_sem done;
+    struct i2c_xfer xfer = I2C_XFER_INIT(addr, msgs, count, &done);
+
+    k_sem_init(&done, 0u, 1u);
+
+    const int8_t ret = i2c_submit(dev, &xfer);
+    if (ret != 0)
+        return ret;
+
+    k_sem_take(&done, K_FOREVER);
+
+    return xfer.status;
+}
+
+int8_t i2c_scan(I2C_Device *dev, uint8_t bitmap[16u])
+{
+    struct k_sem done;
+    const struct i2c_msg msg = {.buf = bitmap, .len = 0x78u - 0x08u, .flags = 0u};
+    struct i2c_xfer xfer     = I2C_XFER_INIT(0x08u, &msg, 1u, &done);
+
+    xfer.flags = I2C_XFER_SCAN;
+    k_sem_init(&done, 0u, 1u);
+
+    const int8_t ret = i2c_submit(dev, &xfer);
+    if (ret != 0)
+        return ret;
+
+    k_sem_take(&done, K_FOREVER);
+
+    return xfer.status;
+}
+#endif // CONFIG_I2C_QUEUE
+
 static int8_t
 i2c_run(I2C_Device *dev, uint8_t addr, uint8_t *data, uint8_t w_len, uint8_t r_len)
 {
+#if CONFIG_I2C_QUEUE
+    struct i2c_msg msgs[2u];
+    uint8_t count = 0u;
+
+    if ((w_len != 0u) || (r_len == 0u)) {
+        msgs[count++] =
+            (struct i2c_msg){.buf = data, .len = w_len, .flags = I2C_MSG_WRITE};
+    }
+    if (r_len != 0u) {
+        msgs[count++] =
+            (struct i2c_msg){.buf = data, .len = r_len, .flags = I2C_MSG_READ};
+    }
+
+    return i2c_transfer(dev, addr, msgs, count);
+#else
     struct i2c_context *const x = i2c_get_context(dev);
 
     if (!z_user(x && data && (w_len <= I2C_MAX_BUF_LEN) && (r_len <= I2C_MAX_BUF_LEN)))
@@ -373,6 +677,7 @@ i2c_run(I2C_Device *dev, uint8_t addr, uint8_t *data, uint8_t w_len, uint8_t r_l
 #endif
 
     return 0;
+#endif // CONFIG_I2C_QUEUE
 }
 
 int8_t i2c_master_write(I2C_Device *dev, uint8_t addr, const uint8_t *data, uint8_t len)
@@ -437,14 +742,26 @@ int8_t i2c_calc_config(struct i2c_config *config, uint32_t desired_freq)
 #if I2C0_DEVICE_ENABLED
 ISR(TWI0_vect)
 {
+#if CONFIG_I2C_QUEUE
+    struct k_thread *const thread =
+        i2c_queue_state_machine(I2C0_DEVICE, &i2c_contexts[I2C0_INDEX]);
+    k_yield_from_isr_cond(thread);
+#else
     i2c_state_machine(I2C0_DEVICE, &i2c_contexts[I2C0_INDEX]);
+#endif
 }
 #endif // I2C0_DEVICE_ENABLED
 
 #if I2C1_DEVICE_ENABLED
 ISR(TWI1_vect)
 {
-    i2c_state_machine(I2C0_DEVICE, &i2c_contexts[I2C1_INDEX]);
+#if CONFIG_I2C_QUEUE
+    struct k_thread *const thread =
+        i2c_queue_state_machine(I2C1_DEVICE, &i2c_contexts[I2C1_INDEX]);
+    k_yield_from_isr_cond(thread);
+#else
+    i2c_state_machine(I2C1_DEVICE, &i2c_contexts[I2C1_INDEX]);
+#endif
 }
 #endif // I2C1_DEVICE_ENABLED
 #endif // CONFIG_I2C_INTERRUPT_DRIVEN
@@ -8,12 +8,45 @@
 #define _AVRTOS_DRIVERS_I2C_H_
 
 #include <avrtos/drivers.h>
+#include <avrtos/dstruct/slist.h>
 #include <avrtos/kernel.h>
+#include <avrtos/semaphore.h>
 
 #include "i2c_defs.h"
 
 /**
  * I2C driver
+ *
+ * Transaction queue (CONFIG_I2C_QUEUE):
+ *
+ * A transaction (struct i2c_xfer) is a sequence of messages exchanged with a
+ * device. Consecutive messages in the same direction are sent as a single
+ * transfer (e.g. a register address followed by a data buffer), unless the
+ * second one has the I2C_MSG_RESTART flag. A repeated start is generated when
+ * the direction changes and a stop after the last message.
+ *
+ * Transactions are queued with i2c_submit() and processed back-to-back from
+ * the TWI interrupt, the submitting thread can sleep on the semaphore of the
+ * transaction (k_sem_take() or k_poll()) in the meantime.
+ *
+ * Example Usage:
+ *
+ *   K_SEM_DEFINE(cycle_done, 0, 1);
+ *
+ *   uint8_t reg = 0x00u;
+ *   uint8_t temp[2u];
+ *   struct i2c_msg msgs[] = {
+ *       {.buf = &reg, .len = 1u, .flags = I2C_MSG_WRITE},
+ *       {.buf = temp, .len = 2u, .flags = I2C_MSG_READ},
+ *   };
+ *   struct i2c_xfer xfer = I2C_XFER_INIT(0x48, msgs, 2u, &cycle_done);
+ *
+ *   i2c_submit(I2C0, &xfer);
+ *   k_sem_take(&cycle_done, K_FOREVER);
+ *   if (xfer.status == 0) { ... }
+ *
+ * To wait for a batch of transactions, only the last one needs a semaphore as
+ * transactions of a bus are processed in order.
  */
 
 #if defined(__cplusplus)
@@ -220,6 +253,99 @@ i2c_error_t i2c_last_error(I2C_Device *dev);
  */
 int8_t i2c_calc_config(struct i2c_config *config, uint32_t desired_freq);
 
+/* Message is read from the device (written otherwise) */
+#define I2C_MSG_WRITE   0x00u
+#define I2C_MSG_READ    0x01u
+/* Generate a repeated start before the message, even if the direction of the
+ * previous message is the same */
+#define I2C_MSG_RESTART 0x02u
+
+/* Transaction is a bus scan: the addresses from addr to addr + msgs[0].len - 1
+ * (at most 0x7F) are probed, the ones which acknowledged are set in the bitmap
+ * msgs[0].buf, indexed by address: ((addr + len - 1) / 8 + 1) bytes, cleared
+ * by i2c_submit() */
+#define I2C_XFER_SCAN 0x01u
+
+/**
+ * @brief I2C message
+ */
+struct i2c_msg {
+    uint8_t *buf;  ///< Data buffer
+    uint16_t len;  ///< Buffer length, cannot be 0 for a read
+    uint8_t flags; ///< I2C_MSG_* flags
+};
+
+/**
+ * @brief I2C transaction
+ */
+struct i2c_xfer {
+    struct snode _tie;          ///< Queue node (private)
+    const struct i2c_msg *msgs; ///< Messages of the transaction
+    uint8_t count;              ///< Number of messages
+    uint8_t addr;               ///< 7-bit device address
+    uint8_t flags;              ///< I2C_XFER_* flags
+    struct k_sem *done;         ///< Semaphore given on completion (optional)
+
+    /* Status of the last run: 0 on success, -EINPROGRESS while queued or
+     * running, -EIO on error */
+    volatile int8_t status;
+    i2c_error_t error; ///< Error of the last run
+    uint8_t errors;    ///< Number of failed runs (saturated at 255)
+};
+
+#define I2C_XFER_INIT(_addr, _msgs, _count, _done)                                       \
+    {                                                                                    \
+        ._tie = SNODE_INIT(), .msgs = _msgs, .count = _count, .addr = _addr,             \
+        .flags = 0u, .done = _done, .status = 0, .error = I2C_ERROR_NONE, .errors = 0u,  \
+    }
+
+/**
+ * @brief Queue a transaction
+ *
+ * The transaction starts immediately if the bus is idle. The transaction and
+ * its messages must remain valid until its completion, which is signalled by
+ * giving its semaphore (if any).
+ *
+ * Requires CONFIG_I2C_QUEUE.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param dev I2C device
+ * @param xfer Transaction to queue
+ * @return int8_t 0 if success, -EINVAL if the device or the transaction is
+ * invalid, -EBUSY if the transaction is already queued
+ */
+int8_t i2c_submit(I2C_Device *dev, struct i2c_xfer *xfer);
+
+/**
+ * @brief Run a transaction and sleep until its completion
+ *
+ * Requires CONFIG_I2C_QUEUE.
+ *
+ * @param dev I2C device
+ * @param addr 7-bit device address
+ * @param msgs Messages of the transaction
+ * @param count Number of messages
+ * @return int8_t 0 if success, negative value otherwise
+ */
+int8_t i2c_transfer(I2C_Device *dev,
+                    uint8_t addr,
+                    const struct i2c_msg *msgs,
+                    uint8_t count);
+
+/**
+ * @brief Probe all the addresses (0x08 to 0x77) of a bus in a single
+ * transaction and sleep until its completion
+ *
+ * Requires CONFIG_I2C_QUEUE.
+ *
+ * @param dev I2C device
+ * @param bitmap Bitmap of 16 bytes, the bit of each device which acknowledged
+ * its address is set (bitmap[addr >> 3] & BIT(addr & 7))
+ * @return int8_t 0 if success, negative value otherwise
+ */
+int8_t i2c_scan(I2C_Device *dev, uint8_t bitmap[16u]);
+
 #if defined(__cplusplus)
 }
 #endif
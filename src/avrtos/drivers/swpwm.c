@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "swpwm.h"
+
+#include <string.h>
+
+#if CONFIG_SWPWM
+
+#if !TIMER_INDEX_IS_16BITS(CONFIG_SWPWM_TIMER)
+#error "CONFIG_SWPWM_TIMER must be a 16 bits timer"
+#endif
+
+#if CONFIG_SWPWM_TIMER == CONFIG_KERNEL_SYSLOCK_HW_TIMER
+#error "CONFIG_SWPWM_TIMER is the sysclock timer"
+#endif
+
+#define SWPWM_DEVICE ((TIMER16_Device *)timer_get_device(CONFIG_SWPWM_TIMER))
+#define SWPWM_VECT   _CONCAT(_CONCAT(TIMER, CONFIG_SWPWM_TIMER), _COMPA_vect)
+
+/**
+ * @brief Edge of the schedule: masks of the pins written by a compare match.
+ */
+struct swpwm_step {
+    uint16_t time;
+    uint8_t masks[CONFIG_SWPWM_PORTS];
+};
+
+/**
+ * @brief Schedule of a period, the first step (at 0) sets the channels with a
+ * non-zero duty cycle, the next ones clear the channels in duty cycle order.
+ */
+struct swpwm_schedule {
+    uint8_t count;
+    uint8_t all[CONFIG_SWPWM_PORTS]; /* Pins of all the channels */
+    struct swpwm_step steps[CONFIG_SWPWM_CHANNELS + 1u];
+};
+
+struct swpwm_channel {
+    uint8_t port;
+    uint8_t mask;
+    uint16_t duty;
+};
+
+static struct {
+    GPIO_Device *ports[CONFIG_SWPWM_PORTS];
+    struct swpwm_channel channels[CONFIG_SWPWM_CHANNELS];
+    struct swpwm_schedule schedules[2u];
+
+    uint16_t top;
+    uint8_t prescaler;
+    uint8_t ports_count;
+    uint8_t channels_count;
+
+    /* Interrupt state */
+    uint8_t active;
+    volatile uint8_t pending;
+    uint8_t step;
+    uint16_t busy;
+    volatile uint16_t load;
+} swpwm;
+
+int8_t swpwm_init(uint32_t period_us)
+{
+    uint16_t counter;
+
+    const int8_t prescaler =
+        timer_calc_prescaler(CONFIG_SWPWM_TIMER, period_us, &counter);
+    if (prescaler < 0)
+        return prescaler;
+
+    swpwm_stop();
+
+    swpwm.top            = counter;
+    swpwm.prescaler      = prescaler;
+    swpwm.ports_count    = 0u;
+    swpwm.channels_count = 0u;
+    swpwm.active         = 0u;
+    swpwm.pending        = 0u;
+    swpwm.step           = 0u;
+    swpwm.busy           = 0u;
+    swpwm.load           = 0u;
+
+    /* Empty schedules: a single step at 0 */
+    swpwm.schedules[0u].count = 1u;
+    swpwm.schedules[1u].count = 1u;
+    memset(swpwm.schedules[0u].steps[0u].masks, 0u, CONFIG_SWPWM_PORTS);
+    memset(swpwm.schedules[0u].all, 0u, CONFIG_SWPWM_PORTS);
+    swpwm.schedules[0u].steps[0u].time = 0u;
+
+    const struct timer_config cfg = {
+        .mode      = TIMER_MODE_CTC_ICRn,
+        .prescaler = 0u, /* stopped */
+        .counter   = 0u,
+        .timsk     = BIT(OCIEnA),
+    };
+
+    ll_timer16_init(SWPWM_DEVICE, CONFIG_SWPWM_TIMER, &cfg);
+    ll_timer16_write_reg16(&SWPWM_DEVICE->IRCN, counter);
+    ll_timer16_write_reg16(&SWPWM_DEVICE->OCRnA, 0u);
+    ll_timer16_counter_reset(SWPWM_DEVICE);
+
+    return 0;
+}
+
+int8_t swpwm_channel_add(GPIO_Device *gpio, uint8_t pin)
+{
+    if (!z_user(gpio && (pin < 8u)))
+        return -EINVAL;
+
+    if (swpwm.channels_count == CONFIG_SWPWM_CHANNELS)
+        return -ENOMEM;
+
+    uint8_t port;
+    for (port = 0u; port < swpwm.ports_count; port++) {
+        if (swpwm.ports[port] == gpio) {
+            break;
+        }
+    }
+
+    if (port == swpwm.ports_count) {
+        if (port == CONFIG_SWPWM_PORTS)
+            return -ENOMEM;
+
+        swpwm.ports[port] = gpio;
+        swpwm.ports_count++;
+    }
+
+    struct swpwm_channel *const ch = &swpwm.channels[swpwm.channels_count];
+    ch->port                       = port;
+    ch->mask                       = BIT(pin);
+    ch->duty                       = 0u;
+
+    gpiol_pin_init(gpio, pin, GPIO_OUTPUT, GPIO_OUTPUT_DRIVEN_LOW);
+
+    return swpwm.channels_count++;
+}
+
+int8_t swpwm_set(uint8_t channel, uint16_t duty)
+{
+    if (!z_user(channel < swpwm.channels_count))
+        return -EINVAL;
+
+    swpwm.channels[channel].duty = duty;
+
+    return 0;
+}
+
+/**
+ * @brief Time of the falling edge of a channel, 0 if the channel is never
+ * set, top + 1 if it is never cleared.
+ */
+static uint16_t swpwm_edge_time(uint16_t duty)
+{
+    if (duty == SWPWM_DUTY_MAX) {
+        return swpwm.top + 1u;
+    }
+
+    return ((uint32_t)duty * (swpwm.top + 1u)) >> 16u;
+}
+
+static void swpwm_build(struct swpwm_schedule *sched)
+{
+    uint8_t order[CONFIG_SWPWM_CHANNELS];
+    uint16_t times[CONFIG_SWPWM_CHANNELS];
+    uint8_t count = 0u;
+
+    memset(sched->all, 0u, CONFIG_SWPWM_PORTS);
+    memset(sched->steps[0u].masks, 0u, CONFIG_SWPWM_PORTS);
+    sched->steps[0u].time = 0u;
+    sched->count          = 1u;
+
+    for (uint8_t i = 0u; i < swpwm.channels_count; i++) {
+        const struct swpwm_channel *const ch = &swpwm.channels[i];
+        const uint16_t time                  = swpwm_edge_time(ch->duty);
+
+        sched->all[ch->port] |= ch->mask;
+
+        if (time == 0u) {
+            continue;
+        }
+
+        sched->steps[0u].masks[ch->port] |= ch->mask;
+
+        if (time > swpwm.top) {
+            continue;
+        }
+
+        /* Insertion sort of the falling edges */
+        uint8_t j = count++;
+        while ((j != 0u) && (times[j - 1u] > time)) {
+            times[j] = times[j - 1u];
+            order[j] = order[j - 1u];
+            j--;
+        }
+        times[j] = time;
+        order[j] = i;
+    }
+
+    for (uint8_t i = 0u; i < count; i++) {
+        const struct swpwm_channel *const ch = &swpwm.channels[order[i]];
+        struct swpwm_step *step              = &sched->steps[sched->count - 1u];
+
+        /* Channels with the same duty cycle are cleared together */
+        if ((sched->count == 1u) || (step->time != times[i])) {
+            step = &sched->steps[sched->count++];
+            memset(step->masks, 0u, CONFIG_SWPWM_PORTS);
+            step->time = times[i];
+        }
+
+        step->masks[ch->port] |= ch->mask;
+    }
+}
+
+void swpwm_update(void)
+{
+    /* Once the pending flag is cleared, the interrupt does not swap the
+     * schedules anymore and the inactive one can be written */
+    const uint8_t key = irq_lock();
+    swpwm.pending     = 0u;
+    const uint8_t idx = swpwm.active ^ 1u;
+    irq_unlock(key);
+
+    swpwm_build(&swpwm.schedules[idx]);
+
+    swpwm.pending = 1u;
+}
+
+void swpwm_start(void)
+{
+    ll_timer16_start(SWPWM_DEVICE, swpwm.prescaler);
+}
+
+void swpwm_stop(void)
+{
+    ll_timer16_stop(SWPWM_DEVICE);
+}
+
+uint16_t swpwm_load(void)
+{
+    const uint8_t key   = irq_lock();
+    const uint16_t busy = swpwm.load;
+    irq_unlock(key);
+
+    return ((uint32_t)busy * 1000u) / ((uint32_t)swpwm.top + 1u);
+}
+
+ISR(SWPWM_VECT)
+{
+    TIMER16_Device *const dev    = SWPWM_DEVICE;
+    struct swpwm_schedule *sched = &swpwm.schedules[swpwm.active];
+    uint8_t step                 = swpwm.step;
+    const uint16_t scheduled     = sched->steps[step].time;
+
+    if (step == 0u) {
+        /* Beginning of the period */
+        if (swpwm.pending) {
+            swpwm.active ^= 1u;
+            swpwm.pending = 0u;
+            sched         = &swpwm.schedules[swpwm.active];
+        }
+
+        swpwm.load = swpwm.busy;
+        swpwm.busy = 0u;
+
+        for (uint8_t p = 0u; p < swpwm.ports_count; p++) {
+            GPIO_Device *const gpio = swpwm.ports[p];
+            gpio->PORT = (gpio->PORT & ~sched->all[p]) | sched->steps[0u].masks[p];
+        }
+
+        step = 1u;
+    }
+
+    for (;;) {
+        /* Handle the edges which are due */
+        while ((step < sched->count) &&
+               (sched->steps[step].time <= ll_timer16_get_tcnt(dev))) {
+            for (uint8_t p = 0u; p < swpwm.ports_count; p++) {
+                swpwm.ports[p]->PORT &= ~sched->steps[step].masks[p];
+            }
+            step++;
+        }
+
+        if (step == sched->count) {
+            /* Next period */
+            step = 0u;
+            ll_timer16_write_reg16(&dev->OCRnA, 0u);
+            break;
+        }
+
+        ll_timer16_write_reg16(&dev->OCRnA, sched->steps[step].time);
+
+        /* The edge may have been reached in the meantime */
+        if (sched->steps[step].time > ll_timer16_get_tcnt(dev)) {
+            break;
+        }
+    }
+
+    swpwm.step = step;
+    swpwm.busy += ll_timer16_get_tcnt(dev) - scheduled;
+}
+
+#endif /* CONFIG_SWPWM */
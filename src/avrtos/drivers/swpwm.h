@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AVRTOS_DRIVERS_SWPWM_H_
+#define _AVRTOS_DRIVERS_SWPWM_H_
+
+#include <avrtos/drivers/gpio.h>
+#include <avrtos/drivers/timer.h>
+#include <avrtos/kernel.h>
+
+/**
+ * Software PWM
+ *
+ * Generates up to CONFIG_SWPWM_CHANNELS PWM outputs on any GPIO pins with a
+ * single 16 bits timer (CONFIG_SWPWM_TIMER) in CTC mode, whose period is the
+ * PWM period.
+ *
+ * The channels are sorted by duty cycle into a schedule of edges: all the
+ * channels are set at the beginning of the period, then the channels with the
+ * same duty cycle are cleared together by a single compare match interrupt,
+ * which writes precomputed masks to the PORT registers (one read-modify-write
+ * per port). Edges closer than the duration of the interrupt are handled by
+ * the same interrupt.
+ *
+ * Duty cycles are staged with swpwm_set() and applied with swpwm_update(),
+ * which builds the schedule in a second buffer, swapped at the beginning of
+ * the next period (no glitch).
+ *
+ * Example Usage:
+ *
+ *   swpwm_init(20000u); // 50Hz (servos)
+ *   int8_t ch = swpwm_channel_add(GPIOB, 4u);
+ *
+ *   swpwm_set(ch, SWPWM_DUTY_MAX / 20u); // 1ms
+ *   swpwm_update();
+ *   swpwm_start();
+ *
+ *   printf("load %u/1000\n", swpwm_load());
+ *
+ * Limitations:
+ * - Other pins of the ports used by the channels must be written with
+ *   interrupts disabled, as the interrupt writes the whole PORT registers.
+ * - The duty cycles are quantized to the timer ticks, and edges closer than
+ *   the duration of the interrupt are delayed.
+ *
+ * Related configuration options:
+ *  - CONFIG_SWPWM: Enable the software PWM
+ *  - CONFIG_SWPWM_TIMER: 16 bits timer used
+ *  - CONFIG_SWPWM_CHANNELS: Maximum number of channels
+ *  - CONFIG_SWPWM_PORTS: Maximum number of GPIO ports used by the channels
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Duty cycle of a channel always set, SWPWM_DUTY_MAX / 2 is 50% */
+#define SWPWM_DUTY_MAX 0xFFFFu
+
+/**
+ * @brief Configure the timer with the PWM period, the channels are removed.
+ *
+ * @param period_us PWM period in microseconds.
+ * @return 0 on success, -ENOTSUP if the period cannot be configured.
+ */
+int8_t swpwm_init(uint32_t period_us);
+
+/**
+ * @brief Add a channel, its pin is configured as an output (low) with a duty
+ * cycle of 0.
+ *
+ * @param gpio GPIO port of the pin.
+ * @param pin Pin number (0-7).
+ * @return Channel number, -EINVAL if an argument is invalid, -ENOMEM if the
+ * maximum number of channels or ports is reached.
+ */
+int8_t swpwm_channel_add(GPIO_Device *gpio, uint8_t pin);
+
+/**
+ * @brief Stage the duty cycle of a channel, applied by swpwm_update().
+ *
+ * @param channel Channel number.
+ * @param duty Duty cycle, from 0 (always low) to SWPWM_DUTY_MAX (always high).
+ * @return 0 on success, -EINVAL if the channel is invalid.
+ */
+int8_t swpwm_set(uint8_t channel, uint16_t duty);
+
+/**
+ * @brief Apply the staged duty cycles at the beginning of the next period.
+ *
+ * Calling this function again before the beginning of the next period
+ * replaces the pending schedule.
+ */
+void swpwm_update(void);
+
+/**
+ * @brief Start the timer.
+ */
+void swpwm_start(void);
+
+/**
+ * @brief Stop the timer, the pins keep their current level.
+ */
+void swpwm_stop(void);
+
+/**
+ * @brief Get the CPU load of the last period, time spent in the interrupt
+ * (from the compare match to the end of the handler).
+ *
+ * @return Load in permille.
+ */
+uint16_t swpwm_load(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _AVRTOS_DRIVERS_SWPWM_H_ */
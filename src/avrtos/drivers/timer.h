@@ -459,6 +459,16 @@ __always_inline uint16_t ll_timer16_get_tcnt(TIMER16_Device *dev)
     return (lh << 8) | ll;
 }
 
+__always_inline uint16_t ll_timer16_get_icr(TIMER16_Device *dev)
+{
+    /**
+     * For a 16-bit read, the low byte must be read before the high byte.
+     */
+    uint16_t ll = dev->ICRnL;
+    uint16_t lh = dev->ICRnH;
+    return (lh << 8) | ll;
+}
+
 __always_inline void ll_timer16_stop(TIMER16_Device *dev)
 {
     /* timer stops counting at the timer prescaler is set to zero */
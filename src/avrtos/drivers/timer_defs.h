@@ -60,6 +60,11 @@
 #define ICNCn ICNC1
 #define ICESn ICES1
 
+/* Interrupt flag register */
+#define TOVn  TOV1
+#define OCFnA OCF1A
+#define ICFn  ICF1
+
 /* macros */
 #if defined(TCCR5A)
 #define TIMERS_COUNT 6
@@ -180,46 +180,127 @@ int8_t usart_send(UART_Device *dev, const char *buf, size_t len)
 
 #if DRIVERS_UART_ASYNC
 
-// size should be configurable
-static struct usart_async_context usart_async_contexts[ARCH_USART_COUNT];
+/* Contexts are only allocated for the enabled USARTs */
+#define USART0_ASYNC_INDEX 0
+#define USART1_ASYNC_INDEX (USART0_ASYNC_INDEX + CONFIG_DRIVERS_USART0_ASYNC)
+#define USART2_ASYNC_INDEX (USART1_ASYNC_INDEX + CONFIG_DRIVERS_USART1_ASYNC)
+#define USART3_ASYNC_INDEX (USART2_ASYNC_INDEX + CONFIG_DRIVERS_USART2_ASYNC)
+#define USART_ASYNC_COUNT  (USART3_ASYNC_INDEX + CONFIG_DRIVERS_USART3_ASYNC)
+
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+/* The semaphores are initialized once, a thread may be waiting on them
+ * whenever a transfer is started */
+#define Z_USART_ASYNC_SEM_INIT(_n, _sem)                                                 \
+    Z_SEM_INIT(usart_async_contexts[USART##_n##_ASYNC_INDEX]._sem, 0u, 1u)
+
+#define Z_USART_ASYNC_CONTEXT_INIT(_n)                                                   \
+    [USART##_n##_ASYNC_INDEX] = {                                                        \
+        .rx_sem = Z_USART_ASYNC_SEM_INIT(_n, rx_sem),                                    \
+        .tx_sem = Z_USART_ASYNC_SEM_INIT(_n, tx_sem),                                    \
+    },
+
+static struct usart_async_context usart_async_contexts[USART_ASYNC_COUNT] = {
+#if CONFIG_DRIVERS_USART0_ASYNC
+    Z_USART_ASYNC_CONTEXT_INIT(0)
+#endif
+#if CONFIG_DRIVERS_USART1_ASYNC
+    Z_USART_ASYNC_CONTEXT_INIT(1)
+#endif
+#if CONFIG_DRIVERS_USART2_ASYNC
+    Z_USART_ASYNC_CONTEXT_INIT(2)
+#endif
+#if CONFIG_DRIVERS_USART3_ASYNC
+    Z_USART_ASYNC_CONTEXT_INIT(3)
+#endif
+};
+#else
+static struct usart_async_context usart_async_contexts[USART_ASYNC_COUNT];
+#endif
 
-__always_inline static struct usart_async_context *
-usart_get_async_context(UART_Device *dev)
+static struct usart_async_context *usart_get_async_context(UART_Device *dev)
 {
-    return &usart_async_contexts[AVR_USARTn_INDEX(dev)];
+#if CONFIG_DRIVERS_USART0_ASYNC
+    if (dev == USART0_DEVICE)
+        return &usart_async_contexts[USART0_ASYNC_INDEX];
+#endif
+#if CONFIG_DRIVERS_USART1_ASYNC
+    if (dev == USART1_DEVICE)
+        return &usart_async_contexts[USART1_ASYNC_INDEX];
+#endif
+#if CONFIG_DRIVERS_USART2_ASYNC
+    if (dev == USART2_DEVICE)
+        return &usart_async_contexts[USART2_ASYNC_INDEX];
+#endif
+#if CONFIG_DRIVERS_USART3_ASYNC
+    if (dev == USART3_DEVICE)
+        return &usart_async_contexts[USART3_ASYNC_INDEX];
+#endif
+    return NULL;
 }
 
-static void rx_interrupt(UART_Device *dev)
+static void async_complete(UART_Device *dev,
+                           struct usart_async_context *ctx,
+                           usart_event_t evt)
 {
-    const char chr                  = dev->UDRn;
-    struct usart_async_context *ctx = usart_get_async_context(dev);
+    if (ctx->callback != NULL) {
+        ctx->evt = evt;
+        ctx->callback(dev, ctx);
+    }
 
-    ctx->rx.buf[ctx->rx.cur++] = chr;
-    if (ctx->rx.cur == ctx->rx.size) {
-        __ASSERT_FALSE(ctx->callback == NULL);
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+    struct k_thread *thread;
 
-        ctx->evt = USART_EVENT_RX_COMPLETE;
-        ctx->callback(dev, ctx);
-        ctx->rx.cur = 0u;
+    if (evt == USART_EVENT_RX_COMPLETE) {
+        if (ctx->rx.pending && (ctx->rx.dropped < INT8_MAX)) {
+            ctx->rx.dropped++;
+        }
+        ctx->rx.pending = 1u;
+        thread          = k_sem_give(&ctx->rx_sem);
+    } else {
+        thread = k_sem_give(&ctx->tx_sem);
     }
+
+    k_yield_from_isr_cond(thread);
+#endif
 }
 
-static void tx_interrupt(UART_Device *dev)
+static void rx_interrupt(UART_Device *dev, struct usart_async_context *ctx)
 {
-    struct usart_async_context *ctx = usart_get_async_context(dev);
+    ctx->rx.buf[ctx->rx.cur++] = dev->UDRn;
 
-    if (ctx->tx.cur == ctx->tx.size) {
-        __ASSERT_FALSE(ctx->callback == NULL);
+    if (ctx->rx.cur == ctx->rx.size) {
+        /* Switch to the other buffer before reporting the completed one, the
+         * next bytes are received in the meantime */
+        uint8_t *const done = ctx->rx.buf;
 
-        ctx->evt = USART_EVENT_TX_COMPLETE;
-        ctx->callback(dev, ctx);
+        ctx->rx.buf  = ctx->rx.next;
+        ctx->rx.next = done;
+        ctx->rx.done = done;
+        ctx->rx.cur  = 0u;
+
+        async_complete(dev, ctx, USART_EVENT_RX_COMPLETE);
+    }
+}
+
+static void tx_interrupt(UART_Device *dev, struct usart_async_context *ctx)
+{
+    if ((ctx->tx.cur == ctx->tx.size) && (ctx->tx.segs == 0u)) {
+        /* Marked as completed before waking up the thread */
         ctx->tx.size = 0U;
+        async_complete(dev, ctx, USART_EVENT_TX_COMPLETE);
     }
 }
 
-static void udre_interrupt(UART_Device *dev)
+static void udre_interrupt(UART_Device *dev, struct usart_async_context *ctx)
 {
-    struct usart_async_context *ctx = usart_get_async_context(dev);
+    /* move to the next non empty segment */
+    while ((ctx->tx.cur == ctx->tx.size) && (ctx->tx.segs != 0u)) {
+        ctx->tx.buf  = (const uint8_t *)ctx->tx.seg->buf;
+        ctx->tx.size = ctx->tx.seg->len;
+        ctx->tx.cur  = 0u;
+        ctx->tx.seg++;
+        ctx->tx.segs--;
+    }
 
     /* if there are more data to send */
     if (ctx->tx.cur < ctx->tx.size) {
@@ -229,124 +310,204 @@ static void udre_interrupt(UART_Device *dev)
     }
 }
 
-#if CONFIG_DRIVERS_USART0_ASYNC
-ISR(USART0_RX_vect)
-{
-    rx_interrupt(USART0_DEVICE);
-}
-
-ISR(USART0_TX_vect)
-{
-    tx_interrupt(USART0_DEVICE);
-}
+#define Z_USART_ASYNC_ISRS(_n)                                                           \
+    ISR(USART##_n##_RX_vect)                                                             \
+    {                                                                                    \
+        rx_interrupt(USART##_n##_DEVICE,                                                 \
+                     &usart_async_contexts[USART##_n##_ASYNC_INDEX]);                    \
+    }                                                                                    \
+                                                                                         \
+    ISR(USART##_n##_TX_vect)                                                             \
+    {                                                                                    \
+        tx_interrupt(USART##_n##_DEVICE,                                                 \
+                     &usart_async_contexts[USART##_n##_ASYNC_INDEX]);                    \
+    }                                                                                    \
+                                                                                         \
+    ISR(USART##_n##_UDRE_vect)                                                           \
+    {                                                                                    \
+        udre_interrupt(USART##_n##_DEVICE,                                               \
+                       &usart_async_contexts[USART##_n##_ASYNC_INDEX]);                  \
+    }
 
-ISR(USART0_UDRE_vect)
-{
-    udre_interrupt(USART0_DEVICE);
-}
+#if CONFIG_DRIVERS_USART0_ASYNC
+Z_USART_ASYNC_ISRS(0)
 #endif /* CONFIG_DRIVERS_USART0_ASYNC */
 
 #if CONFIG_DRIVERS_USART1_ASYNC
-ISR(USART1_RX_vect)
-{
-    rx_interrupt(USART1_DEVICE);
-}
-
-ISR(USART1_TX_vect)
-{
-    tx_interrupt(USART1_DEVICE);
-}
-
-ISR(USART1_UDRE_vect)
-{
-    udre_interrupt(USART1_DEVICE);
-}
+Z_USART_ASYNC_ISRS(1)
 #endif /* CONFIG_DRIVERS_USART1_ASYNC */
 
 #if CONFIG_DRIVERS_USART2_ASYNC
-ISR(USART2_RX_vect)
-{
-    rx_interrupt(USART2_DEVICE);
-}
+Z_USART_ASYNC_ISRS(2)
+#endif /* CONFIG_DRIVERS_USART2_ASYNC */
 
-ISR(USART2_TX_vect)
+#if CONFIG_DRIVERS_USART3_ASYNC
+Z_USART_ASYNC_ISRS(3)
+#endif /* CONFIG_DRIVERS_USART3_ASYNC */
+
+int8_t usart_set_callback(UART_Device *dev, usart_async_callback_t cb)
 {
-    tx_interrupt(USART2_DEVICE);
+    if (!z_user(dev))
+        return -EINVAL;
+
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
+
+    ctx->callback = cb;
+
+    return 0;
 }
 
-ISR(USART2_UDRE_vect)
+int8_t usart_rx_enable_double(UART_Device *dev, void *buf0, void *buf1, size_t size)
 {
-    udre_interrupt(USART2_DEVICE);
+    if (!z_user(dev && buf0 && buf1 && size))
+        return -EINVAL;
+
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
+
+    const uint8_t key = irq_lock();
+
+    ctx->rx.buf  = (uint8_t *)buf0;
+    ctx->rx.next = (uint8_t *)buf1;
+    ctx->rx.done = NULL;
+    ctx->rx.size = size;
+    ctx->rx.cur  = 0U;
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+    ctx->rx.pending = 0u;
+    ctx->rx.dropped = 0u;
+#endif
+
+    /* enable receiver */
+    SET_BIT(dev->UCSRnB, BIT(RXENn) | BIT(RXCIEn));
+
+    irq_unlock(key);
+
+    return 0;
 }
-#endif /* CONFIG_DRIVERS_USART2_ASYNC */
 
-#if CONFIG_DRIVERS_USART3_ASYNC
-ISR(USART3_RX_vect)
+int8_t usart_rx_enable(UART_Device *dev, void *buf, size_t size)
 {
-    rx_interrupt(USART3_DEVICE);
+    return usart_rx_enable_double(dev, buf, buf, size);
 }
 
-ISR(USART3_TX_vect)
+int8_t usart_rx_disable(UART_Device *dev)
 {
-    tx_interrupt(USART3_DEVICE);
+    if (dev == NULL) {
+        return -EINVAL;
+    }
+
+    /* disable receiver */
+    CLR_BIT(dev->UCSRnB, BIT(RXENn));
+
+    return 0;
 }
 
-ISR(USART3_UDRE_vect)
+static void tx_start(UART_Device *dev,
+                     struct usart_async_context *ctx,
+                     const void *buf,
+                     size_t size,
+                     const struct usart_tx_seg *segs,
+                     uint8_t count)
 {
-    udre_interrupt(USART3_DEVICE);
+    const uint8_t key = irq_lock();
+
+    ctx->tx.buf  = (const uint8_t *)buf;
+    ctx->tx.size = size;
+    ctx->tx.cur  = 0U;
+    ctx->tx.seg  = segs;
+    ctx->tx.segs = count;
+
+    /* enable transmitter */
+    SET_BIT(dev->UCSRnB, BIT(TXENn) | BIT(UDRIEn) | BIT(TXCIEn));
+
+    irq_unlock(key);
 }
-#endif /* CONFIG_DRIVERS_USART3_ASYNC */
 
-int8_t usart_set_callback(UART_Device *dev, usart_async_callback_t cb)
+int8_t usart_tx(UART_Device *dev, const void *buf, size_t size)
 {
     if (!z_user(dev))
         return -EINVAL;
 
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].callback = cb;
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
+
+    tx_start(dev, ctx, buf, size, NULL, 0u);
 
     return 0;
 }
 
-int8_t usart_rx_enable(UART_Device *dev, void *buf, size_t size)
+int8_t usart_tx_sg(UART_Device *dev, const struct usart_tx_seg *segs, uint8_t count)
 {
-    if (!z_user(dev))
+    if (!z_user(dev && segs))
         return -EINVAL;
 
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].rx.buf  = (uint8_t *)buf;
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].rx.size = size;
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].rx.cur  = 0U;
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
 
-    /* enable receiver */
-    SET_BIT(dev->UCSRnB, BIT(RXENn) | BIT(RXCIEn));
+    /* Nothing would be sent, the completion would never be reported */
+    uint8_t i;
+    for (i = 0u; (i < count) && (segs[i].len == 0u); i++)
+        ;
+    if (i == count)
+        return -EINVAL;
+
+    tx_start(dev, ctx, NULL, 0u, segs, count);
 
     return 0;
 }
 
-int8_t usart_rx_disable(UART_Device *dev)
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+
+int8_t usart_rx_wait(UART_Device *dev, void **buf, k_timeout_t timeout)
 {
-    if (dev == NULL) {
+    if (!z_user(dev && buf))
         return -EINVAL;
+
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
+
+    /* The semaphore may have been given before the reception was enabled */
+    while (!ctx->rx.pending) {
+        if (k_sem_take(&ctx->rx_sem, timeout) != 0) {
+            return -EAGAIN;
+        }
     }
 
-    /* disable receiver */
-    CLR_BIT(dev->UCSRnB, BIT(RXENn));
+    const uint8_t key    = irq_lock();
+    const int8_t dropped = (int8_t)ctx->rx.dropped;
+    *buf                 = ctx->rx.done;
+    ctx->rx.pending      = 0u;
+    ctx->rx.dropped      = 0u;
+    irq_unlock(key);
 
-    return 0;
+    return dropped;
 }
 
-int8_t usart_tx(UART_Device *dev, const void *buf, size_t size)
+int8_t usart_tx_wait(UART_Device *dev, k_timeout_t timeout)
 {
     if (!z_user(dev))
         return -EINVAL;
 
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].tx.buf  = (const uint8_t *)buf;
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].tx.size = size;
-    usart_async_contexts[AVR_USARTn_INDEX(dev)].tx.cur  = 0U;
+    struct usart_async_context *const ctx = usart_get_async_context(dev);
+    if (ctx == NULL)
+        return -ENOTSUP;
 
-    /* enable transmitter */
-    SET_BIT(dev->UCSRnB, BIT(TXENn) | BIT(UDRIEn) | BIT(TXCIEn));
+    /* The semaphore may have been given by a previous transmission */
+    while ((ctx->tx.size != 0u) || (ctx->tx.segs != 0u)) {
+        if (k_sem_take(&ctx->tx_sem, timeout) != 0) {
+            return -EAGAIN;
+        }
+    }
 
     return 0;
 }
 
-#endif /* DRIVERS_UART_ASYNC */
\ No newline at end of file
+#endif /* CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS */
+
+#endif /* DRIVERS_UART_ASYNC */
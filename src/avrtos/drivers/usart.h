@@ -11,6 +11,7 @@
 
 #include <avrtos/drivers.h>
 #include <avrtos/kernel.h>
+#include <avrtos/semaphore.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,7 +69,8 @@ typedef struct {
 #endif /* ARCH_USART_COUNT > 2 */
 
 #if ARCH_USART_COUNT > 3
-#define USART3_DEVICE AVR_USARTn_BASE(2)
+/* USART3 registers are not contiguous with the other USARTs (ATmega2560) */
+#define USART3_DEVICE ((UART_Device *)(AVR_IO_BASE_ADDR + 0x0130U))
 #endif /* ARCH_USART_COUNT > 3 */
 
 /* see ATmega328p datasheet page 190 */
@@ -221,6 +223,59 @@ __kernel int8_t usart_send(UART_Device *dev, const char *buf, size_t len);
 
 // ASYNC API
 
+/**
+ * Asynchronous API
+ *
+ * Each USART is enabled with CONFIG_DRIVERS_USARTn_ASYNC, which defines its
+ * interrupt handlers and allocates its context, the contexts of the disabled
+ * USARTs are not allocated. The USARTs are handled concurrently.
+ *
+ * Reception is continuous: once a buffer is full, the interrupt switches to
+ * the other buffer before reporting the completed one (double buffering with
+ * usart_rx_enable_double()), the completed buffer can be processed while the
+ * next bytes are received. With usart_rx_enable(), the same buffer is reused.
+ *
+ * Transmission sends a buffer (usart_tx()) or a list of segments
+ * (usart_tx_sg()) from the UDRE interrupt, the completion is reported once the
+ * last byte is shifted out.
+ *
+ * Completions are reported to the callback in interrupt context (optional),
+ * and with CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS to the threads waiting
+ * in usart_rx_wait() and usart_tx_wait().
+ *
+ * Example Usage:
+ *
+ *   static uint8_t rx[2u][16u];
+ *   static const struct usart_tx_seg segs[] = {
+ *       {.buf = header, .len = sizeof(header)},
+ *       {.buf = payload, .len = sizeof(payload)},
+ *   };
+ *   void *buf;
+ *
+ *   usart_init(USART1_DEVICE, &cfg);
+ *   usart_rx_enable_double(USART1_DEVICE, rx[0u], rx[1u], 16u);
+ *   usart_tx_sg(USART1_DEVICE, segs, ARRAY_SIZE(segs));
+ *   usart_tx_wait(USART1_DEVICE, K_FOREVER);
+ *
+ *   for (;;) {
+ *       int8_t dropped = usart_rx_wait(USART1_DEVICE, &buf, K_FOREVER);
+ *       // process the 16 bytes of buf
+ *   }
+ *
+ * Limitations:
+ * - A completed buffer is only valid until the other buffer is full (until
+ *   the next byte with usart_rx_enable()).
+ * - The buffers and the segments list of a transmission must remain valid
+ *   until its completion, a transmission must not be started while another
+ *   one is in progress.
+ *
+ * Related configuration options:
+ *  - CONFIG_DRIVERS_USART0_ASYNC .. CONFIG_DRIVERS_USART3_ASYNC: Enable the
+ *    asynchronous API of the USART
+ *  - CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS: Report the completions
+ *    through semaphores
+ */
+
 struct usart_async_context;
 
 typedef enum {
@@ -231,33 +286,137 @@ typedef enum {
 
 typedef void (*usart_async_callback_t)(UART_Device *dev, struct usart_async_context *ctx);
 
+/* Segment of a scatter-gather transmission */
+struct usart_tx_seg {
+    const void *buf;
+    size_t len;
+};
+
 struct usart_async_context {
     usart_event_t evt;
 
     usart_async_callback_t callback;
 
     struct {
-        uint8_t *buf;
+        uint8_t *buf;  /* Buffer being filled */
+        uint8_t *next; /* Buffer filled next, same as buf if single buffered */
+        uint8_t *done; /* Last completed buffer */
         size_t size;
         size_t cur;
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+        uint8_t pending; /* Completed buffer not taken by usart_rx_wait() */
+        uint8_t dropped; /* Completed buffers not taken, saturated at INT8_MAX */
+#endif
     } rx;
 
     struct {
         const uint8_t *buf;
         size_t size;
         size_t cur;
+        const struct usart_tx_seg *seg; /* Next segment */
+        uint8_t segs;                   /* Remaining segments */
     } tx;
+
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+    struct k_sem rx_sem;
+    struct k_sem tx_sem;
+#endif
 };
-// typedef struct usart_event_t;
 
+/**
+ * @brief Set the callback called in interrupt context on completion.
+ *
+ * @param dev USART device.
+ * @param cb Callback, NULL to disable.
+ * @return 0 on success, -EINVAL if dev is NULL, -ENOTSUP if the asynchronous
+ * API of the USART is disabled.
+ */
 __kernel int8_t usart_set_callback(UART_Device *dev, usart_async_callback_t cb);
 
+/**
+ * @brief Disable the receiver.
+ *
+ * @param dev USART device.
+ * @return 0 on success, -EINVAL if dev is NULL.
+ */
 __kernel int8_t usart_rx_disable(UART_Device *dev);
 
+/**
+ * @brief Enable the continuous reception into a single buffer, reused once
+ * full.
+ *
+ * @param dev USART device.
+ * @param buf Buffer.
+ * @param size Size of the buffer.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * asynchronous API of the USART is disabled.
+ */
 __kernel int8_t usart_rx_enable(UART_Device *dev, void *buf, size_t size);
 
+/**
+ * @brief Enable the continuous reception into two buffers filled
+ * alternately.
+ *
+ * @param dev USART device.
+ * @param buf0 First buffer filled.
+ * @param buf1 Second buffer.
+ * @param size Size of each buffer.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * asynchronous API of the USART is disabled.
+ */
+__kernel int8_t
+usart_rx_enable_double(UART_Device *dev, void *buf0, void *buf1, size_t size);
+
+/**
+ * @brief Start the transmission of a buffer.
+ *
+ * @param dev USART device.
+ * @param buf Buffer.
+ * @param size Size of the buffer.
+ * @return 0 on success, -EINVAL if an argument is invalid, -ENOTSUP if the
+ * asynchronous API of the USART is disabled.
+ */
 __kernel int8_t usart_tx(UART_Device *dev, const void *buf, size_t size);
 
+/**
+ * @brief Start the transmission of a list of segments, sent one after the
+ * other as a single transfer (one completion).
+ *
+ * @param dev USART device.
+ * @param segs Segments, empty segments are skipped.
+ * @param count Number of segments.
+ * @return 0 on success, -EINVAL if an argument is invalid or all the segments
+ * are empty, -ENOTSUP if the asynchronous API of the USART is disabled.
+ */
+__kernel int8_t
+usart_tx_sg(UART_Device *dev, const struct usart_tx_seg *segs, uint8_t count);
+
+#if CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS
+
+/**
+ * @brief Wait for a completed reception buffer.
+ *
+ * @param dev USART device.
+ * @param buf Completed buffer.
+ * @param timeout Maximum time to wait.
+ * @return Number of completed buffers dropped since the previous call (not
+ * taken in time), -EAGAIN on timeout, -EINVAL if an argument is invalid,
+ * -ENOTSUP if the asynchronous API of the USART is disabled.
+ */
+__kernel int8_t usart_rx_wait(UART_Device *dev, void **buf, k_timeout_t timeout);
+
+/**
+ * @brief Wait for the completion of the transmission.
+ *
+ * @param dev USART device.
+ * @param timeout Maximum time to wait.
+ * @return 0 on success, -EAGAIN on timeout, -EINVAL if dev is NULL, -ENOTSUP
+ * if the asynchronous API of the USART is disabled.
+ */
+__kernel int8_t usart_tx_wait(UART_Device *dev, k_timeout_t timeout);
+
+#endif /* CONFIG_DRIVERS_USART_ASYNC_KERNEL_OBJECTS */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "lflist.h"
+
+#include "../atomic.h"
+
+#if CONFIG_KERNEL_ATOMIC_API
+
+void lfstack_push(struct lfstack *stack, struct snode *node)
+{
+    struct snode *head;
+
+    do {
+        head       = atomic_ptr_get((void *const *)&stack->head);
+        node->next = head;
+    } while (!atomic_ptr_cas((void **)&stack->head, head, node));
+}
+
+struct snode *lfstack_pop(struct lfstack *stack)
+{
+    struct snode *head;
+
+    do {
+        head = atomic_ptr_get((void *const *)&stack->head);
+        if (head == NULL) {
+            break;
+        }
+        /* The node cannot be popped by another context (single consumer),
+         * so its next pointer is still valid */
+    } while (!atomic_ptr_cas((void **)&stack->head, head, head->next));
+
+    return head;
+}
+
+struct snode *lfstack_pop_all(struct lfstack *stack)
+{
+    return atomic_ptr_set((void **)&stack->head, NULL);
+}
+
+void mpsc_push(struct mpsc *queue, struct snode *node)
+{
+    lfstack_push(&queue->in, node);
+}
+
+struct snode *mpsc_pop(struct mpsc *queue)
+{
+    struct snode *node = queue->out;
+
+    if (node == NULL) {
+        /* Reverse the pushed nodes into the private list */
+        struct snode *list = lfstack_pop_all(&queue->in);
+
+        while (list != NULL) {
+            struct snode *const next = list->next;
+
+            list->next = node;
+            node       = list;
+            list       = next;
+        }
+    }
+
+    if (node != NULL) {
+        queue->out = node->next;
+    }
+
+    return node;
+}
+
+bool mpsc_is_empty(struct mpsc *queue)
+{
+    return (queue->out == NULL) &&
+           (atomic_ptr_get((void *const *)&queue->in.head) == NULL);
+}
+
+#endif /* CONFIG_KERNEL_ATOMIC_API */
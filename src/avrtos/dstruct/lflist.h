@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _AVRTOS_LFLIST_H
+#define _AVRTOS_LFLIST_H
+
+#include <stdbool.h>
+
+#include "../defines.h"
+#include "slist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lock-free singly linked stack and MPSC queue of snode
+ *
+ * Nodes are pushed with a compare-and-set loop on the head pointer
+ * (atomic_ptr_cas()), the interrupts are never disabled for longer than a
+ * single atomic operation. Both can be used from threads and ISRs.
+ *
+ * - lfstack_push() can be called from any context.
+ * - lfstack_pop() must always be called from the same context (single
+ *   consumer): popping a node while another context pops and pushes it back
+ *   corrupts the stack (ABA problem).
+ * - lfstack_pop_all() can be called from any context if lfstack_pop() is
+ *   never used on the stack, otherwise it must be called from the consumer
+ *   context: a context which takes all the nodes and pushes the head back
+ *   between the read of head->next and the compare-and-set of lfstack_pop()
+ *   corrupts the stack as well.
+ *
+ * The MPSC queue (multiple producers, single consumer) gives the nodes in the
+ * order they were pushed: the producers push to a lfstack, the consumer takes
+ * all its nodes at once and reverses them into a private list.
+ *
+ * lfstack_push/lfstack_pop/lfstack_pop_all/mpsc_push are O(1)
+ * mpsc_pop is O(1) amortized (O(n) when the private list is refilled)
+ *
+ * Requires CONFIG_KERNEL_ATOMIC_API.
+ */
+
+struct lfstack {
+    struct snode *head;
+};
+
+#define LFSTACK_INIT()                                                                   \
+    {                                                                                    \
+        .head = NULL                                                                     \
+    }
+#define LFSTACK_DEFINE(name) struct lfstack name = LFSTACK_INIT()
+
+struct mpsc {
+    struct lfstack in; /* Nodes pushed by the producers (LIFO) */
+    struct snode *out; /* Nodes taken by the consumer (FIFO) */
+};
+
+#define MPSC_INIT()                                                                      \
+    {                                                                                    \
+        .in = LFSTACK_INIT(), .out = NULL                                                \
+    }
+#define MPSC_DEFINE(name) struct mpsc name = MPSC_INIT()
+
+/**
+ * @brief Push a node on the stack.
+ *
+ * @param stack Stack.
+ * @param node Node to push, must not be in the stack.
+ */
+void lfstack_push(struct lfstack *stack, struct snode *node);
+
+/**
+ * @brief Pop the last pushed node (single consumer).
+ *
+ * @param stack Stack.
+ * @return Node, NULL if the stack is empty.
+ */
+struct snode *lfstack_pop(struct lfstack *stack);
+
+/**
+ * @brief Take all the nodes of the stack at once.
+ *
+ * Must be called from the consumer context if lfstack_pop() is used on the
+ * stack.
+ *
+ * @param stack Stack.
+ * @return List of nodes linked by next, from the last pushed one, NULL if
+ * the stack is empty.
+ */
+struct snode *lfstack_pop_all(struct lfstack *stack);
+
+/**
+ * @brief Push a node to the queue (any producer).
+ *
+ * @param queue Queue.
+ * @param node Node to push, must not be in the queue.
+ */
+void mpsc_push(struct mpsc *queue, struct snode *node);
+
+/**
+ * @brief Pop the first pushed node (consumer only).
+ *
+ * @param queue Queue.
+ * @return Node, NULL if the queue is empty.
+ */
+struct snode *mpsc_pop(struct mpsc *queue);
+
+/**
+ * @brief Check whether the queue is empty (consumer only).
+ *
+ * @param queue Queue.
+ * @return True if no node is pending.
+ */
+bool mpsc_is_empty(struct mpsc *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_LFLIST_H */
@@ -54,6 +54,12 @@
  */
 #define ENOMSG 35
 
+/* EOVERFLOW (75): Value too large.
+ * This error is returned when a counter would exceed its maximum value (e.g.,
+ * the lock count of a reentrant mutex).
+ */
+#define EOVERFLOW 75
+
 /* ENOTSUP (95): Operation not supported.
  * This error indicates that the operation is not supported or implemented.
  */
@@ -9,30 +9,33 @@
 #include "kernel.h"
 #include "kernel_private.h"
 
-#define KERNEL_FLAGS_OPT_SET_ALL_ENABLED 0
-#define KERNEL_FLAGS_OPT_SET_ANY_ENABLED 1
-#define KERNEL_FLAGS_OPT_CLR_ALL_ENABLED 0
-#define KERNEL_FLAGS_OPT_CLR_ANY_ENABLED 1
-
 /**
- * @brief Macros to handle swap_data, used for storing both options and the mask.
- * The swap_data is split into an options byte (upper 8 bits) and a mask byte (lower 8
- * bits).
+ * @brief Wait record of a thread pending on a flags object.
+ *
+ * The record lives on the stack of the waiting thread for the duration of the
+ * wait and is referenced by its swap_data. On wake-up, the notifier overwrites
+ * the mask with the bits which triggered the wake-up.
  */
-#define Z_SWAP_DATA_GET_OPTIONS(swapd)   ((uint8_t)(((uint16_t)(swapd)) >> 8u))
-#define Z_SWAP_DATA_GET_PEND_MASK(swapd) ((uint8_t)(((uint16_t)(swapd)) & 0xFFu))
-#define Z_SWAP_DATA_GET_TRIG_MASK(swapd) ((uint8_t)(((uint16_t)(swapd)) & 0xFFu))
+struct z_flags_wait {
+    k_flags_value_t mask; ///< Pending mask, then triggering bits on wake-up
+    uint8_t options;      ///< Polling options (K_FLAGS_SET_ANY/ALL, K_FLAGS_CONSUME)
+};
 
 /**
- * @brief Initialize swap_data with the trigger mask only.
+ * @brief Get the bits of the mask satisfying the wait condition, or 0 if the
+ * condition is not met.
  */
-#define Z_SWAP_DATA_INIT_TRIG_MASK(trig) ((void *)(((uint16_t)(trig)) & 0xFFu))
+static inline k_flags_value_t
+z_flags_match(k_flags_value_t value, k_flags_value_t mask, uint8_t options)
+{
+    const k_flags_value_t trig = value & mask;
 
-/**
- * @brief Initialize swap_data with both options and mask.
- */
-#define Z_SWAP_DATA_INIT_OPT_N_MASK(opt, mask)                                           \
-    ((void *)((((uint16_t)(opt)) << 8u) | ((uint16_t)(mask))))
+    if ((options & K_FLAGS_SET_ALL) && (trig != mask)) {
+        return 0u;
+    }
+
+    return trig;
+}
 
 int8_t k_flags_init(struct k_flags *flags, k_flags_value_t value)
 {
@@ -55,7 +58,11 @@ int k_flags_poll(struct k_flags *flags,
 
     if (!z_user(flags && mask))
         return -EINVAL;
-    if (!z_user((options & ~(K_FLAGS_SET_ANY | K_FLAGS_CONSUME)) == 0u))
+    if (!z_user((options & ~(K_FLAGS_SET_ANY | K_FLAGS_SET_ALL | K_FLAGS_CONSUME)) ==
+                0u))
+        return -ENOTSUP;
+    if (!z_user((options & (K_FLAGS_SET_ANY | K_FLAGS_SET_ALL)) !=
+                (K_FLAGS_SET_ANY | K_FLAGS_SET_ALL)))
         return -ENOTSUP;
 
     k_flags_value_t mask_val = *mask;
@@ -66,21 +73,20 @@ int k_flags_poll(struct k_flags *flags,
     const uint8_t lock = irq_lock();
 
     k_flags_value_t value = flags->flags;
-    k_flags_value_t trig  = value & mask_val;
+    k_flags_value_t trig  = z_flags_match(value, mask_val, options);
 
     if (trig == 0u) {
-        /* No matching flags set, prepare to wait
-         *
-         * This is the limitation for having CONFIG_KERNEL_FLAGS_SIZE greater than
-         * 1 byte. The swap_data is used to store the mask (1 byte) and the options
-         * (1 byte).
-         */
-        z_ker.current->swap_data = Z_SWAP_DATA_INIT_OPT_N_MASK(options, mask_val);
+        /* Condition not met, prepare to wait */
+        struct z_flags_wait wait = {
+            .mask    = mask_val,
+            .options = (uint8_t)options,
+        };
+        z_ker.current->swap_data = &wait;
 
         ret = z_pend_current_on(&flags->waitqueue, timeout);
         if (ret == 0) {
             /* Retrieve the flags that caused the wake-up */
-            *mask = Z_SWAP_DATA_GET_TRIG_MASK(z_ker.current->swap_data);
+            *mask = wait.mask;
         }
     } else {
         if ((options & K_FLAGS_CONSUME) != 0u) {
@@ -122,19 +128,31 @@ int8_t k_flags_notify(struct k_flags *flags,
         }
 
         struct k_thread *const thread = Z_THREAD_FROM_WQHANDLE_TIE(tie);
-        const uint16_t swap_data      = (uint16_t)thread->swap_data;
-        const k_flags_value_t mask    = Z_SWAP_DATA_GET_PEND_MASK(swap_data);
-        const k_flags_value_t trig    = notify_value & mask;
+        struct z_flags_wait *const wait = thread->swap_data;
+        const k_flags_value_t mask      = wait->mask;
+        const uint8_t opt               = wait->options;
+        k_flags_value_t trig;
+
+        /* Only wake up threads for which at least one of the newly set bits
+         * is relevant, a K_FLAGS_SET_ALL waiter also needs all the other bits
+         * of its mask to be already set.
+         */
+        if ((notify_value & mask) != 0u) {
+            trig = z_flags_match(flags->flags | notify_value, mask, opt);
+        } else {
+            trig = 0u;
+        }
 
         if (trig != 0u) {
-            thread->swap_data = Z_SWAP_DATA_INIT_TRIG_MASK(trig);
+            wait->mask = trig;
 
             /* Unpend thread */
             dlist_remove(tie);
             z_wake_up(thread);
 
-            if (Z_SWAP_DATA_GET_OPTIONS(swap_data) & K_FLAGS_CONSUME) {
+            if (opt & K_FLAGS_CONSUME) {
                 notify_value &= ~trig;
+                flags->flags &= ~trig;
             }
 
             ret++; /* Increment the number of notified threads */
@@ -37,7 +37,7 @@
  *
  * Related configuration options:
  *  - CONFIG_KERNEL_FLAGS_SIZE: Specifies the size (in bytes) of the flags object,
- *    supporting 1 flag byte only. Future versions may support larger flags objects.
+ *    supporting 1, 2 or 4 bytes (8, 16 or 32 flags).
  * - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks for flags operations.
  */
 
@@ -48,8 +48,12 @@
 
 #if CONFIG_KERNEL_FLAGS_SIZE == 1
 typedef uint8_t k_flags_value_t;
+#elif CONFIG_KERNEL_FLAGS_SIZE == 2
+typedef uint16_t k_flags_value_t;
+#elif CONFIG_KERNEL_FLAGS_SIZE == 4
+typedef uint32_t k_flags_value_t;
 #else
-#error "Unsupported flags size, only 1 byte is supported. Feature coming soon!"
+#error "Unsupported flags size, only 1, 2 or 4 bytes are supported"
 #endif
 
 /**
@@ -99,8 +103,7 @@ struct k_flags {
 typedef enum {
     /* Polling options */
     K_FLAGS_SET_ANY = 1 << 0u, ///< Wait for any bit of the flags to be set
-    K_FLAGS_SET_ALL =
-        1 << 1u, ///< Wait for all bits of the flags to be set (not supported)
+    K_FLAGS_SET_ALL = 1 << 1u, ///< Wait for all bits of the flags to be set
     K_FLAGS_CLR_ANY =
         1 << 2u, ///< Wait for any bit of the flags to be cleared (not supported)
     K_FLAGS_CLR_ALL =
@@ -134,12 +137,17 @@ int8_t k_flags_init(struct k_flags *flags, k_flags_value_t value);
  * set as required, the function returns immediately. Otherwise, the
  * thread will block until the condition is met or the timeout expires.
  *
+ * With K_FLAGS_SET_ANY (default), the thread is woken up as soon as any bit
+ * of the mask is set. With K_FLAGS_SET_ALL, the thread is woken up only once
+ * all bits of the mask are set, in which case the whole mask is returned.
+ *
  * Safety: This function is generally not safe to call from an ISR context
  *         if the timeout is different from K_NO_WAIT.
  *
  * @param flags Pointer to the flags object.
  * @param mask Mask of bits to wait for.
- * @param options Polling options, e.g., K_FLAGS_SET_ANY and K_FLAGS_CONSUME.
+ * @param options Polling options, K_FLAGS_SET_ANY or K_FLAGS_SET_ALL, optionally
+ *                combined with K_FLAGS_CONSUME.
  * @param timeout Timeout value to wait for the flags.
  * @return Positive value indicating the bits that caused the wake-up, or
  * a negative error code on failure.
@@ -6,6 +6,7 @@
 
 #include "init.h"
 
+#include "alloc/alloc.h"
 #include "canaries.h"
 #include "debug.h"
 #include "kernel.h"
@@ -108,6 +109,11 @@ void z_avrtos_init(void)
     z_mem_slab_init_module();
 #endif
 
+#if CONFIG_KERNEL_GLOBAL_ALLOCATOR_SIZE > 0
+    /* Initialize global allocator */
+    z_global_allocator_init();
+#endif
+
 #if CONFIG_KERNEL_TIMERS && CONFIG_AVRTOS_LINKER_SCRIPT
     /* Initialize timer module */
     z_timer_init_module();
@@ -20,6 +20,7 @@
 #include "idle.h"
 #include "kernel_private.h"
 #include "poll.h"
+#include "post.h"
 #include "stack_sentinel.h"
 #include "systime.h"
 #include "timer.h"
@@ -119,6 +120,7 @@ K_THREAD struct k_thread z_thread_main = {
         },
     .wqhandle  = WQHANDLE_INIT(), // The thread isn't pending on any events
     .swap_data = NULL,
+#if Z_THREAD_STACK_INFO
     .stack =
         {
             .end = Z_THREAD_MAIN_STACK_END_ADDR,
@@ -127,7 +129,10 @@ K_THREAD struct k_thread z_thread_main = {
              */
             .size = CONFIG_THREAD_MAIN_STACK_SIZE,
         },
+#endif
+#if Z_THREAD_SYMBOL
     .symbol = 'M', // Default main thread symbol
+#endif
 #if CONFIG_KERNEL_REENTRANCY
     .sched_lock_cnt = 0u,
 #endif
@@ -269,9 +274,11 @@ __always_inline void z_thread_finalize_stack_init(struct k_thread *const thread)
      * stacks. We cannot change the endianness of addresses
      * determined by the linker at compilation time. So we need to
      * do it here.
+     *
+     * The thread did not run yet, its context is right above its
+     * initial stack pointer (the stack end may not be stored).
      */
-    struct z_callsaved_ctx *const ctx =
-        sys_ptr_sub(thread->stack.end, Z_CALLSAVED_CTX_SIZE - 1u);
+    struct z_callsaved_ctx *const ctx = sys_ptr_add(thread->sp, 1u);
     swap_endianness(&ctx->thread_context);
     swap_endianness((void *)&ctx->thread_entry);
     swap_endianness(&ctx->pc);
@@ -281,6 +288,24 @@ __always_inline void z_thread_finalize_stack_init(struct k_thread *const thread)
 #endif /* __AVR_3_BYTE_PC__ */
 }
 
+#if CONFIG_THREAD_STACK_IMAGE
+__STATIC_ASSERT(CONFIG_AVRTOS_LINKER_SCRIPT,
+                "CONFIG_THREAD_STACK_IMAGE requires CONFIG_AVRTOS_LINKER_SCRIPT");
+
+__attribute__((used)) struct z_stack_image z_stack_image = {
+    .patched     = 0u,
+    .thread_size = sizeof(struct k_thread),
+    .ctx_size    = Z_CALLSAVED_CTX_SIZE,
+#if CONFIG_THREAD_STACK_SENTINEL
+    .sentinel_size = CONFIG_THREAD_STACK_SENTINEL_SIZE,
+#else
+    .sentinel_size = 0u,
+#endif
+    .canaries      = CONFIG_THREAD_CANARIES,
+    .canary_symbol = CONFIG_THREAD_CANARIES_SYMBOL,
+};
+#endif
+
 /**
  * @brief Create the idle thread.
  */
@@ -306,6 +331,9 @@ void z_init_threads(void)
 #endif
 
 #if CONFIG_AVRTOS_LINKER_SCRIPT
+    /* Contexts already big-endian if generated at build time */
+    const bool finalize = !z_stack_image_patched();
+
     /* The main thread is the first running */
     for (uint8_t i = 0; i < &__k_threads_end - &__k_threads_start; i++) {
         struct k_thread *const thread = &(&__k_threads_start)[i];
@@ -325,7 +353,9 @@ void z_init_threads(void)
             dlist_append(z_ker.run_queue, &thread->tie.runqueue);
         }
 
-        z_thread_finalize_stack_init(thread);
+        if (finalize) {
+            z_thread_finalize_stack_init(thread);
+        }
     }
 #endif
 }
@@ -344,8 +374,11 @@ __STATIC_ASSERT_NOMSG(Z_KERNEL_TIME_SLICE_TICKS != 0);
  * the IDLE thread.
  *
  * Assumptions: The interrupt flag is cleared when called.
+ *
+ * @return 0 if the interrupted thread is the only ready thread (the scheduler
+ * can be skipped), 1 otherwise.
  */
-void z_sched_enter(void)
+uint8_t z_sched_enter(void)
 {
     __Z_DBG_SYSTICK_ENTER();
 
@@ -396,11 +429,17 @@ void z_sched_enter(void)
     z_event_q_process();
 #endif /* CONFIG_KERNEL_EVENTS */
 
+#if CONFIG_KERNEL_DEFERRED_POST
+    z_post_process();
+#endif /* CONFIG_KERNEL_DEFERRED_POST */
+
 #if CONFIG_KERNEL_ASSERT
     z_ker.kernel_mode = 0u;
 #endif
 
     __Z_DBG_SYSTICK_EXIT();
+
+    return z_sched_current_alone() ? 0u : 1u;
 }
 
 /**
@@ -425,6 +464,13 @@ struct k_thread *z_scheduler(void)
     /* Reset flags */
     prev->flags &= ~(Z_THREAD_TIMER_EXPIRED_MSK | Z_THREAD_PEND_CANCELED_MSK);
 
+#if CONFIG_KERNEL_DEFERRED_POST
+    /* Perform the wake-ups posted from ISRs before electing the next thread,
+     * woken up threads are inserted right after the current one.
+     */
+    z_post_process();
+#endif /* CONFIG_KERNEL_DEFERRED_POST */
+
     /* If the previous thread put itself in a pending state,
      * it already removed itself from the runqueue, so we don't need
      * to do it here
@@ -708,10 +754,11 @@ __kernel uint8_t z_cancel_all_pending(struct dnode *waitqueue)
 }
 
 static void z_thread_stack_create(struct k_thread *const thread,
+                                  void *const stack_end,
                                   k_thread_entry_t entry,
                                   void *const context_p)
 {
-    struct z_callsaved_ctx *const ctx = Z_THREAD_CTX_START(thread->stack.end);
+    struct z_callsaved_ctx *const ctx = Z_THREAD_CTX_START(stack_end);
 
     /* Initialize unused registers with default value */
     for (uint8_t *reg = ctx->regs; reg < ctx->regs + sizeof(ctx->regs); reg++) {
@@ -747,8 +794,12 @@ int8_t k_thread_create(struct k_thread *thread,
     if (!z_user(thread && entry && stack && stack_size >= Z_THREAD_STACK_MIN_SIZE))
         return -EINVAL;
 
-    thread->stack.end  = (void *)Z_STACK_END(stack, stack_size);
+    void *const stack_end = (void *)Z_STACK_END(stack, stack_size);
+
+#if Z_THREAD_STACK_INFO
+    thread->stack.end  = stack_end;
     thread->stack.size = stack_size;
+#endif
 
 #if CONFIG_THREAD_CANARIES
     z_init_thread_stack_canaries(thread);
@@ -758,13 +809,18 @@ int8_t k_thread_create(struct k_thread *thread,
     z_init_thread_stack_sentinel(thread);
 #endif /* CONFIG_THREAD_STACK_SENTINEL */
 
-    z_thread_stack_create(thread, entry, context_p);
+    z_thread_stack_create(thread, stack_end, entry, context_p);
 
     /* Initialize internal data */
     thread->flags     = Z_THREAD_STATE_STOPPED | (prio & Z_THREAD_PRIO_MSK);
-    thread->symbol    = symbol;
     thread->swap_data = NULL;
 
+#if Z_THREAD_SYMBOL
+    thread->symbol = symbol;
+#else
+    ARG_UNUSED(symbol);
+#endif
+
 #if CONFIG_KERNEL_REENTRANCY
     thread->sched_lock_cnt = 0u;
 #endif
@@ -142,6 +142,55 @@ __always_inline struct k_thread *k_thread_get_main(void)
     return &z_thread_main;
 }
 
+#if CONFIG_AVRTOS_LINKER_SCRIPT
+extern struct k_thread __k_threads_start;
+extern struct k_thread __k_threads_end;
+
+/**
+ * @brief Get the index of a thread in the .k_threads section.
+ *
+ * An index can be stored instead of a pointer to save one byte, e.g. in
+ * message queues or application tables.
+ *
+ * @param thread Pointer to a thread defined with K_THREAD_DEFINE() (or the
+ * main/idle thread).
+ * @return uint8_t Index of the thread.
+ */
+__always_inline uint8_t k_thread_index(struct k_thread *thread)
+{
+    return (uint8_t)(thread - &__k_threads_start);
+}
+
+/**
+ * @brief Get a thread from its index in the .k_threads section.
+ *
+ * @param index Index of the thread, as returned by k_thread_index().
+ * @return struct k_thread* Pointer to the thread.
+ */
+__always_inline struct k_thread *k_thread_from_index(uint8_t index)
+{
+    return &(&__k_threads_start)[index];
+}
+#endif /* CONFIG_AVRTOS_LINKER_SCRIPT */
+
+/**
+ * @brief Get the symbol of a thread.
+ *
+ * With CONFIG_THREAD_COMPACT, the symbol is not stored: the index of the thread
+ * in the .k_threads section is used instead ('0', '1', ...), or '?' for
+ * threads created at runtime.
+ */
+#if Z_THREAD_SYMBOL
+#define K_THREAD_SYMBOL(thread) ((thread)->symbol)
+#elif CONFIG_AVRTOS_LINKER_SCRIPT
+#define K_THREAD_SYMBOL(thread)                                                          \
+    (((thread) >= &__k_threads_start && (thread) < &__k_threads_end)                     \
+         ? (char)('0' + k_thread_index(thread))                                          \
+         : '?')
+#else
+#define K_THREAD_SYMBOL(thread) '?'
+#endif
+
 /**
  * @brief Disable interrupts in the current thread.
  */
@@ -400,6 +449,20 @@ uint8_t k_ready_count(void);
  */
 void z_yield(void);
 
+/**
+ * @brief Check whether the current thread is the only thread in the runqueue.
+ *
+ * Assumptions: The interrupt flag is cleared when called.
+ *
+ * @return true if the scheduler would elect the current thread again.
+ */
+__always_inline bool z_sched_current_alone(void)
+{
+    struct dnode *const rq = z_ker.run_queue;
+
+    return (rq == &z_ker.current->tie.runqueue) && (rq->next == rq);
+}
+
 /**
  * @brief Yield the CPU to the next thread in the scheduler's runqueue.
  *
@@ -413,6 +476,15 @@ void z_yield(void);
 __always_inline void k_yield(void)
 {
     const uint8_t key = irq_lock();
+
+#if CONFIG_KERNEL_SCHEDULER_FAST_PATHS && !CONFIG_KERNEL_DEFERRED_POST
+    /* Nothing to switch to, skip the scheduler */
+    if (z_sched_current_alone()) {
+        irq_unlock(key);
+        return;
+    }
+#endif
+
     z_yield();
     irq_unlock(key);
 }
@@ -88,6 +88,35 @@ __always_inline uint8_t z_get_thread_state(struct k_thread *thread)
  */
 #define Z_THREAD_IS_MAIN(_thread) (_thread == &z_thread_main)
 
+#if CONFIG_THREAD_STACK_IMAGE
+/**
+ * @brief Description of the initial stacks image, read and patched by
+ * scripts/stack_image.py after the link.
+ */
+struct z_stack_image {
+    uint8_t patched;       ///< Set to 1 by the script once the image is patched
+    uint8_t thread_size;   ///< Size of struct k_thread
+    uint8_t ctx_size;      ///< Size of the initial context (Z_CALLSAVED_CTX_SIZE)
+    uint8_t sentinel_size; ///< Size of the stack sentinel
+    uint8_t canaries;      ///< Whether stacks must be filled with canaries
+    uint8_t canary_symbol; ///< Canary symbol
+};
+
+extern struct z_stack_image z_stack_image;
+
+/**
+ * @brief Check whether the initial stacks of the static threads were
+ * generated at build time.
+ */
+__always_inline bool z_stack_image_patched(void)
+{
+    /* Written in the ELF file, not by the program */
+    return *(volatile uint8_t *)&z_stack_image.patched != 0u;
+}
+#else
+#define z_stack_image_patched() false
+#endif
+
 /**
  * @brief Perform a context switch between two threads (assembly function).
  *
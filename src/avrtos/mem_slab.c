@@ -11,6 +11,7 @@
 #include "dstruct/dlist.h"
 #include "kernel.h"
 #include "kernel_private.h"
+#include "misc/serial.h"
 
 #define K_MODULE K_MODULE_MEMSLAB
 
@@ -31,6 +32,32 @@ void z_mem_slab_init_module(void)
         z_slab_alloc_finalize_init(&(&(&__k_mem_slabs_start)[i])->allocator);
     }
 }
+
+void k_mem_slab_stats_dump_all(void)
+{
+    struct k_mem_slab_stats stats;
+
+    for (struct k_mem_slab *slab = &__k_mem_slabs_start; slab < &__k_mem_slabs_end;
+         slab++) {
+        k_mem_slab_stats_get(slab, &stats);
+
+        serial_print_p(PSTR("0x"));
+        serial_hex16((uint16_t)slab);
+        serial_print_p(PSTR(" blk "));
+        serial_u16(stats.block_size);
+        serial_print_p(PSTR(" free "));
+        serial_u8(stats.free);
+        serial_transmit('/');
+        serial_u8(stats.count);
+        serial_print_p(PSTR(" max "));
+        serial_u8(stats.max_used);
+        serial_print_p(PSTR(" fail "));
+        serial_u16(stats.failures);
+        serial_print_p(PSTR(" served "));
+        serial_u16(stats.waiters_served);
+        serial_transmit('\n');
+    }
+}
 #endif
 
 int8_t k_mem_slab_init(struct k_mem_slab *slab,
@@ -43,6 +70,9 @@ int8_t k_mem_slab_init(struct k_mem_slab *slab,
     if (ret == 0) {
         /* Initialize the wait queue for threads waiting on this slab */
         dlist_init(&slab->waitqueue);
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+        slab->waiters_served = 0u;
+#endif
     }
 
     return ret;
@@ -100,9 +130,82 @@ struct k_thread *k_mem_slab_free(struct k_mem_slab *slab, void *mem)
         /* Otherwise, free the block */
         slab_free(&slab->allocator, mem);
     }
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    else {
+        slab->waiters_served++;
+    }
+#endif
 
     irq_unlock(key);
 
 ret:
     return thread;
-}
\ No newline at end of file
+}
+
+int8_t k_mem_slab_alloc_many(struct k_mem_slab *slab, void **mem, uint8_t count)
+{
+    if (!z_user(slab && mem && (count <= INT8_MAX)))
+        return -EINVAL;
+
+    const uint8_t key = irq_lock();
+
+    const uint8_t n = slab_alloc_many(&slab->allocator, mem, count);
+
+    irq_unlock(key);
+
+    return (int8_t)n;
+}
+
+int8_t k_mem_slab_free_many(struct k_mem_slab *slab, void **mem, uint8_t count)
+{
+    if (!z_user(slab && mem && (count <= INT8_MAX)))
+        return -EINVAL;
+
+    uint8_t woken = 0u;
+    uint8_t i     = 0u;
+
+    const uint8_t key = irq_lock();
+
+    /* Serve the waiting threads first, pollers are only notified */
+    while ((i < count) && !DLIST_EMPTY(&slab->waitqueue)) {
+        if (z_unpend_first_and_swap(&slab->waitqueue, mem[i]) != NULL) {
+            woken++;
+            i++;
+        }
+    }
+
+    slab_free_many(&slab->allocator, &mem[i], count - i);
+
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    slab->waiters_served += woken;
+#endif
+
+    irq_unlock(key);
+
+    return (int8_t)woken;
+}
+
+int8_t k_mem_slab_stats_get(struct k_mem_slab *slab, struct k_mem_slab_stats *stats)
+{
+    if (!z_user(slab && stats))
+        return -EINVAL;
+
+    const uint8_t key = irq_lock();
+
+    stats->block_size = slab->allocator.block_size;
+    stats->count      = slab->allocator.count;
+    stats->free       = slab->allocator.free_count;
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    stats->max_used       = slab->allocator.max_used;
+    stats->failures       = slab->allocator.failures;
+    stats->waiters_served = slab->waiters_served;
+#else
+    stats->max_used       = 0u;
+    stats->failures       = 0u;
+    stats->waiters_served = 0u;
+#endif
+
+    irq_unlock(key);
+
+    return 0;
+}
@@ -14,9 +14,14 @@
  * blocks from the slab when available, and free them when no longer needed. If no blocks
  * are available, threads can block until a block becomes free.
  *
+ * Statistics are maintained on each allocation and free, and can be read in
+ * constant time with k_mem_slab_stats_get(), or printed for all memory slabs
+ * with k_mem_slab_stats_dump_all().
+ *
  * Related configuration options:
  *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks
  *  - CONFIG_AVRTOS_LINKER_SCRIPT: Enables the use of the linker script
+ *  - CONFIG_KERNEL_MEM_SLAB_STATS: Enable high-water mark and failures statistics
  */
 
 #ifndef _AVRTOS_MEM_SLAB_H_
@@ -41,6 +46,24 @@ extern "C" {
 struct k_mem_slab {
     struct slab_allocator allocator; /**< Slab allocator */
     struct dnode waitqueue;          /**< Wait queue for threads pending on a block */
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    uint16_t waiters_served; /**< Blocks handed over to waiting threads */
+#endif
+};
+
+/**
+ * @brief Memory slab statistics
+ *
+ * Fields marked (*) are only maintained with CONFIG_KERNEL_MEM_SLAB_STATS,
+ * they are 0 otherwise.
+ */
+struct k_mem_slab_stats {
+    uint16_t block_size;     /**< Size of each block in bytes */
+    uint8_t count;           /**< Total number of blocks */
+    uint8_t free;            /**< Number of free blocks */
+    uint8_t max_used;        /**< Maximum number of blocks allocated at once (*) */
+    uint16_t failures;       /**< Allocations which found the slab empty (*) */
+    uint16_t waiters_served; /**< Blocks freed directly to a waiting thread (*) */
 };
 
 /**
@@ -145,6 +168,63 @@ __kernel int8_t k_mem_slab_alloc(struct k_mem_slab *slab,
  */
 __kernel struct k_thread *k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @brief Allocate several memory blocks from a slab at once.
+ *
+ * Up to `count` blocks are allocated in a single critical section, this
+ * function never waits for blocks to become available.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param slab Pointer to the memory slab structure.
+ * @param mem Array receiving the allocated memory blocks.
+ * @param count Number of blocks to allocate.
+ * @return Number of blocks allocated (can be less than count, or 0 if the slab
+ * is empty), or -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_mem_slab_alloc_many(struct k_mem_slab *slab, void **mem, uint8_t count);
+
+/**
+ * @brief Free several memory blocks back to a slab at once.
+ *
+ * In a single critical section, blocks are first handed over to the threads
+ * waiting on the slab (in order), the remaining blocks are spliced to the
+ * free list.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param slab Pointer to the memory slab structure.
+ * @param mem Array of the memory blocks to free.
+ * @param count Number of blocks to free.
+ * @return Number of threads woken up, or -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_mem_slab_free_many(struct k_mem_slab *slab, void **mem, uint8_t count);
+
+/**
+ * @brief Get the statistics of a memory slab.
+ *
+ * Statistics are maintained incrementally, this function runs in constant time.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param slab Pointer to the memory slab structure.
+ * @param stats Pointer to the structure receiving the statistics.
+ * @return 0 on success, -EINVAL if an argument is NULL.
+ */
+__kernel int8_t k_mem_slab_stats_get(struct k_mem_slab *slab,
+                                     struct k_mem_slab_stats *stats);
+
+/**
+ * @brief Print the statistics of all statically defined memory slabs.
+ *
+ * One line per memory slab defined with K_MEM_SLAB_DEFINE:
+ *
+ *   0x0234 blk 16 free 3/8 max 7 fail 2 served 1
+ *
+ * @note Requires CONFIG_AVRTOS_LINKER_SCRIPT.
+ */
+__kernel void k_mem_slab_stats_dump_all(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,7 @@
 
 #include <util/atomic.h>
 
+#include "atomic.h"
 #include "debug.h"
 #include "kernel.h"
 #include "kernel_private.h"
@@ -31,19 +32,40 @@ int8_t k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
     if (!z_user(mutex))
         return -EINVAL;
 
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+    /* Uncontended fast path: take the free mutex with a single atomic
+     * compare-and-swap on the lock byte, then record the owner.
+     */
+    if (atomic_cas(&mutex->lock, Z_MUTEX_UNLOCKED_VALUE, 1u)) {
+        __Z_DBG_MUTEX_LOCKED(z_ker.current);
+        mutex->owner = z_ker.current;
+        return 0;
+    }
+#endif /* CONFIG_KERNEL_MUTEX_FAST_PATH */
+
     int8_t ret        = 0;
     const uint8_t key = irq_lock();
 
-    if (mutex->lock == Z_MUTEX_UNLOCKED_VALUE) {
+    if ((mutex->lock & Z_MUTEX_COUNT_MSK) == Z_MUTEX_UNLOCKED_VALUE) {
         /* Mutex is available, acquire it */
-        mutex->lock = 1u;
+        mutex->lock |= 1u;
     } else if (mutex->owner == z_ker.current) {
 #if CONFIG_KERNEL_REENTRANCY
-        /* Mutex is already owned by the current thread, increment lock count */
-        mutex->lock++;
+        /* Mutex is already owned by the current thread, increment lock count,
+         * which must not overflow into Z_MUTEX_WAITERS_MSK */
+        if ((mutex->lock & Z_MUTEX_COUNT_MSK) == Z_MUTEX_COUNT_MSK) {
+            ret = -EOVERFLOW;
+        } else {
+            mutex->lock++;
+        }
 #endif /* CONFIG_KERNEL_REENTRANCY */
         goto exit;
     } else {
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+        /* Force the owner into the slow path when unlocking the mutex */
+        mutex->lock |= Z_MUTEX_WAITERS_MSK;
+#endif /* CONFIG_KERNEL_MUTEX_FAST_PATH */
+
         /* Mutex is locked by another thread, wait for it to become available */
         ret = z_pend_current_on(&mutex->waitqueue, timeout);
     }
@@ -64,6 +86,23 @@ struct k_thread *k_mutex_unlock(struct k_mutex *mutex)
     if (!z_user(mutex))
         return NULL;
 
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+    /* Uncontended fast path: release the mutex if it is locked once and no
+     * thread is waiting. The owner is cleared first, so that a thread
+     * preempting us between the two steps cannot see the mutex released
+     * while still owned, it instead sets Z_MUTEX_WAITERS_MSK and the
+     * compare-and-swap fails.
+     */
+    if (mutex->owner == z_ker.current) {
+        mutex->owner = NULL;
+        if (atomic_cas(&mutex->lock, 1u, Z_MUTEX_UNLOCKED_VALUE)) {
+            __Z_DBG_MUTEX_UNLOCKED(z_ker.current);
+            return NULL;
+        }
+        mutex->owner = z_ker.current;
+    }
+#endif /* CONFIG_KERNEL_MUTEX_FAST_PATH */
+
     struct k_thread *thread = NULL;
     const uint8_t key       = irq_lock();
 
@@ -71,7 +110,7 @@ struct k_thread *k_mutex_unlock(struct k_mutex *mutex)
         /* Current thread does not own the mutex, cannot unlock */
         goto exit;
 #if CONFIG_KERNEL_REENTRANCY
-    } else if (mutex->lock > 1u) {
+    } else if ((mutex->lock & Z_MUTEX_COUNT_MSK) > 1u) {
         /* Reentrant locking: decrement lock count instead of unlocking */
         mutex->lock--;
         goto exit;
@@ -88,8 +127,28 @@ struct k_thread *k_mutex_unlock(struct k_mutex *mutex)
     thread = z_unpend_first_thread(&mutex->waitqueue);
     if (thread == NULL) {
         /* No threads are waiting, fully unlock the mutex */
-        mutex->lock  = Z_MUTEX_UNLOCKED_VALUE;
         mutex->owner = NULL;
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+        /* Only pollers were notified, remaining waiters must still be
+         * woken up by the next owner from the slow path.
+         */
+        mutex->lock =
+            DLIST_EMPTY(&mutex->waitqueue) ? Z_MUTEX_UNLOCKED_VALUE : Z_MUTEX_WAITERS_MSK;
+#else
+        mutex->lock = Z_MUTEX_UNLOCKED_VALUE;
+#endif /* CONFIG_KERNEL_MUTEX_FAST_PATH */
+    } else {
+        /* Hand the mutex over right away, so that the previous owner is not
+         * considered as the owner anymore until the new owner runs.
+         */
+        mutex->owner = thread;
+
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+        if (DLIST_EMPTY(&mutex->waitqueue)) {
+            /* Last waiter, allow the fast path again */
+            mutex->lock &= ~Z_MUTEX_WAITERS_MSK;
+        }
+#endif /* CONFIG_KERNEL_MUTEX_FAST_PATH */
     }
 
 exit:
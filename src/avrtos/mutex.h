@@ -17,10 +17,13 @@
  *
  * Mutexes can be configured to allow reentrant locking, where the same thread
  * can lock the mutex multiple times and must unlock it the same number of times.
+ * A mutex can be locked at most Z_MUTEX_COUNT_MSK times (127 with
+ * CONFIG_KERNEL_MUTEX_FAST_PATH, 255 otherwise).
  *
  * Related configuration options:
  *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks
  *  - CONFIG_KERNEL_REENTRANCY: Enable reentrant mutexes
+ *  - CONFIG_KERNEL_MUTEX_FAST_PATH: Lock/unlock uncontended mutexes without IRQ lock
  */
 
 #ifndef _AVRTOS_MUTEX_H_
@@ -38,6 +41,20 @@ extern "C" {
 
 #define Z_MUTEX_UNLOCKED_VALUE 0u
 
+/**
+ * @brief Bit of the lock byte indicating that threads may be waiting on the mutex.
+ *
+ * Only used with CONFIG_KERNEL_MUTEX_FAST_PATH, it forces the owner to take the
+ * slow path when unlocking the mutex. The remaining bits hold the lock count.
+ */
+#if CONFIG_KERNEL_MUTEX_FAST_PATH
+#define Z_MUTEX_WAITERS_MSK 0x80u
+#define Z_MUTEX_COUNT_MSK   0x7Fu
+#else
+#define Z_MUTEX_WAITERS_MSK 0x00u
+#define Z_MUTEX_COUNT_MSK   0xFFu
+#endif
+
 /**
  * @brief Kernel Mutex structure
  */
@@ -48,6 +65,9 @@ struct k_mutex {
      * 0 indicates the mutex is unlocked, any other value indicates it is locked.
      * If the CONFIG_KERNEL_REENTRANCY feature is enabled, this value represents
      * the number of times the mutex has been locked by the owning thread.
+     *
+     * If CONFIG_KERNEL_MUTEX_FAST_PATH is enabled, the Z_MUTEX_WAITERS_MSK bit is
+     * set when a thread starts waiting on the mutex.
      */
     uint8_t lock;
 
@@ -110,8 +130,9 @@ int8_t k_mutex_init(struct k_mutex *mutex);
  * the specified timeout expires.
  *
  * If the CONFIG_KERNEL_REENTRANCY feature is enabled, a thread can lock
- * the mutex multiple times, and must unlock it the same number of times.
- * Otherwise, a thread SHALL NOT lock a mutex it already owns.
+ * the mutex multiple times, and must unlock it the same number of times, up to
+ * Z_MUTEX_COUNT_MSK times. Otherwise, a thread SHALL NOT lock a mutex it
+ * already owns.
  *
  * Safety: This function is generally not safe to call from an ISR context
  *         if the timeout is different from K_NO_WAIT.
@@ -123,6 +144,8 @@ int8_t k_mutex_init(struct k_mutex *mutex);
  * @return 0 if the mutex was successfully locked, or an error code otherwise:
  *         - -EINVAL if the mutex pointer is NULL.
  *         - -ETIMEDOUT if the timeout expired before the mutex became available.
+ *         - -EOVERFLOW if the mutex is already locked Z_MUTEX_COUNT_MSK times by
+ *           the current thread (CONFIG_KERNEL_REENTRANCY).
  */
 __kernel int8_t k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
 
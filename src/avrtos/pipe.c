@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "pipe.h"
+
+#include <string.h>
+
+#include "kernel.h"
+#include "kernel_private.h"
+
+#define K_MODULE K_MODULE_PIPE
+
+/**
+ * @brief Wait record of a thread pending on a pipe.
+ *
+ * The record lives on the stack of the waiting thread and is referenced by its
+ * swap_data. The other side of the pipe copies data from/to the buffer of the
+ * record and updates the number of transferred bytes.
+ *
+ * Invariants:
+ * - if readers are waiting, the ring buffer is empty,
+ * - if writers are waiting, the ring buffer is full.
+ */
+struct z_pipe_wait {
+    uint8_t *buf;   ///< Buffer of the waiting thread
+    size_t len;     ///< Size of the buffer
+    size_t min_len; ///< Minimum number of bytes to transfer
+    size_t done;    ///< Number of bytes already transferred
+};
+
+/**
+ * @brief Get the first thread waiting on the waitqueue.
+ *
+ * Polling threads found at the head of the waitqueue are notified and removed,
+ * as the caller is about to make the pipe readable or writable.
+ *
+ * @return First waiting thread, or NULL if none.
+ */
+static struct k_thread *z_pipe_first_waiter(struct dnode *waitqueue)
+{
+    while (!DLIST_EMPTY(waitqueue)) {
+        struct dnode *const tie = waitqueue->head;
+
+#if CONFIG_POLLING
+        if (Z_WQHANDLE_OF_TIE(tie)->flags) {
+            z_unpend_first_thread(waitqueue);
+            continue;
+        }
+#endif /* CONFIG_POLLING */
+
+        return Z_THREAD_FROM_WQHANDLE_TIE(tie);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Get the number of bytes the threads waiting on the waitqueue can
+ * still transfer.
+ */
+static size_t z_pipe_waiters_remaining(struct dnode *waitqueue)
+{
+    size_t remaining = 0u;
+    struct dnode *tie;
+
+    DLIST_FOREACH(waitqueue, tie)
+    {
+#if CONFIG_POLLING
+        if (Z_WQHANDLE_OF_TIE(tie)->flags) {
+            continue;
+        }
+#endif /* CONFIG_POLLING */
+
+        struct z_pipe_wait *const wait = Z_THREAD_FROM_WQHANDLE_TIE(tie)->swap_data;
+        remaining += wait->len - wait->done;
+    }
+
+    return remaining;
+}
+
+static size_t z_pipe_ring_put(struct k_pipe *pipe, const uint8_t *src, size_t len)
+{
+    len               = MIN(len, pipe->size - pipe->used);
+    const size_t head = MIN(len, pipe->size - pipe->w);
+
+    memcpy(&pipe->buffer[pipe->w], src, head);
+    memcpy(pipe->buffer, src + head, len - head);
+
+    pipe->w += len;
+    if (pipe->w >= pipe->size) {
+        pipe->w -= pipe->size;
+    }
+    pipe->used += len;
+
+    return len;
+}
+
+static size_t z_pipe_ring_get(struct k_pipe *pipe, uint8_t *dst, size_t len)
+{
+    len               = MIN(len, pipe->used);
+    const size_t head = MIN(len, pipe->size - pipe->r);
+
+    memcpy(dst, &pipe->buffer[pipe->r], head);
+    memcpy(dst + head, pipe->buffer, len - head);
+
+    pipe->r += len;
+    if (pipe->r >= pipe->size) {
+        pipe->r -= pipe->size;
+    }
+    pipe->used -= len;
+
+    return len;
+}
+
+/**
+ * @brief Pend the current thread on the pipe until the transfer described by
+ * the wait record completes.
+ *
+ * @return Number of bytes transferred, or a negative error code if none.
+ */
+static int
+z_pipe_pend(struct dnode *waitqueue, struct z_pipe_wait *wait, k_timeout_t timeout)
+{
+    z_ker.current->swap_data = wait;
+
+    int ret = z_pend_current_on(waitqueue, timeout);
+
+    /* Bytes already transferred cannot be given back */
+    if ((ret == 0) || (wait->done != 0u)) {
+        ret = (int)wait->done;
+    }
+
+    return ret;
+}
+
+int8_t k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t size)
+{
+    if (!z_user(pipe && (buffer || !size)))
+        return -EINVAL;
+
+    dlist_init(&pipe->readers_wq);
+    dlist_init(&pipe->writers_wq);
+    pipe->buffer = buffer;
+    pipe->size   = size;
+    pipe->used   = 0u;
+    pipe->r      = 0u;
+    pipe->w      = 0u;
+
+    return 0;
+}
+
+int k_pipe_write(struct k_pipe *pipe,
+                 const void *data,
+                 size_t len,
+                 size_t min_len,
+                 k_timeout_t timeout)
+{
+    if (!z_user(pipe && (data || !len) && (min_len <= len) && (len <= INT16_MAX)))
+        return -EINVAL;
+
+    const uint8_t *const src = data;
+    struct k_thread *thread;
+    size_t done = 0u;
+    int ret;
+
+    const uint8_t key = irq_lock();
+
+    if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+        ((pipe->size - pipe->used) + z_pipe_waiters_remaining(&pipe->readers_wq) <
+         min_len)) {
+        ret = -EAGAIN;
+        goto exit;
+    }
+
+    /* Copy directly to the waiting readers */
+    while ((done < len) && ((thread = z_pipe_first_waiter(&pipe->readers_wq)) != NULL)) {
+        struct z_pipe_wait *const wait = thread->swap_data;
+        const size_t n                 = MIN(len - done, wait->len - wait->done);
+
+        memcpy(wait->buf + wait->done, src + done, n);
+        wait->done += n;
+        done += n;
+
+        if (wait->done >= wait->min_len) {
+            z_unpend_first_thread(&pipe->readers_wq);
+        }
+    }
+
+    /* Store the remainder in the ring buffer */
+    done += z_pipe_ring_put(pipe, src + done, len - done);
+
+    if (done >= min_len) {
+        ret = (int)done;
+    } else {
+        struct z_pipe_wait wait = {
+            .buf     = (uint8_t *)src,
+            .len     = len,
+            .min_len = min_len,
+            .done    = done,
+        };
+
+        ret = z_pipe_pend(&pipe->writers_wq, &wait, timeout);
+    }
+
+exit:
+    irq_unlock(key);
+
+    return ret;
+}
+
+int k_pipe_read(struct k_pipe *pipe,
+                void *data,
+                size_t len,
+                size_t min_len,
+                k_timeout_t timeout)
+{
+    if (!z_user(pipe && (data || !len) && (min_len <= len) && (len <= INT16_MAX)))
+        return -EINVAL;
+
+    uint8_t *const dst = data;
+    struct k_thread *thread;
+    size_t done;
+    int ret;
+
+    const uint8_t key = irq_lock();
+
+    if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+        (pipe->used + z_pipe_waiters_remaining(&pipe->writers_wq) < min_len)) {
+        ret = -EAGAIN;
+        goto exit;
+    }
+
+    /* Oldest data is in the ring buffer */
+    done = z_pipe_ring_get(pipe, dst, len);
+
+    /* Then copy directly from the waiting writers */
+    while ((done < len) && ((thread = z_pipe_first_waiter(&pipe->writers_wq)) != NULL)) {
+        struct z_pipe_wait *const wait = thread->swap_data;
+        const size_t n                 = MIN(len - done, wait->len - wait->done);
+
+        memcpy(dst + done, wait->buf + wait->done, n);
+        wait->done += n;
+        done += n;
+
+        if (wait->done == wait->len) {
+            z_unpend_first_thread(&pipe->writers_wq);
+        }
+    }
+
+    /* Refill the ring buffer from the waiting writers */
+    while ((pipe->used < pipe->size) &&
+           ((thread = z_pipe_first_waiter(&pipe->writers_wq)) != NULL)) {
+        struct z_pipe_wait *const wait = thread->swap_data;
+
+        wait->done +=
+            z_pipe_ring_put(pipe, wait->buf + wait->done, wait->len - wait->done);
+
+        if (wait->done == wait->len) {
+            z_unpend_first_thread(&pipe->writers_wq);
+        } else {
+            /* The ring buffer is full */
+            if (wait->done >= wait->min_len) {
+                z_unpend_first_thread(&pipe->writers_wq);
+            }
+            break;
+        }
+    }
+
+    if (done >= min_len) {
+        ret = (int)done;
+    } else {
+        struct z_pipe_wait wait = {
+            .buf     = dst,
+            .len     = len,
+            .min_len = min_len,
+            .done    = done,
+        };
+
+        ret = z_pipe_pend(&pipe->readers_wq, &wait, timeout);
+    }
+
+exit:
+    irq_unlock(key);
+
+    return ret;
+}
+
+int8_t k_pipe_reset(struct k_pipe *pipe)
+{
+    if (!z_user(pipe))
+        return -EINVAL;
+
+    int8_t ret;
+    const uint8_t key = irq_lock();
+
+    pipe->used = 0u;
+    pipe->r    = 0u;
+    pipe->w    = 0u;
+
+    ret = (int8_t)z_cancel_all_pending(&pipe->readers_wq);
+    ret += (int8_t)z_cancel_all_pending(&pipe->writers_wq);
+
+    irq_unlock(key);
+
+    return ret;
+}
+
+size_t k_pipe_read_avail(struct k_pipe *pipe)
+{
+    __ASSERT_NOTNULL(pipe);
+
+    return pipe->used;
+}
+
+size_t k_pipe_write_avail(struct k_pipe *pipe)
+{
+    __ASSERT_NOTNULL(pipe);
+
+    return pipe->size - pipe->used;
+}
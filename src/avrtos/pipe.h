@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Pipes
+ *
+ * A pipe is a byte stream between threads (or ISRs), for variable-length data
+ * which do not fit in fixed-size messages (k_msgq) or linked items (k_fifo).
+ *
+ * Data written to the pipe is copied directly into the buffer of a waiting
+ * reader if any (as k_msgq does), the remainder is stored in the ring buffer of
+ * the pipe. Symmetrically, a reader takes data from the ring buffer first, then
+ * directly from the buffer of a waiting writer.
+ *
+ * Each transfer is given a minimum length: the call returns as soon as at least
+ * `min_len` bytes (and at most `len` bytes) have been transferred. Using
+ * `min_len = 0` never blocks, using `min_len = len` transfers the whole buffer.
+ *
+ * Example Usage:
+ *
+ *   K_PIPE_DEFINE(pipe, 64u);
+ *
+ *   // Producer
+ *   k_pipe_write(&pipe, frame, frame_len, frame_len, K_FOREVER);
+ *
+ *   // Consumer, get whatever is available (at least 1 byte)
+ *   int n = k_pipe_read(&pipe, buf, sizeof(buf), 1u, K_MSEC(100));
+ *
+ * Limitations:
+ * - Transfers are limited to INT16_MAX bytes, the number of transferred bytes
+ *   being returned as an int.
+ *
+ * Related configuration options:
+ *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks
+ *  - CONFIG_POLLING: Enable k_poll() support (K_POLLFD_PIPE_READ/WRITE).
+ */
+
+#ifndef _AVRTOS_PIPE_H_
+#define _AVRTOS_PIPE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dstruct/dlist.h"
+#include "kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel Pipe structure
+ */
+struct k_pipe {
+    struct dnode readers_wq; ///< Threads waiting for data (the ring is empty)
+    struct dnode writers_wq; ///< Threads waiting for space (the ring is full)
+    uint8_t *buffer;         ///< Ring buffer
+    size_t size;             ///< Size of the ring buffer
+    size_t used;             ///< Number of bytes in the ring buffer
+    size_t r;                ///< Read index in the ring buffer
+    size_t w;                ///< Write index in the ring buffer
+};
+
+/**
+ * @brief Statically initialize a pipe.
+ *
+ * @param _name Name of the pipe.
+ * @param _buffer Ring buffer.
+ * @param _size Size of the ring buffer.
+ */
+#define Z_PIPE_INIT(_name, _buffer, _size)                                               \
+    {                                                                                    \
+        .readers_wq = DLIST_INIT(_name.readers_wq),                                      \
+        .writers_wq = DLIST_INIT(_name.writers_wq), .buffer = _buffer, .size = _size,    \
+        .used = 0u, .r = 0u, .w = 0u,                                                    \
+    }
+
+/**
+ * @brief Statically define and initialize a pipe with its ring buffer.
+ *
+ * @param _name Name of the pipe.
+ * @param _size Size of the ring buffer, can be 0 for direct transfers only.
+ */
+#define K_PIPE_DEFINE(_name, _size)                                                      \
+    uint8_t z_pipe_buf_##_name[_size];                                                   \
+    struct k_pipe _name = Z_PIPE_INIT(_name, z_pipe_buf_##_name, _size)
+
+/**
+ * @brief Initialize a pipe at runtime.
+ *
+ * @param pipe Pointer to the pipe.
+ * @param buffer Ring buffer, can be NULL if size is 0.
+ * @param size Size of the ring buffer.
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t size);
+
+/**
+ * @brief Write data to a pipe.
+ *
+ * Data is copied to the waiting readers first, then to the ring buffer. If
+ * less than `min_len` bytes could be written, the thread waits for readers to
+ * make room until the timeout expires.
+ *
+ * If `timeout` is K_NO_WAIT and less than `min_len` bytes can be written,
+ * nothing is written.
+ *
+ * Safety: This function is safe to call from an ISR context if the timeout
+ * is K_NO_WAIT.
+ *
+ * @param pipe Pointer to the pipe.
+ * @param data Data to write.
+ * @param len Number of bytes to write.
+ * @param min_len Minimum number of bytes to write before returning.
+ * @param timeout Timeout value.
+ * @return Number of bytes written (at least `min_len` unless the wait was
+ * interrupted), or a negative error code if no byte was written.
+ * @retval -EINVAL if an argument is invalid.
+ * @retval -EAGAIN if `min_len` bytes cannot be written and timeout is K_NO_WAIT.
+ * @retval -ETIMEDOUT if the timeout expired before any byte was written.
+ * @retval -ECANCELED if the wait was cancelled before any byte was written.
+ */
+__kernel int k_pipe_write(struct k_pipe *pipe,
+                          const void *data,
+                          size_t len,
+                          size_t min_len,
+                          k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe.
+ *
+ * Data is taken from the ring buffer first, then from the waiting writers. If
+ * less than `min_len` bytes could be read, the thread waits for writers until
+ * the timeout expires.
+ *
+ * If `timeout` is K_NO_WAIT and less than `min_len` bytes can be read, nothing
+ * is read.
+ *
+ * Safety: This function is safe to call from an ISR context if the timeout
+ * is K_NO_WAIT.
+ *
+ * @param pipe Pointer to the pipe.
+ * @param data Buffer to read to.
+ * @param len Size of the buffer.
+ * @param min_len Minimum number of bytes to read before returning.
+ * @param timeout Timeout value.
+ * @return Number of bytes read (at least `min_len` unless the wait was
+ * interrupted), or a negative error code if no byte was read.
+ * @retval -EINVAL if an argument is invalid.
+ * @retval -EAGAIN if `min_len` bytes cannot be read and timeout is K_NO_WAIT.
+ * @retval -ETIMEDOUT if the timeout expired before any byte was read.
+ * @retval -ECANCELED if the wait was cancelled before any byte was read.
+ */
+__kernel int k_pipe_read(struct k_pipe *pipe,
+                         void *data,
+                         size_t len,
+                         size_t min_len,
+                         k_timeout_t timeout);
+
+/**
+ * @brief Discard the content of a pipe and cancel all waiting threads.
+ *
+ * @param pipe Pointer to the pipe.
+ * @return Number of threads cancelled, or -EINVAL if the pointer is NULL.
+ */
+__kernel int8_t k_pipe_reset(struct k_pipe *pipe);
+
+/**
+ * @brief Get the number of bytes stored in the ring buffer of the pipe.
+ *
+ * @param pipe Pointer to the pipe.
+ * @return Number of bytes which can be read without waiting for a writer.
+ */
+__kernel size_t k_pipe_read_avail(struct k_pipe *pipe);
+
+/**
+ * @brief Get the free space in the ring buffer of the pipe.
+ *
+ * @param pipe Pointer to the pipe.
+ * @return Number of bytes which can be written without waiting for a reader.
+ */
+__kernel size_t k_pipe_write_avail(struct k_pipe *pipe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_PIPE_H_ */
@@ -26,6 +26,8 @@
 #include "avrtos/msgq.h"
 #include "avrtos/mutex.h"
 #include "avrtos/poll.h"
+#include "avrtos/pipe.h"
+#include "avrtos/rwlock.h"
 #include "avrtos/semaphore.h"
 
 /**
@@ -65,9 +67,11 @@ int8_t k_poll(struct k_pollfd *pfds, uint8_t nfds, k_timeout_t timeout)
             }
             break;
         case K_POLL_TYPE_MUTEX:
-            if (pfd->obj.mutex->lock != Z_MUTEX_UNLOCKED_VALUE) {
+            if ((pfd->obj.mutex->lock & Z_MUTEX_COUNT_MSK) != Z_MUTEX_UNLOCKED_VALUE) {
                 waitqueue            = &pfd->obj.mutex->waitqueue;
                 pfd->_wqhandle.flags = Z_WQ_FLAG_POLLIN;
+                /* Force the owner into the slow path when unlocking */
+                pfd->obj.mutex->lock |= Z_MUTEX_WAITERS_MSK;
             }
             break;
         case K_POLL_TYPE_FIFO:
@@ -94,6 +98,32 @@ int8_t k_poll(struct k_pollfd *pfds, uint8_t nfds, k_timeout_t timeout)
                 pfd->_wqhandle.flags = Z_WQ_FLAG_POLLIN;
             }
             break;
+        case K_POLL_TYPE_RWLOCK_READ:
+            if ((pfd->obj.rwlock->writer != NULL) ||
+                !DLIST_EMPTY(&pfd->obj.rwlock->writers_wq)) {
+                waitqueue            = &pfd->obj.rwlock->readers_wq;
+                pfd->_wqhandle.flags = Z_WQ_FLAG_POLLIN;
+            }
+            break;
+        case K_POLL_TYPE_RWLOCK_WRITE:
+            if ((pfd->obj.rwlock->writer != NULL) || (pfd->obj.rwlock->readers != 0u)) {
+                waitqueue            = &pfd->obj.rwlock->writers_wq;
+                pfd->_wqhandle.flags = Z_WQ_FLAG_POLLOUT;
+            }
+            break;
+        case K_POLL_TYPE_PIPE_READ:
+            if ((pfd->obj.pipe->used == 0u) && DLIST_EMPTY(&pfd->obj.pipe->writers_wq)) {
+                waitqueue            = &pfd->obj.pipe->readers_wq;
+                pfd->_wqhandle.flags = Z_WQ_FLAG_POLLIN;
+            }
+            break;
+        case K_POLL_TYPE_PIPE_WRITE:
+            if ((pfd->obj.pipe->used == pfd->obj.pipe->size) &&
+                DLIST_EMPTY(&pfd->obj.pipe->readers_wq)) {
+                waitqueue            = &pfd->obj.pipe->writers_wq;
+                pfd->_wqhandle.flags = Z_WQ_FLAG_POLLOUT;
+            }
+            break;
         default:
             ret = -EINVAL;
             pfd->revents |= K_POLL_ERR;
@@ -131,6 +161,10 @@ int8_t k_poll(struct k_pollfd *pfds, uint8_t nfds, k_timeout_t timeout)
         case K_POLL_TYPE_MSGQ_GET:
         case K_POLL_TYPE_MSGQ_PUT:
         case K_POLL_TYPE_MEM_SLAB:
+        case K_POLL_TYPE_RWLOCK_READ:
+        case K_POLL_TYPE_RWLOCK_WRITE:
+        case K_POLL_TYPE_PIPE_READ:
+        case K_POLL_TYPE_PIPE_WRITE:
             dlist_remove(&pfd->_wqhandle.tie);
             break;
         default:
@@ -24,6 +24,8 @@
 #include "avrtos/fifo.h"
 #include "avrtos/mem_slab.h"
 #include "avrtos/msgq.h"
+#include "avrtos/pipe.h"
+#include "avrtos/rwlock.h"
 #include "avrtos/types.h"
 
 #ifdef __cplusplus
@@ -56,6 +58,12 @@ typedef enum {
     K_POLL_TYPE_FIFO = 0x05, /**< Polling on a FIFO for available items */
     K_POLL_TYPE_MEM_SLAB =
         0x06, /**< Polling on a memory slab for available blocks (not implemented) */
+    K_POLL_TYPE_RWLOCK_READ =
+        0x07, /**< Polling on a read-write lock for availability for reading */
+    K_POLL_TYPE_RWLOCK_WRITE =
+        0x08, /**< Polling on a read-write lock for availability for writing */
+    K_POLL_TYPE_PIPE_READ  = 0x09, /**< Polling on a pipe for data to read */
+    K_POLL_TYPE_PIPE_WRITE = 0x0A, /**< Polling on a pipe for space to write */
 } k_poll_type_t;
 
 /**
@@ -73,6 +81,8 @@ struct k_pollfd {
         struct k_fifo *fifo;         /**< Pointer to a FIFO for polling */
         struct k_msgq *msgq;         /**< Pointer to a message queue for polling */
         struct k_mem_slab *mem_slab; /**< Pointer to a memory slab for polling */
+        struct k_rwlock *rwlock;     /**< Pointer to a read-write lock for polling */
+        struct k_pipe *pipe;         /**< Pointer to a pipe for polling */
     } obj;                           /**< Union of pointers to the objects being polled */
     z_wqhandle_t _wqhandle;          /**< Internal wait queue handle (private) */
     struct k_thread *_thread; /**< Pointer to the thread that is polling (private) */
@@ -90,6 +100,12 @@ struct k_pollfd {
 #define K_POLLFD_MSGQ_PUT(_msgq) K_POLLFD_INIT(K_POLL_TYPE_MSGQ_PUT, {.msgq = _msgq})
 #define K_POLLFD_MSGQ_GET(_msgq) K_POLLFD_INIT(K_POLL_TYPE_MSGQ_GET, {.msgq = _msgq})
 #define K_POLLFD_MEM_SLAB(_slab) K_POLLFD_INIT(K_POLL_TYPE_MEM_SLAB, {.mem_slab = _slab})
+#define K_POLLFD_RWLOCK_READ(_rwlock)                                                    \
+    K_POLLFD_INIT(K_POLL_TYPE_RWLOCK_READ, {.rwlock = _rwlock})
+#define K_POLLFD_RWLOCK_WRITE(_rwlock)                                                   \
+    K_POLLFD_INIT(K_POLL_TYPE_RWLOCK_WRITE, {.rwlock = _rwlock})
+#define K_POLLFD_PIPE_READ(_pipe)  K_POLLFD_INIT(K_POLL_TYPE_PIPE_READ, {.pipe = _pipe})
+#define K_POLLFD_PIPE_WRITE(_pipe) K_POLLFD_INIT(K_POLL_TYPE_PIPE_WRITE, {.pipe = _pipe})
 
 /**
  * @brief Poll multiple kernel objects for events.
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "post.h"
+
+#include "kernel.h"
+#include "kernel_private.h"
+
+#define K_MODULE K_MODULE_POST
+
+#if CONFIG_KERNEL_DEFERRED_POST
+
+/**
+ * @brief List of pending posts, in submission order.
+ */
+static SLIST_DEFINE(z_posts);
+
+int8_t k_post_init(struct k_post *post, k_post_type_t type, void *obj)
+{
+    if (!z_user(post && obj && (type <= K_POST_SIGNAL_RAISE)))
+        return -EINVAL;
+
+    post->type  = type;
+    post->count = 0u;
+    post->value = 0u;
+    post->obj   = obj;
+
+    return 0;
+}
+
+bool k_post_submit(struct k_post *post, k_flags_value_t value)
+{
+    __ASSERT_NOTNULL(post);
+
+    bool queued       = false;
+    const uint8_t key = irq_lock();
+
+    if (post->count == 0u) {
+        slist_append(&z_posts, &post->_tie);
+        post->value = 0u;
+        queued      = true;
+    }
+
+    /* Saturate the number of coalesced posts */
+    if (post->count != 0xFFu) {
+        post->count++;
+    }
+
+    if (post->type == K_POST_FLAGS_SET) {
+        post->value |= value;
+    } else {
+        post->value = value;
+    }
+
+    irq_unlock(key);
+
+    return queued;
+}
+
+__kernel uint8_t z_post_process(void)
+{
+    __ASSERT_NOINTERRUPT();
+
+    uint8_t woken = 0u;
+    struct snode *node;
+
+    while ((node = slist_get(&z_posts)) != NULL) {
+        struct k_post *const post = CONTAINER_OF(node, struct k_post, _tie);
+        uint8_t count             = post->count;
+
+        post->count = 0u;
+
+        switch (post->type) {
+        case K_POST_SEM_GIVE:
+            while (count--) {
+                if (k_sem_give(post->obj) != NULL) {
+                    woken++;
+                }
+            }
+            break;
+        case K_POST_FLAGS_SET: {
+            const int8_t ret = k_flags_notify(post->obj, post->value, K_FLAGS_SET);
+            if (ret > 0) {
+                woken += (uint8_t)ret;
+            }
+            break;
+        }
+        case K_POST_SIGNAL_RAISE: {
+            const int8_t ret = k_signal_raise(post->obj, (uint8_t)post->value);
+            if (ret > 0) {
+                woken += (uint8_t)ret;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return woken;
+}
+
+#endif /* CONFIG_KERNEL_DEFERRED_POST */
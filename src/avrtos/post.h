@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Deferred Posts (Bottom Half)
+ *
+ * A deferred post allows an ISR to request a wake-up operation on a kernel object
+ * (semaphore give, flags set, signal raise) without taking the full kernel path
+ * (unpend, wake up, schedule) from within the interrupt handler.
+ *
+ * Posting only appends the post to a pending list (or updates it if it is already
+ * pending), which is done in constant time. The actual operations are performed
+ * later in a batch by the kernel:
+ * - on the next thread switch (z_yield()),
+ * - on the next system tick,
+ * - or explicitly at ISR exit with k_post_yield_from_isr().
+ *
+ * Repeated posts of the same post before it is processed are coalesced:
+ * - semaphore gives are counted and given as many times as posted,
+ * - flags values are accumulated (OR-ed) and notified once,
+ * - the last signal value is raised once.
+ *
+ * Example Usage:
+ *
+ *  K_SEM_DEFINE(rx_sem, 0, 1);
+ *  K_POST_SEM_DEFINE(rx_post, rx_sem);
+ *
+ *  ISR(USART0_RX_vect)
+ *  {
+ *      ...
+ *      k_post_submit(&rx_post, 0u);
+ *      k_post_yield_from_isr();
+ *  }
+ *
+ * Limitations:
+ * - Operations are performed in kernel context (as timers and events), the
+ *   posted objects must not be used in a way requiring a user context.
+ *
+ * Related configuration options:
+ *  - CONFIG_KERNEL_DEFERRED_POST: Enables deferred posts.
+ *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks.
+ */
+
+#ifndef _AVRTOS_POST_H_
+#define _AVRTOS_POST_H_
+
+#include <stdint.h>
+
+#include "dstruct/slist.h"
+#include "flags.h"
+#include "kernel.h"
+#include "semaphore.h"
+#include "signal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Operation performed when a deferred post is processed.
+ */
+typedef enum {
+    K_POST_SEM_GIVE     = 0u, ///< Give a semaphore (struct k_sem)
+    K_POST_FLAGS_SET    = 1u, ///< Set bits of a flags object (struct k_flags)
+    K_POST_SIGNAL_RAISE = 2u, ///< Raise a signal (struct k_signal)
+} k_post_type_t;
+
+/**
+ * @brief Deferred post structure.
+ */
+struct k_post {
+    struct snode _tie;     ///< Item in the pending posts list
+    uint8_t type;          ///< Operation to perform (k_post_type_t)
+    uint8_t count;         ///< Number of coalesced posts, 0 if not pending
+    k_flags_value_t value; ///< Accumulated flags value or last signal value
+    void *obj;             ///< Kernel object the operation applies to
+};
+
+/**
+ * @brief Statically initialize a deferred post.
+ *
+ * @param _type Operation to perform (k_post_type_t).
+ * @param _obj Kernel object the operation applies to.
+ */
+#define Z_POST_INIT(_type, _obj)                                                         \
+    {                                                                                    \
+        ._tie = SNODE_INIT(), .type = _type, .count = 0u, .value = 0u,                   \
+        .obj = (void *)(_obj)                                                            \
+    }
+
+/**
+ * @brief Statically define a deferred post giving semaphore @a sem.
+ */
+#define K_POST_SEM_DEFINE(name, sem)                                                     \
+    struct k_post name = Z_POST_INIT(K_POST_SEM_GIVE, &sem)
+
+/**
+ * @brief Statically define a deferred post setting bits of flags object @a flags.
+ */
+#define K_POST_FLAGS_DEFINE(name, flags)                                                 \
+    struct k_post name = Z_POST_INIT(K_POST_FLAGS_SET, &flags)
+
+/**
+ * @brief Statically define a deferred post raising signal @a sig.
+ */
+#define K_POST_SIGNAL_DEFINE(name, sig)                                                  \
+    struct k_post name = Z_POST_INIT(K_POST_SIGNAL_RAISE, &sig)
+
+/**
+ * @brief Initialize a deferred post at runtime.
+ *
+ * The post must not be pending when (re)initialized.
+ *
+ * @param post Pointer to the post to initialize.
+ * @param type Operation to perform (k_post_type_t).
+ * @param obj Kernel object the operation applies to.
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+int8_t k_post_init(struct k_post *post, k_post_type_t type, void *obj);
+
+/**
+ * @brief Submit a deferred post.
+ *
+ * Appends the post to the pending list, or coalesces it with the pending one.
+ * This function executes in constant time and never wakes up a thread by itself.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param post Pointer to the post to submit.
+ * @param value Bits to set for K_POST_FLAGS_SET, value for K_POST_SIGNAL_RAISE,
+ *              ignored for K_POST_SEM_GIVE.
+ * @return true if the post was not already pending, false otherwise.
+ */
+bool k_post_submit(struct k_post *post, k_flags_value_t value);
+
+/**
+ * @brief Process all pending posts.
+ *
+ * Performs the operations of all pending posts in submission order. It is
+ * called automatically by the kernel on each thread switch and system tick.
+ *
+ * Assumptions: The interrupt flag is cleared when called.
+ *
+ * @return Number of threads woken up.
+ */
+__kernel uint8_t z_post_process(void);
+
+/**
+ * @brief Process pending posts at ISR exit and yield if a thread was woken up.
+ *
+ * This is the deferred counterpart of k_yield_from_isr_cond(): the interrupted
+ * thread is preempted only if processing the posts woke up at least one thread.
+ * It should be the last instruction in the interrupt routine.
+ */
+__always_inline void k_post_yield_from_isr(void)
+{
+    if (z_post_process() != 0u) {
+        k_yield_from_isr();
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_POST_H_ */
@@ -6,13 +6,15 @@
 
 #include "prng.h"
 
+#if CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_LFSR
+
 __kernel uint32_t z_shift_lfsr(uint32_t *lfsr, uint32_t poly_mask)
 {
-    uint32_t feedback = *lfsr & 1;
-    *lfsr >>= 1u;
-    if (feedback) {
-        *lfsr ^= poly_mask;
-    }
+    /* Branchless: the mask is all ones if the feedback bit is set */
+    const uint32_t feedback = -(*lfsr & 1u);
+
+    *lfsr = (*lfsr >> 1u) ^ (feedback & poly_mask);
+
     return *lfsr;
 }
 
@@ -43,3 +45,132 @@ void k_prng_get_buffer(struct k_prng *prng, uint8_t *buffer, uint16_t len)
     if (len & 1)
         buffer[len - 1] = (uint8_t)k_prng_get(prng);
 }
+
+#else
+
+#if CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_XORSHIFT32
+
+__always_inline uint32_t z_prng_next(struct k_prng *prng)
+{
+    uint32_t x = prng->state;
+
+    x ^= x << 13u;
+    x ^= x >> 17u;
+    x ^= x << 5u;
+
+    prng->state = x;
+
+    return x;
+}
+
+#else
+
+__always_inline uint32_t z_rotl(uint32_t x, uint8_t k)
+{
+    return (x << k) | (x >> (32u - k));
+}
+
+__always_inline uint32_t z_prng_next(struct k_prng *prng)
+{
+    uint32_t *const s = prng->s;
+
+    /* Multiplications by 5 and 9 as shifts and additions, the AVR has no
+     * 32-bit multiplier */
+    const uint32_t x      = (s[1] << 2u) + s[1];
+    const uint32_t y      = z_rotl(x, 7u);
+    const uint32_t result = (y << 3u) + y;
+    const uint32_t t      = s[1] << 9u;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = z_rotl(s[3], 11u);
+
+    return result;
+}
+
+#endif
+
+uint16_t k_prng_get(struct k_prng *prng)
+{
+    /* The upper bits have the best quality */
+    return (uint16_t)(z_prng_next(prng) >> 16u);
+}
+
+uint32_t k_prng_get_u32(struct k_prng *prng)
+{
+    return z_prng_next(prng);
+}
+
+void k_prng_get_buffer(struct k_prng *prng, uint8_t *buffer, uint16_t len)
+{
+    uint8_t *const end = buffer + len;
+
+    while ((uint16_t)(end - buffer) >= 4u) {
+        const uint32_t rdm = z_prng_next(prng);
+
+        buffer[0] = (uint8_t)rdm;
+        buffer[1] = (uint8_t)(rdm >> 8u);
+        buffer[2] = (uint8_t)(rdm >> 16u);
+        buffer[3] = (uint8_t)(rdm >> 24u);
+        buffer += 4u;
+    }
+
+    if (buffer != end) {
+        uint32_t rdm = z_prng_next(prng);
+
+        do {
+            *buffer++ = (uint8_t)rdm;
+            rdm >>= 8u;
+        } while (buffer != end);
+    }
+}
+
+#endif /* CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_LFSR */
+
+uint32_t k_prng_get_u32_locked(struct k_prng *prng)
+{
+    const uint8_t key  = irq_lock();
+    const uint32_t rdm = k_prng_get_u32(prng);
+    irq_unlock(key);
+
+    return rdm;
+}
+
+void k_prng_seed(struct k_prng *prng, uint32_t seed1, uint32_t seed2)
+{
+    *prng = (struct k_prng)K_PRNG_INITIALIZER(seed1, seed2);
+}
+
+void k_prng_mix(struct k_prng *prng, uint32_t entropy)
+{
+#if CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_LFSR
+    prng->lfsr32 ^= entropy;
+    prng->lfsr31 ^= entropy >> 1u;
+    /* A LFSR state cannot be 0 */
+    if (prng->lfsr32 == 0u) {
+        prng->lfsr32 = K_PRNG_DEFAULT_LFSR32;
+    }
+    if (prng->lfsr31 == 0u) {
+        prng->lfsr31 = K_PRNG_DEFAULT_LFSR31;
+    }
+#elif CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_XORSHIFT32
+    prng->state ^= entropy;
+    if (prng->state == 0u) {
+        prng->state = K_PRNG_DEFAULT_LFSR32;
+    }
+#else
+    prng->s[0] ^= entropy;
+    prng->s[1] ^= entropy;
+    if ((prng->s[0] | prng->s[1] | prng->s[2] | prng->s[3]) == 0u) {
+        prng->s[0] = K_PRNG_DEFAULT_LFSR32;
+    }
+#endif
+
+    /* Stir the state so close entropy values give unrelated sequences */
+    for (uint8_t i = 0u; i < 16u; i++) {
+        k_prng_get_u32(prng);
+    }
+}
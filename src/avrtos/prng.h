@@ -7,12 +7,21 @@
 /*
  * Pseudo-random number generator (PRNG)
  *
- * This module provides an implementation of a PRNG based on the LFSR algorithm as
- * described in the following sources:
- * - https://www.microchip.com/forums/tm.aspx?m=1117824&mpage=1
- * - https://www.maximintegrated.com/en/design/technical-documents/app-notes/4/4400.html
+ * This module provides an implementation of a PRNG, the algorithm is selected
+ * with CONFIG_KERNEL_PRNG_ALGORITHM:
+ * - LFSR (default), as described in the following sources:
+ *   - https://www.microchip.com/forums/tm.aspx?m=1117824&mpage=1
+ *   - https://www.maximintegrated.com/en/design/technical-documents/app-notes/4/4400.html
+ * - xorshift32 (Marsaglia, 13/17/5 triplet), 32 bits per step.
+ * - xoshiro128** (Blackman, Vigna), 32 bits per step.
+ *
+ * An instance is not protected against concurrent accesses: use an instance per
+ * thread, or k_prng_get_u32_locked() for an instance shared with ISRs.
  *
  * The PRNG is not cryptographically secure.
+ *
+ * Related configuration options:
+ * - CONFIG_KERNEL_PRNG_ALGORITHM: Algorithm of the PRNG
  */
 
 #ifndef _AVRTOS_PRNG_H
@@ -28,12 +37,24 @@
 extern "C" {
 #endif
 
+#define K_PRNG_ALGORITHM_LFSR         0
+#define K_PRNG_ALGORITHM_XORSHIFT32   1
+#define K_PRNG_ALGORITHM_XOSHIRO128SS 2
+
 /**
  * @brief Structure representing the state of the PRNG.
  */
 struct k_prng {
+#if CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_LFSR
     uint32_t lfsr32; /**< 32-bit LFSR state */
     uint32_t lfsr31; /**< 31-bit LFSR state */
+#elif CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_XORSHIFT32
+    uint32_t state; /**< xorshift32 state (never 0) */
+#elif CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_XOSHIRO128SS
+    uint32_t s[4u]; /**< xoshiro128** state (never all 0) */
+#else
+#error "invalid CONFIG_KERNEL_PRNG_ALGORITHM"
+#endif
 };
 
 /* Polynomial masks for the LFSRs */
@@ -47,13 +68,29 @@ struct k_prng {
 /**
  * @brief Macro to initialize a PRNG with specific seed values.
  *
+ * With xorshift32 and xoshiro128**, the state is derived from both seed values,
+ * it cannot be 0.
+ *
  * @param lfsr32_val Seed value for the 32-bit LFSR.
  * @param lfsr31_val Seed value for the 31-bit LFSR.
  */
+#if CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_LFSR
 #define K_PRNG_INITIALIZER(lfsr32_val, lfsr31_val)                                       \
     {                                                                                    \
         .lfsr32 = lfsr32_val, .lfsr31 = lfsr31_val                                       \
     }
+#elif CONFIG_KERNEL_PRNG_ALGORITHM == K_PRNG_ALGORITHM_XORSHIFT32
+#define K_PRNG_INITIALIZER(lfsr32_val, lfsr31_val)                                       \
+    {                                                                                    \
+        .state = ((uint32_t)(lfsr32_val) ^ (uint32_t)(lfsr31_val)) | 1u                  \
+    }
+#else
+#define K_PRNG_INITIALIZER(lfsr32_val, lfsr31_val)                                       \
+    {                                                                                    \
+        .s = {(uint32_t)(lfsr32_val), (uint32_t)(lfsr31_val), ~(uint32_t)(lfsr32_val),   \
+              ~(uint32_t)(lfsr31_val)}                                                   \
+    }
+#endif
 
 /**
  * @brief Macro to define a PRNG with specific seed values.
@@ -93,11 +130,21 @@ __kernel uint16_t k_prng_get(struct k_prng *prng);
  */
 __kernel uint32_t k_prng_get_u32(struct k_prng *prng);
 
+/**
+ * @brief Get a 32-bit pseudo-random number from a PRNG shared with ISRs.
+ *
+ * Same as k_prng_get_u32(), with the interrupts disabled.
+ *
+ * @param prng Pointer to the PRNG structure.
+ * @return A 32-bit pseudo-random number.
+ */
+__kernel uint32_t k_prng_get_u32_locked(struct k_prng *prng);
+
 /**
  * @brief Fill a buffer with pseudo-random data.
  *
  * This function fills the provided buffer with the specified length of pseudo-random
- * data.
+ * data, 32 bits at a time with xorshift32 and xoshiro128**.
  *
  * @param prng Pointer to the PRNG structure.
  * @param buffer Pointer to the buffer where the random data will be stored.
@@ -105,6 +152,27 @@ __kernel uint32_t k_prng_get_u32(struct k_prng *prng);
  */
 __kernel void k_prng_get_buffer(struct k_prng *prng, uint8_t *buffer, uint16_t len);
 
+/**
+ * @brief Reseed the PRNG, as K_PRNG_INITIALIZER().
+ *
+ * @param prng Pointer to the PRNG structure.
+ * @param seed1 First seed value.
+ * @param seed2 Second seed value.
+ */
+__kernel void k_prng_seed(struct k_prng *prng, uint32_t seed1, uint32_t seed2);
+
+/**
+ * @brief Mix entropy into the state of the PRNG.
+ *
+ * The entropy is xored into the state, which is then stirred, the sequence of
+ * an instance seeded with constant values can be made unique per device or per
+ * boot (e.g. with adc_entropy() or a serial number).
+ *
+ * @param prng Pointer to the PRNG structure.
+ * @param entropy Entropy value.
+ */
+__kernel void k_prng_mix(struct k_prng *prng, uint32_t entropy);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "pt.h"
+
+#include "kernel.h"
+#include "kernel_private.h"
+#include "systime.h"
+
+#if CONFIG_POLLING
+
+#define K_MODULE K_MODULE_PT
+
+int8_t k_pt_runner_init(struct k_pt_runner *runner,
+                        struct k_pollfd *pfds,
+                        uint8_t pfds_count)
+{
+    if (!z_user(runner && pfds && (pfds_count != 0u)))
+        return -EINVAL;
+
+    runner->tasks      = NULL;
+    runner->pfds       = pfds;
+    runner->pfds_count = pfds_count;
+
+    return k_sem_init(&runner->wake, 0u, 1u);
+}
+
+int8_t k_pt_start(struct k_pt_runner *runner,
+                  struct k_pt *pt,
+                  k_pt_handler_t handler,
+                  void *arg)
+{
+    if (!z_user(runner && pt && handler))
+        return -EINVAL;
+
+    pt->runner    = runner;
+    pt->handler   = handler;
+    pt->arg       = arg;
+    pt->lc        = 0u;
+    pt->flags     = Z_PT_FLAG_READY;
+    pt->event     = 0u;
+    pt->wait_type = 0u;
+    pt->wait_obj  = NULL;
+
+    const uint8_t key = irq_lock();
+    pt->next          = runner->tasks;
+    runner->tasks     = pt;
+    irq_unlock(key);
+
+    k_sem_give(&runner->wake);
+
+    return 0;
+}
+
+void k_pt_wake(struct k_pt *pt)
+{
+    pt->event = 1u;
+    k_sem_give(&pt->runner->wake);
+}
+
+int8_t z_pt_wait(struct k_pt *pt, uint8_t type, void *obj, k_timeout_t timeout)
+{
+    pt->wait_type = type;
+    pt->wait_obj  = obj;
+    pt->flags &= ~(Z_PT_FLAG_DEADLINE | Z_PT_FLAG_TIMED_OUT);
+
+    if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        pt->flags |= Z_PT_FLAG_TIMED_OUT;
+    } else if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+#if CONFIG_KERNEL_TICKS_COUNTER
+        pt->deadline = k_ticks_get_32() + K_TIMEOUT_TICKS(timeout);
+        pt->flags |= Z_PT_FLAG_DEADLINE;
+#else
+        /* Finite timeouts require the ticks counter, the wait is not started */
+        __ASSERT_TRUE(0);
+        pt->wait_type = 0u;
+        pt->flags |= Z_PT_FLAG_TIMED_OUT;
+        return -ENOTSUP;
+#endif
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Call the handlers of the ready tasks and fill the poll slots with the
+ * objects of the waiting ones.
+ *
+ * @param runner Pointer to the runner.
+ * @param timeout Set to the time until the nearest deadline.
+ * @return Number of poll slots used.
+ */
+static uint8_t z_pt_runner_pass(struct k_pt_runner *runner, k_timeout_t *timeout)
+{
+    struct k_pt **pprev = &runner->tasks;
+    struct k_pt *pt;
+    uint8_t nfds  = 1u;
+    bool again    = false;
+    bool overflow = false;
+#if CONFIG_KERNEL_TICKS_COUNTER
+    const uint32_t now = k_ticks_get_32();
+    uint32_t nearest   = UINT32_MAX;
+    bool deadline      = false;
+#endif
+
+    while ((pt = *pprev) != NULL) {
+#if CONFIG_KERNEL_TICKS_COUNTER
+        if ((pt->flags & Z_PT_FLAG_DEADLINE) && ((int32_t)(now - pt->deadline) >= 0)) {
+            pt->flags &= ~Z_PT_FLAG_DEADLINE;
+            pt->flags |= Z_PT_FLAG_TIMED_OUT | Z_PT_FLAG_READY;
+        }
+#endif
+
+        if ((pt->wait_type == Z_PT_WAIT_EVENT) && (pt->event != 0u)) {
+            pt->flags |= Z_PT_FLAG_READY;
+        }
+
+        if (pt->flags & Z_PT_FLAG_READY) {
+            pt->flags &= ~Z_PT_FLAG_READY;
+
+            const int8_t ret = pt->handler(pt);
+
+            if (ret == K_PT_EXITED) {
+                const uint8_t key = irq_lock();
+                /* Tasks may have been started (at the head) in the meantime */
+                while (*pprev != pt) {
+                    pprev = &(*pprev)->next;
+                }
+                *pprev = pt->next;
+                irq_unlock(key);
+                continue;
+            } else if (ret == K_PT_YIELDED) {
+                pt->flags |= Z_PT_FLAG_READY;
+            }
+        }
+
+        if (pt->flags & Z_PT_FLAG_READY) {
+            again = true;
+        } else if ((pt->wait_type != 0u) && (pt->wait_type != Z_PT_WAIT_EVENT)) {
+            if (nfds < runner->pfds_count) {
+                struct k_pollfd *pfd = &runner->pfds[nfds++];
+                pfd->type            = (k_poll_type_t)pt->wait_type;
+                pfd->obj.sem         = pt->wait_obj;
+                pfd->revents         = 0u;
+                pt->flags |= Z_PT_FLAG_POLLED;
+            } else {
+                /* No poll slot left, check the object again next tick */
+                pt->flags |= Z_PT_FLAG_READY;
+                overflow = true;
+            }
+        }
+
+#if CONFIG_KERNEL_TICKS_COUNTER
+        if (pt->flags & Z_PT_FLAG_DEADLINE) {
+            nearest  = MIN(nearest, pt->deadline - now);
+            deadline = true;
+        }
+#endif
+
+        pprev = &pt->next;
+    }
+
+    *timeout = K_FOREVER;
+#if CONFIG_KERNEL_TICKS_COUNTER
+    if (deadline) {
+        /* Longer delays are split, as (k_ticks_t)-1 is K_FOREVER */
+        *timeout = K_TICKS(MIN(nearest, (uint32_t)((k_ticks_t)-2)));
+    }
+#endif
+
+    if (again) {
+        *timeout = K_NO_WAIT;
+    } else if (overflow) {
+        *timeout = K_NEXT_TICK;
+    }
+
+    return nfds;
+}
+
+/**
+ * @brief Mark the tasks whose object became ready, the poll slots were filled
+ * in the order of the tasks.
+ */
+static void z_pt_runner_dispatch(struct k_pt_runner *runner, bool ready)
+{
+    struct k_pollfd *pfd = &runner->pfds[1u];
+
+    for (struct k_pt *pt = runner->tasks; pt != NULL; pt = pt->next) {
+        if (pt->flags & Z_PT_FLAG_POLLED) {
+            pt->flags &= ~Z_PT_FLAG_POLLED;
+            if (ready && (pfd->revents & K_POLL_READY)) {
+                pt->flags |= Z_PT_FLAG_READY;
+            }
+            pfd++;
+        }
+    }
+}
+
+void k_pt_runner_run(struct k_pt_runner *runner)
+{
+    struct k_pollfd *const wake = &runner->pfds[0u];
+
+    wake->type    = K_POLL_TYPE_SEM;
+    wake->obj.sem = &runner->wake;
+
+    for (;;) {
+        k_timeout_t timeout;
+        const uint8_t nfds = z_pt_runner_pass(runner, &timeout);
+
+        if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+            /* Some tasks yielded, let other threads run */
+            k_yield();
+        }
+
+        wake->revents    = 0u;
+        const int8_t ret = k_poll(runner->pfds, nfds, timeout);
+        if ((ret > 0) && (wake->revents & K_POLL_READY)) {
+            k_sem_take(&runner->wake, K_NO_WAIT);
+        }
+        z_pt_runner_dispatch(runner, ret > 0);
+    }
+}
+
+#endif /* CONFIG_POLLING */
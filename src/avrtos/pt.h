@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Stackless Tasks (Protothreads)
+ *
+ * A stackless task (k_pt) is a lightweight cooperative task which runs on the
+ * stack of a host thread, together with all the other tasks of its runner
+ * (k_pt_runner). A task costs a few bytes of RAM (no stack, no struct
+ * k_thread), making it suitable for large numbers of concurrent sessions or
+ * state machines on small MCUs.
+ *
+ * A task is a handler function called by the runner each time an event the
+ * task is waiting for occurs. Blocking macros (K_PT_SEM_TAKE(), K_PT_SLEEP(),
+ * ...) save the position of the task in its handler and return to the runner,
+ * the handler resumes at the same position when it is called again.
+ *
+ * The runner waits for the objects of all its waiting tasks at once with
+ * k_poll(), then calls the handlers of the tasks whose object became ready,
+ * whose timeout expired or which have been woken up with k_pt_wake().
+ *
+ * Example Usage:
+ *
+ *   K_PT_RUNNER_DEFINE(runner, 8u);
+ *   K_THREAD_DEFINE(pt_thread, k_pt_runner_run, 0x100, K_COOPERATIVE, &runner, 'P');
+ *
+ *   static int8_t session(struct k_pt *pt)
+ *   {
+ *       struct session *s = pt->arg;
+ *       struct snode *item;
+ *
+ *       K_PT_BEGIN(pt);
+ *       for (;;) {
+ *           K_PT_FIFO_GET(pt, &s->rx, K_SECONDS(5), item);
+ *           if (item == NULL) break;
+ *           s->count++;
+ *           K_PT_SLEEP(pt, K_MSEC(10));
+ *       }
+ *       K_PT_END(pt);
+ *   }
+ *
+ *   k_pt_start(&runner, &s->pt, session, s);
+ *
+ * Limitations:
+ * - Local variables of a handler are NOT preserved across blocking macros,
+ *   the state of a task must be kept in the structure pointed to by "arg".
+ * - Blocking macros are implemented with a switch statement (resumed with
+ *   the line number): only one blocking macro per line, and no switch
+ *   statement enclosing a blocking macro in a handler.
+ * - A task waits for at most one object at a time.
+ * - Tasks of a runner are not preempted by each other, a long handler delays
+ *   all the other tasks of the runner.
+ * - If more tasks are waiting for an object than the runner has poll slots,
+ *   the tasks in excess are polled at every tick.
+ * - Finite timeouts require CONFIG_KERNEL_UPTIME, otherwise the wait fails
+ *   immediately with -ENOTSUP (see the blocking macros).
+ *
+ * Related configuration options:
+ *  - CONFIG_POLLING: Required.
+ *  - CONFIG_KERNEL_UPTIME: Required for finite timeouts.
+ */
+
+#ifndef _AVRTOS_PT_H_
+#define _AVRTOS_PT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fifo.h"
+#include "kernel.h"
+#include "msgq.h"
+#include "poll.h"
+#include "semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handler return values
+ */
+#define K_PT_WAITING 0 ///< The task is waiting for an event
+#define K_PT_YIELDED 1 ///< The task wants to be called again as soon as possible
+#define K_PT_EXITED  2 ///< The task terminated
+
+#define Z_PT_FLAG_READY     (1u << 0) ///< The handler must be called
+#define Z_PT_FLAG_POLLED    (1u << 1) ///< The object of the task has a poll slot
+#define Z_PT_FLAG_DEADLINE  (1u << 2) ///< The wait has a timeout
+#define Z_PT_FLAG_TIMED_OUT (1u << 3) ///< The timeout of the wait expired
+
+/* Wait type of K_PT_WAIT_EVENT(), not a k_poll_type_t */
+#define Z_PT_WAIT_EVENT 0xFFu
+
+struct k_pt;
+struct k_pt_runner;
+
+/**
+ * @brief Task handler
+ *
+ * @param pt Pointer to the task.
+ * @return K_PT_WAITING, K_PT_YIELDED or K_PT_EXITED.
+ */
+typedef int8_t (*k_pt_handler_t)(struct k_pt *pt);
+
+/**
+ * @brief Stackless task structure
+ */
+struct k_pt {
+    struct k_pt *next;          ///< Next task of the runner (private)
+    struct k_pt_runner *runner; ///< Runner of the task
+    k_pt_handler_t handler;     ///< Handler of the task
+    void *arg;                  ///< User argument
+    uint16_t lc;                ///< Resume position in the handler (private)
+    uint8_t flags;              ///< Z_PT_FLAG_*, only modified by the runner (private)
+    volatile uint8_t event;     ///< Set by k_pt_wake() (private)
+    uint8_t wait_type;          ///< Type of the awaited object, 0 if none (private)
+    void *wait_obj;             ///< Awaited object (private)
+#if CONFIG_KERNEL_TICKS_COUNTER
+    uint32_t deadline; ///< Timeout of the wait in ticks (private)
+#endif
+};
+
+/**
+ * @brief Stackless task runner structure
+ */
+struct k_pt_runner {
+    struct k_pt *tasks;    ///< Started tasks
+    struct k_sem wake;     ///< Given when a task is started or woken up
+    struct k_pollfd *pfds; ///< Poll slots, the first one is for "wake"
+    uint8_t pfds_count;    ///< Number of poll slots
+};
+
+/**
+ * @brief Statically define and initialize a stackless task runner.
+ *
+ * The runner must then be run by a thread with k_pt_runner_run().
+ *
+ * @param _name Name of the runner.
+ * @param _max_waits Maximum number of tasks waiting for an object at the same
+ * time without being polled.
+ */
+#define K_PT_RUNNER_DEFINE(_name, _max_waits)                                            \
+    static struct k_pollfd z_pt_pfds_##_name[(_max_waits) + 1u];                         \
+    struct k_pt_runner _name = {                                                         \
+        .tasks      = NULL,                                                              \
+        .wake       = Z_SEM_INIT(_name.wake, 0u, 1u),                                    \
+        .pfds       = z_pt_pfds_##_name,                                                 \
+        .pfds_count = (_max_waits) + 1u,                                                 \
+    }
+
+/**
+ * @brief Initialize a stackless task runner at runtime.
+ *
+ * @param runner Pointer to the runner.
+ * @param pfds Array of poll slots.
+ * @param pfds_count Number of poll slots, at least 1.
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_pt_runner_init(struct k_pt_runner *runner,
+                                 struct k_pollfd *pfds,
+                                 uint8_t pfds_count);
+
+/**
+ * @brief Run the tasks of a runner, never returns.
+ *
+ * Can be used as the entry of the host thread (K_THREAD_DEFINE() context
+ * being the runner). The stack of the thread must be large enough for the
+ * deepest handler.
+ *
+ * @param runner Pointer to the runner.
+ */
+__kernel void k_pt_runner_run(struct k_pt_runner *runner);
+
+/**
+ * @brief Start a task on a runner.
+ *
+ * The handler is called for the first time on the next pass of the runner.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param runner Pointer to the runner.
+ * @param pt Pointer to the task, must not be already started.
+ * @param handler Handler of the task.
+ * @param arg User argument.
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+__kernel int8_t k_pt_start(struct k_pt_runner *runner,
+                           struct k_pt *pt,
+                           k_pt_handler_t handler,
+                           void *arg);
+
+/**
+ * @brief Wake up a task waiting with K_PT_WAIT_EVENT().
+ *
+ * The event is remembered if the task is not waiting yet.
+ *
+ * Safety: This function is safe to call from an ISR context.
+ *
+ * @param pt Pointer to the task.
+ */
+__kernel void k_pt_wake(struct k_pt *pt);
+
+/**
+ * @brief Check whether the last wait of a task timed out.
+ *
+ * @param pt Pointer to the task.
+ * @return true if the timeout expired before the event occurred.
+ */
+static inline bool k_pt_timed_out(struct k_pt *pt)
+{
+    return (pt->flags & Z_PT_FLAG_TIMED_OUT) != 0u;
+}
+
+/* Private, set up the wait of a task, -ENOTSUP if the timeout is finite and
+ * CONFIG_KERNEL_UPTIME is disabled. */
+__kernel int8_t z_pt_wait(struct k_pt *pt, uint8_t type, void *obj, k_timeout_t timeout);
+
+/* Private, consume the event of a task, events received in the meantime are
+ * merged. */
+static inline bool z_pt_event_take(struct k_pt *pt)
+{
+    if (pt->event != 0u) {
+        pt->event = 0u;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Begin the body of a task handler.
+ */
+#define K_PT_BEGIN(pt)                                                                   \
+    switch ((pt)->lc) {                                                                  \
+    case 0u:
+
+/**
+ * @brief End the body of a task handler, the task exits.
+ */
+#define K_PT_END(pt)                                                                     \
+    }                                                                                    \
+    (pt)->lc = 0u;                                                                       \
+    return K_PT_EXITED
+
+/**
+ * @brief Exit the task.
+ */
+#define K_PT_EXIT(pt)                                                                    \
+    do {                                                                                 \
+        (pt)->lc = 0u;                                                                   \
+        return K_PT_EXITED;                                                              \
+    } while (0)
+
+/**
+ * @brief Let the other tasks and threads run, the task is resumed on the next
+ * pass of the runner.
+ */
+#define K_PT_YIELD(pt)                                                                   \
+    do {                                                                                 \
+        (pt)->lc = __LINE__;                                                             \
+        return K_PT_YIELDED;                                                             \
+    case __LINE__:;                                                                      \
+    } while (0)
+
+/* Private, K_PT_WAIT_OBJ_UNTIL() executing the statement "err" if the wait
+ * cannot be started. */
+#define Z_PT_WAIT_OBJ_UNTIL(pt, type, obj, timeout, cond, err)                           \
+    do {                                                                                 \
+        if (z_pt_wait(pt, type, obj, timeout) != 0) {                                    \
+            err;                                                                         \
+            break;                                                                       \
+        }                                                                                \
+        (pt)->lc = __LINE__;                                                             \
+    case __LINE__:                                                                       \
+        if (cond) {                                                                      \
+            (pt)->flags &= ~Z_PT_FLAG_TIMED_OUT;                                         \
+        } else if (!k_pt_timed_out(pt)) {                                                \
+            return K_PT_WAITING;                                                         \
+        }                                                                                \
+        (pt)->wait_type = 0u;                                                            \
+        (pt)->flags &= ~Z_PT_FLAG_DEADLINE;                                              \
+    } while (0)
+
+/**
+ * @brief Wait until a condition is true, the condition is evaluated each time
+ * the object becomes ready.
+ *
+ * On timeout, the condition is false and k_pt_timed_out() returns true. If the
+ * timeout is finite and CONFIG_KERNEL_UPTIME is disabled, the task does not
+ * wait, the condition is not evaluated and k_pt_timed_out() returns true.
+ *
+ * @param pt Pointer to the task.
+ * @param type Type of the object (k_poll_type_t), 0 to wait for the timeout
+ * or an event only.
+ * @param obj Pointer to the object.
+ * @param timeout Maximum time to wait.
+ * @param cond Condition, typically an attempt to take the object with K_NO_WAIT.
+ */
+#define K_PT_WAIT_OBJ_UNTIL(pt, type, obj, timeout, cond)                                \
+    Z_PT_WAIT_OBJ_UNTIL(pt, type, obj, timeout, cond, (void)0)
+
+/**
+ * @brief Take a semaphore.
+ *
+ * @param ret Set to 0 on success, to a negative error code on timeout, to
+ * -ENOTSUP if the timeout is not supported.
+ */
+#define K_PT_SEM_TAKE(pt, sem, timeout, ret)                                             \
+    Z_PT_WAIT_OBJ_UNTIL(pt, K_POLL_TYPE_SEM, sem, timeout,                               \
+                        ((ret) = k_sem_take(sem, K_NO_WAIT)) == 0, (ret) = -ENOTSUP)
+
+/**
+ * @brief Get an item from a FIFO.
+ *
+ * @param item Set to the item, NULL on timeout or if the timeout is not
+ * supported.
+ */
+#define K_PT_FIFO_GET(pt, fifo, timeout, item)                                           \
+    Z_PT_WAIT_OBJ_UNTIL(pt, K_POLL_TYPE_FIFO, fifo, timeout,                             \
+                        ((item) = k_fifo_get(fifo, K_NO_WAIT)) != NULL, (item) = NULL)
+
+/**
+ * @brief Get a message from a message queue.
+ *
+ * @param data Buffer the message is copied to.
+ * @param ret Set to 0 on success, to a negative error code on timeout, to
+ * -ENOTSUP if the timeout is not supported.
+ */
+#define K_PT_MSGQ_GET(pt, msgq, data, timeout, ret)                                      \
+    Z_PT_WAIT_OBJ_UNTIL(pt, K_POLL_TYPE_MSGQ_GET, msgq, timeout,                         \
+                        ((ret) = k_msgq_get(msgq, data, K_NO_WAIT)) == 0,                \
+                        (ret) = -ENOTSUP)
+
+/**
+ * @brief Put a message in a message queue.
+ *
+ * @param data Message to copy.
+ * @param ret Set to 0 on success, to a negative error code on timeout, to
+ * -ENOTSUP if the timeout is not supported.
+ */
+#define K_PT_MSGQ_PUT(pt, msgq, data, timeout, ret)                                      \
+    Z_PT_WAIT_OBJ_UNTIL(pt, K_POLL_TYPE_MSGQ_PUT, msgq, timeout,                         \
+                        ((ret) = k_msgq_put(msgq, data, K_NO_WAIT)) == 0,                \
+                        (ret) = -ENOTSUP)
+
+/**
+ * @brief Wait for k_pt_wake() to be called on the task.
+ *
+ * On timeout, k_pt_timed_out() returns true.
+ */
+#define K_PT_WAIT_EVENT(pt, timeout)                                                     \
+    K_PT_WAIT_OBJ_UNTIL(pt, Z_PT_WAIT_EVENT, NULL, timeout, z_pt_event_take(pt))
+
+/**
+ * @brief Sleep for the given duration.
+ */
+#define K_PT_SLEEP(pt, timeout) K_PT_WAIT_OBJ_UNTIL(pt, 0u, NULL, timeout, false)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_PT_H_ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "rwlock.h"
+
+#include "kernel.h"
+#include "kernel_private.h"
+
+#define K_MODULE K_MODULE_RWLOCK
+
+/**
+ * @brief Wake up all threads waiting to read, the lock is given to all of them.
+ *
+ * Assumptions: The interrupt flag is cleared and the lock is not held for writing.
+ *
+ * @return First thread woken up, or NULL if none.
+ */
+static struct k_thread *z_rwlock_wake_readers(struct k_rwlock *rwlock)
+{
+    struct k_thread *first = NULL;
+    struct k_thread *thread;
+
+    /* Pollers are notified but not counted as readers */
+    while (!DLIST_EMPTY(&rwlock->readers_wq)) {
+        thread = z_unpend_first_thread(&rwlock->readers_wq);
+        if (thread != NULL) {
+            rwlock->readers++;
+            if (first == NULL) {
+                first = thread;
+            }
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Hand the free lock over to the first waiting writer, or to all
+ * waiting readers if no writer is waiting.
+ *
+ * Assumptions: The interrupt flag is cleared and the lock is not held.
+ *
+ * @return First thread woken up, or NULL if none.
+ */
+static struct k_thread *z_rwlock_wake(struct k_rwlock *rwlock)
+{
+    struct k_thread *thread;
+
+    /* Writers have preference, pollers are only notified */
+    while (!DLIST_EMPTY(&rwlock->writers_wq)) {
+        thread = z_unpend_first_thread(&rwlock->writers_wq);
+        if (thread != NULL) {
+            rwlock->writer = thread;
+            return thread;
+        }
+    }
+
+    return z_rwlock_wake_readers(rwlock);
+}
+
+int8_t k_rwlock_init(struct k_rwlock *rwlock)
+{
+    if (!z_user(rwlock))
+        return -EINVAL;
+
+    dlist_init(&rwlock->readers_wq);
+    dlist_init(&rwlock->writers_wq);
+    rwlock->readers = 0u;
+    rwlock->writer  = NULL;
+
+    return 0;
+}
+
+int8_t k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+    if (!z_user(rwlock))
+        return -EINVAL;
+
+    int8_t ret        = 0;
+    const uint8_t key = irq_lock();
+
+    if ((rwlock->writer == NULL) && DLIST_EMPTY(&rwlock->writers_wq)) {
+        rwlock->readers++;
+    } else {
+        /* On success, the reader has already been counted by the writer
+         * handing the lock over.
+         */
+        ret = z_pend_current_on(&rwlock->readers_wq, timeout);
+    }
+
+    irq_unlock(key);
+
+    return ret;
+}
+
+struct k_thread *k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+    if (!z_user(rwlock))
+        return NULL;
+
+    struct k_thread *thread = NULL;
+    const uint8_t key       = irq_lock();
+
+    __ASSERT_TRUE(rwlock->readers != 0u);
+
+    if (rwlock->readers != 0u) {
+        rwlock->readers--;
+        if (rwlock->readers == 0u) {
+            thread = z_rwlock_wake(rwlock);
+        }
+    }
+
+    irq_unlock(key);
+
+    return thread;
+}
+
+int8_t k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+    if (!z_user(rwlock))
+        return -EINVAL;
+
+    int8_t ret        = 0;
+    const uint8_t key = irq_lock();
+
+    if ((rwlock->writer == NULL) && (rwlock->readers == 0u)) {
+        rwlock->writer = z_ker.current;
+    } else if (rwlock->writer == z_ker.current) {
+        ret = -EBUSY;
+        goto exit;
+    } else {
+        /* On success, the lock has been handed over to us */
+        ret = z_pend_current_on(&rwlock->writers_wq, timeout);
+
+        if ((ret != 0) && (rwlock->writer == NULL) &&
+            DLIST_EMPTY(&rwlock->writers_wq)) {
+            /* We were the last waiting writer, readers blocked because of
+             * us can now share the lock.
+             */
+            z_rwlock_wake_readers(rwlock);
+        }
+    }
+
+#if CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK
+    if (ret == 0) {
+        k_sched_lock();
+    }
+#endif /* CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK */
+
+exit:
+    irq_unlock(key);
+    return ret;
+}
+
+struct k_thread *k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+    if (!z_user(rwlock))
+        return NULL;
+
+    struct k_thread *thread = NULL;
+    const uint8_t key       = irq_lock();
+
+    if (rwlock->writer != z_ker.current) {
+        /* Current thread does not hold the lock for writing */
+        goto exit;
+    }
+
+    rwlock->writer = NULL;
+    thread         = z_rwlock_wake(rwlock);
+
+#if CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK
+    k_sched_unlock();
+#endif /* CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK */
+
+exit:
+    irq_unlock(key);
+    return thread;
+}
+
+int8_t k_rwlock_cancel_wait(struct k_rwlock *rwlock)
+{
+    if (!z_user(rwlock))
+        return -EINVAL;
+
+    int8_t ret;
+    const uint8_t key = irq_lock();
+
+    ret = (int8_t)z_cancel_all_pending(&rwlock->writers_wq);
+    ret += (int8_t)z_cancel_all_pending(&rwlock->readers_wq);
+
+    irq_unlock(key);
+
+    return ret;
+}
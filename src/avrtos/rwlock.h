@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read-Write Locks
+ *
+ * A read-write lock protects shared data which is read often and written rarely.
+ * Any number of threads can hold the lock for reading at the same time, while a
+ * thread holding the lock for writing has exclusive access to the data.
+ *
+ * The lock gives preference to writers: as soon as a writer is waiting, new
+ * readers are blocked until the writer acquired and released the lock. This
+ * prevents writers from being starved by a continuous flow of readers.
+ *
+ * As for mutexes, the lock is handed over directly to the woken up thread(s)
+ * on release: a writer is woken up first if any, otherwise all waiting readers
+ * are woken up at once.
+ *
+ * Example Usage:
+ *
+ *   K_RWLOCK_DEFINE(table_lock);
+ *
+ *   k_rwlock_read_lock(&table_lock, K_FOREVER);
+ *   // ... lookup ...
+ *   k_rwlock_read_unlock(&table_lock);
+ *
+ *   k_rwlock_write_lock(&table_lock, K_FOREVER);
+ *   // ... update ...
+ *   k_rwlock_write_unlock(&table_lock);
+ *
+ * Limitations:
+ * - The lock is not reentrant, a writer cannot lock it again for reading or
+ *   writing.
+ * - Readers are not tracked individually, k_rwlock_read_unlock() must only be
+ *   called by a thread holding the lock for reading.
+ *
+ * Related configuration options:
+ *  - CONFIG_KERNEL_ARGS_CHECKS: Enable argument checks
+ *  - CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK: Lock the scheduler while holding the
+ *    lock for writing.
+ *  - CONFIG_POLLING: Enable k_poll() support (K_POLLFD_RWLOCK_READ/WRITE).
+ */
+
+#ifndef _AVRTOS_RWLOCK_H_
+#define _AVRTOS_RWLOCK_H_
+
+#include <stdint.h>
+
+#include "kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel Read-Write Lock structure
+ */
+struct k_rwlock {
+    /**
+     * @brief Wait queue for threads waiting to acquire the lock for reading.
+     */
+    struct dnode readers_wq;
+
+    /**
+     * @brief Wait queue for threads waiting to acquire the lock for writing.
+     *
+     * If not empty, new readers are blocked (writer preference).
+     */
+    struct dnode writers_wq;
+
+    /**
+     * @brief Number of threads currently holding the lock for reading.
+     */
+    uint8_t readers;
+
+    /**
+     * @brief Thread currently holding the lock for writing, NULL if none.
+     */
+    struct k_thread *writer;
+};
+
+/**
+ * @brief Statically initialize a read-write lock.
+ *
+ * @param _name The read-write lock structure to be initialized.
+ */
+#define Z_RWLOCK_INIT(_name)                                                             \
+    {                                                                                    \
+        .readers_wq = DLIST_INIT(_name.readers_wq),                                      \
+        .writers_wq = DLIST_INIT(_name.writers_wq), .readers = 0u, .writer = NULL        \
+    }
+
+/**
+ * @brief Statically define and initialize a read-write lock.
+ *
+ * @param _name Name of the read-write lock structure.
+ */
+#define K_RWLOCK_DEFINE(_name) struct k_rwlock _name = Z_RWLOCK_INIT(_name)
+
+/**
+ * @brief Initialize a read-write lock at runtime.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @return 0 on success, -EINVAL if the pointer is NULL.
+ */
+int8_t k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a read-write lock for reading.
+ *
+ * The lock is acquired immediately if no thread holds it for writing and no
+ * writer is waiting for it. Otherwise the thread waits until a writer hands
+ * the lock over to the readers or until the timeout expires.
+ *
+ * Safety: This function is not safe to call from an ISR context if the timeout
+ * is different from K_NO_WAIT.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @param timeout Timeout value.
+ * @return 0 on success, negative error code on failure.
+ * @retval -EINVAL if the pointer is NULL.
+ * @retval -EAGAIN if the lock is not available and the timeout is K_NO_WAIT.
+ * @retval -ETIMEDOUT if the timeout expired.
+ * @retval -ECANCELED if the wait was cancelled.
+ */
+__kernel int8_t k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a read-write lock held for reading.
+ *
+ * If the calling thread is the last reader, the lock is handed over to the
+ * first waiting writer.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @return Thread woken up, or NULL if none (see k_yield_from_isr_cond()).
+ */
+__kernel struct k_thread *k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a read-write lock for writing.
+ *
+ * The lock is acquired immediately if it is not held by any thread. Otherwise
+ * the thread waits until the lock is handed over to it or until the timeout
+ * expires. While the thread is waiting, new readers are blocked.
+ *
+ * If CONFIG_KERNEL_RWLOCK_WRITER_SCHED_LOCK is enabled, the scheduler is locked
+ * for the writer until it releases the lock.
+ *
+ * Safety: This function is not safe to call from an ISR context if the timeout
+ * is different from K_NO_WAIT.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @param timeout Timeout value.
+ * @return 0 on success, negative error code on failure.
+ * @retval -EINVAL if the pointer is NULL.
+ * @retval -EBUSY if the calling thread already holds the lock for writing.
+ * @retval -EAGAIN if the lock is not available and the timeout is K_NO_WAIT.
+ * @retval -ETIMEDOUT if the timeout expired.
+ * @retval -ECANCELED if the wait was cancelled.
+ */
+__kernel int8_t k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a read-write lock held for writing.
+ *
+ * The lock is handed over to the first waiting writer if any, otherwise all
+ * waiting readers are woken up.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @return First thread woken up, or NULL if none (see k_yield_from_isr_cond()).
+ */
+__kernel struct k_thread *k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Cancel all threads waiting on a read-write lock.
+ *
+ * Waiting threads return -ECANCELED.
+ *
+ * @param rwlock Pointer to the read-write lock.
+ * @return Number of threads cancelled, or -EINVAL if the pointer is NULL.
+ */
+__kernel int8_t k_rwlock_cancel_wait(struct k_rwlock *rwlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_RWLOCK_H_ */
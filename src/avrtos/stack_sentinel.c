@@ -11,6 +11,10 @@
 #include "avrtos/sys.h"
 #include "fault.h"
 
+/* Stack information is not stored with CONFIG_THREAD_COMPACT, unless
+ * CONFIG_THREAD_STACK_SENTINEL is enabled */
+#if Z_THREAD_STACK_INFO
+
 #if CONFIG_AVRTOS_LINKER_SCRIPT
 extern struct k_thread __k_threads_start;
 extern struct k_thread __k_threads_end;
@@ -71,4 +75,6 @@ bool k_verify_stack_sentinel(struct k_thread *thread)
     }
 
     return z_thread_verify_sent(thread);
-}
\ No newline at end of file
+}
+
+#endif /* Z_THREAD_STACK_INFO */
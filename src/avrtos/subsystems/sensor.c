@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sensor.h"
+
+#include <avrtos/systime.h>
+
+#if CONFIG_I2C_QUEUE && CONFIG_KERNEL_TICKS_COUNTER
+
+int8_t sensor_engine_init(struct sensor_engine *engine,
+                          I2C_Device *i2c,
+                          struct k_msgq *msgq,
+                          k_timeout_t window)
+{
+    if (!z_user(engine && i2c && msgq &&
+                (msgq->msg_size == sizeof(struct sensor_sample))))
+        return -EINVAL;
+
+    engine->i2c      = i2c;
+    engine->msgq     = msgq;
+    engine->head     = NULL;
+    engine->window   = K_TIMEOUT_TICKS(window);
+    engine->dropped  = 0u;
+    engine->timeouts = 0u;
+
+    k_sem_init(&engine->done, 0u, 1u);
+
+    return k_sem_init(&engine->wake, 0u, 1u);
+}
+
+int8_t sensor_register(struct sensor_engine *engine,
+                       struct sensor *sensor,
+                       k_timeout_t period,
+                       uint8_t decimation)
+{
+    if (!z_user(engine && sensor && sensor->decode && (decimation != 0u) &&
+                (K_TIMEOUT_TICKS(period) != 0u)))
+        return -EINVAL;
+
+    sensor->period     = K_TIMEOUT_TICKS(period);
+    sensor->next_tick  = k_ticks_get_32();
+    sensor->decimation = decimation;
+    sensor->count      = 0u;
+    sensor->errors     = 0u;
+
+    const uint8_t key = irq_lock();
+    sensor->next      = engine->head;
+    engine->head      = sensor;
+    irq_unlock(key);
+
+    k_sem_give(&engine->wake);
+
+    return 0;
+}
+
+static void
+sensor_deliver(struct sensor_engine *engine, struct sensor *sensor, uint32_t now)
+{
+    struct sensor_sample sample = {
+        .timestamp = now,
+        .id        = sensor->id,
+        .count     = sensor->count,
+        .min       = sensor->min,
+        .max       = sensor->max,
+        .mean      = (int16_t)(sensor->sum / sensor->count),
+    };
+
+    if (k_msgq_put(engine->msgq, &sample, K_NO_WAIT) != 0) {
+        engine->dropped++;
+    }
+
+    sensor->count = 0u;
+}
+
+static void
+sensor_aggregate(struct sensor_engine *engine, struct sensor *sensor, uint32_t now)
+{
+    int16_t value;
+
+    if ((sensor->xfer.status != 0) || (sensor->decode(sensor, &value) != 0)) {
+        if (sensor->errors != UINT8_MAX) {
+            sensor->errors++;
+        }
+        return;
+    }
+
+    if (sensor->count == 0u) {
+        sensor->min = value;
+        sensor->max = value;
+        sensor->sum = 0;
+    } else {
+        sensor->min = MIN(sensor->min, value);
+        sensor->max = MAX(sensor->max, value);
+    }
+    sensor->sum += value;
+
+    if (++sensor->count == sensor->decimation) {
+        sensor_deliver(engine, sensor, now);
+    }
+}
+
+/* Whether the sensor is due before the given time */
+__always_inline bool sensor_due(struct sensor *sensor, uint32_t tick)
+{
+    return (int32_t)(tick - sensor->next_tick) >= 0;
+}
+
+k_timeout_t sensor_engine_process(struct sensor_engine *engine)
+{
+    struct sensor *sensor;
+    struct sensor *last = NULL;
+    const uint32_t now  = k_ticks_get_32();
+    const uint32_t edge = now + engine->window;
+
+    /* Sensors registered in the meantime are processed on the next call */
+    struct sensor *const head = engine->head;
+
+    /* Queue the reads of the burst */
+    for (sensor = head; sensor != NULL; sensor = sensor->next) {
+        if (!sensor_due(sensor, edge)) {
+            continue;
+        }
+
+        sensor->xfer.done = &engine->done;
+
+        const int8_t ret = i2c_submit(engine->i2c, &sensor->xfer);
+        if (ret == 0) {
+            last = sensor;
+        } else if (ret != -EBUSY) {
+            /* The read is reported as failed, a read still in progress
+             * (-EBUSY) already is */
+            sensor->xfer.status = ret;
+        }
+    }
+
+    /* Transactions of a bus are processed in order, the burst ends with the
+     * last queued one */
+    while ((last != NULL) && (last->xfer.status == -EINPROGRESS)) {
+        if (k_sem_take(&engine->done, K_MSEC(CONFIG_SENSOR_BURST_TIMEOUT_MS)) != 0) {
+            /* The reads still in progress are reported as failed */
+            engine->timeouts++;
+            break;
+        }
+    }
+
+    uint32_t nearest = UINT32_MAX;
+    for (sensor = head; sensor != NULL; sensor = sensor->next) {
+        if (sensor_due(sensor, edge)) {
+            sensor_aggregate(engine, sensor, now);
+
+            sensor->next_tick += sensor->period;
+            if (sensor_due(sensor, now)) {
+                /* Late by more than a period, skip the missed reads */
+                sensor->next_tick = now + sensor->period;
+            }
+        }
+
+        nearest = MIN(nearest, sensor->next_tick - now);
+    }
+
+    if (nearest == UINT32_MAX) {
+        return K_FOREVER;
+    }
+
+    /* Longer delays are split, as (k_ticks_t)-1 is K_FOREVER */
+    return K_TICKS(MIN(nearest, (uint32_t)((k_ticks_t)-2)));
+}
+
+void sensor_engine_run(struct sensor_engine *engine)
+{
+    for (;;) {
+        const k_timeout_t timeout = sensor_engine_process(engine);
+
+        /* Woken up early when a sensor is registered */
+        k_sem_take(&engine->wake, timeout);
+    }
+}
+
+#endif /* CONFIG_I2C_QUEUE && CONFIG_KERNEL_TICKS_COUNTER */
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sensor acquisition engine
+ *
+ * A single thread samples all the registered I2C sensors: each sensor has a
+ * sampling period and an I2C transaction (struct i2c_xfer) which reads its raw
+ * data. The reads due at the same time (within the batching window of the
+ * engine) are queued at once to the I2C driver and processed back-to-back
+ * from the TWI interrupt, the thread sleeps until the end of the burst (at
+ * most CONFIG_SENSOR_BURST_TIMEOUT_MS between two completions).
+ *
+ * The raw data of each read is converted to a value by the decode routine of
+ * the sensor, values are aggregated (min/max/mean) over "decimation" samples
+ * and the aggregates are delivered to a message queue of struct sensor_sample.
+ *
+ * Example Usage:
+ *
+ *   K_MSGQ_DEFINE(samples, sizeof(struct sensor_sample), 8u);
+ *   static struct sensor_engine engine;
+ *   static struct tcn75_sensor temp;
+ *
+ *   sensor_engine_init(&engine, I2C0, &samples, K_MSEC(10));
+ *   tcn75_sensor_init(&temp, &tcn75, 0u);
+ *   sensor_register(&engine, &temp.sensor, K_MSEC(100), 10u);
+ *
+ *   // in a dedicated thread
+ *   sensor_engine_run(&engine);
+ *
+ *   // consumers
+ *   struct sensor_sample s;
+ *   k_msgq_get(&samples, &s, K_FOREVER);
+ *
+ * Limitations:
+ * - Periods are limited to the range of k_ticks_t.
+ * - A sensor cannot be unregistered.
+ *
+ * Related configuration options:
+ *  - CONFIG_I2C_QUEUE: Required, I2C transaction queue
+ *  - CONFIG_KERNEL_UPTIME: Required, ticks counter for the timestamps
+ *  - CONFIG_SENSOR_BURST_TIMEOUT_MS: Maximum wait for a completion of a burst
+ */
+
+#ifndef _AVRTOS_SUBSYSTEMS_SENSOR_H_
+#define _AVRTOS_SUBSYSTEMS_SENSOR_H_
+
+#include <stdint.h>
+
+#include <avrtos/drivers/i2c.h>
+#include <avrtos/kernel.h>
+#include <avrtos/msgq.h>
+#include <avrtos/semaphore.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sensor;
+
+/**
+ * @brief Convert the raw data of a completed read to a value.
+ *
+ * @param sensor Sensor which was read.
+ * @param value Value to set.
+ * @return 0 if the value is valid, negative value otherwise.
+ */
+typedef int8_t (*sensor_decode_t)(struct sensor *sensor, int16_t *value);
+
+/**
+ * @brief Sensor structure
+ */
+struct sensor {
+    struct sensor *next;    ///< Next registered sensor (private)
+    struct i2c_xfer xfer;   ///< Read transaction, set by the device driver
+    sensor_decode_t decode; ///< Decode routine, set by the device driver
+    uint8_t id;             ///< Identifier of the samples
+
+    k_ticks_t period;   ///< Sampling period
+    uint32_t next_tick; ///< Time of the next read
+    uint8_t decimation; ///< Number of values aggregated in a sample
+    uint8_t count;      ///< Number of values aggregated so far
+    int16_t min;        ///< Minimum of the aggregated values
+    int16_t max;        ///< Maximum of the aggregated values
+    int32_t sum;        ///< Sum of the aggregated values
+    uint8_t errors;     ///< Number of failed reads or decodes (saturated at 255)
+};
+
+/**
+ * @brief Sample delivered to the message queue of the engine
+ */
+struct sensor_sample {
+    uint32_t timestamp; ///< Time (in ticks) of the burst of the last value
+    uint8_t id;         ///< Identifier of the sensor
+    uint8_t count;      ///< Number of values aggregated
+    int16_t min;        ///< Minimum value
+    int16_t max;        ///< Maximum value
+    int16_t mean;       ///< Mean value
+};
+
+/**
+ * @brief Sensor acquisition engine structure
+ */
+struct sensor_engine {
+    I2C_Device *i2c;      ///< I2C bus of the sensors
+    struct k_msgq *msgq;  ///< Queue of struct sensor_sample
+    struct sensor *head;  ///< Registered sensors
+    k_ticks_t window;     ///< Sensors due within the window are read early
+    struct k_sem wake;    ///< Given when a sensor is registered
+    struct k_sem done;    ///< Given on each completed read of a burst
+    uint16_t dropped;     ///< Number of samples dropped (queue full)
+    uint16_t timeouts;    ///< Number of bursts not completed in time
+};
+
+/**
+ * @brief Initialize a sensor acquisition engine.
+ *
+ * @param engine Pointer to the engine.
+ * @param i2c I2C bus of the sensors, must be initialized.
+ * @param msgq Message queue receiving the samples (struct sensor_sample).
+ * @param window Batching window, the sensors due within this delay after
+ * the first due sensor are read in the same burst.
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+int8_t sensor_engine_init(struct sensor_engine *engine,
+                          I2C_Device *i2c,
+                          struct k_msgq *msgq,
+                          k_timeout_t window);
+
+/**
+ * @brief Register a sensor, its first read is done immediately.
+ *
+ * The transaction and the decode routine of the sensor must be set (e.g.
+ * tcn75_sensor_init()).
+ *
+ * @param engine Pointer to the engine.
+ * @param sensor Pointer to the sensor.
+ * @param period Sampling period.
+ * @param decimation Number of values aggregated in a sample (at least 1).
+ * @return 0 on success, -EINVAL if an argument is invalid.
+ */
+int8_t sensor_register(struct sensor_engine *engine,
+                       struct sensor *sensor,
+                       k_timeout_t period,
+                       uint8_t decimation);
+
+/**
+ * @brief Read the due sensors in a single burst and deliver their samples.
+ *
+ * @param engine Pointer to the engine.
+ * @return Delay until the next sensor is due.
+ */
+k_timeout_t sensor_engine_process(struct sensor_engine *engine);
+
+/**
+ * @brief Run the engine forever, can be used as a thread entry.
+ *
+ * @param engine Pointer to the engine.
+ */
+void sensor_engine_run(struct sensor_engine *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AVRTOS_SUBSYSTEMS_SENSOR_H_ */
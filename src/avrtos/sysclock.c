@@ -6,6 +6,7 @@
 
 #include "defines.h"
 #include "drivers/timer.h"
+#include "systime.h"
 
 #if (CONFIG_KERNEL_SYSCLOCK_PERIOD_US < 100)
 #warning SYSCLOCK is probably too fast !
@@ -115,4 +116,89 @@ void z_init_sysclock(void)
 #else
 #error "invalid timer type"
 #endif
-}
\ No newline at end of file
+}
+
+#if CONFIG_KERNEL_TICKS_COUNTER
+
+/* Conversion of the counter of the sysclock timer to microseconds */
+#define CYCLES_PER_US (F_CPU / 1000000lu)
+
+#if F_CPU % 1000000lu != 0
+#define COUNTER_TO_US(_cnt)                                                              \
+    ((uint32_t)(((uint64_t)(_cnt) * PRESCALER_VALUE * 1000000lu) / F_CPU))
+#elif PRESCALER_VALUE % CYCLES_PER_US == 0
+#define COUNTER_TO_US(_cnt) ((uint32_t)(_cnt) * (PRESCALER_VALUE / CYCLES_PER_US))
+#elif CYCLES_PER_US % PRESCALER_VALUE == 0
+#define COUNTER_TO_US(_cnt) ((uint32_t)(_cnt) / (CYCLES_PER_US / PRESCALER_VALUE))
+#else
+#define COUNTER_TO_US(_cnt) (((uint32_t)(_cnt) * PRESCALER_VALUE) / CYCLES_PER_US)
+#endif
+
+__always_inline uint16_t sysclock_get_counter(void)
+{
+#if TIMER_INDEX_IS_16BIT(CONFIG_KERNEL_SYSLOCK_HW_TIMER)
+    return ll_timer16_get_tcnt(timer_get_device(CONFIG_KERNEL_SYSLOCK_HW_TIMER));
+#else
+    return ((TIMER8_Device *)timer_get_device(CONFIG_KERNEL_SYSLOCK_HW_TIMER))->TCNTn;
+#endif
+}
+
+/**
+ * @brief Read the ticks counter and the counter of the timer consistently.
+ *
+ * The read is retried if a tick occurs in the meantime. If the interrupts are
+ * disabled (or the tick is about to be handled), the compare match flag tells
+ * that the timer wrapped but the tick is not counted yet.
+ *
+ * @param counter Counter of the timer within the tick.
+ * @param full Read the whole ticks counter (64-bit) or only 32 bits.
+ * @return Ticks counter.
+ */
+__always_inline uint64_t sysclock_sample(uint16_t *counter, bool full)
+{
+    uint64_t ticks;
+    uint16_t cnt;
+    bool pending;
+
+    do {
+        ticks   = full ? k_ticks_get_64() : k_ticks_get_32();
+        cnt     = sysclock_get_counter();
+        pending = TIFRn[CONFIG_KERNEL_SYSLOCK_HW_TIMER] & BIT(OCFnA);
+
+        if (pending) {
+            /* Read the counter again, after it wrapped */
+            cnt = sysclock_get_counter();
+        }
+    } while ((uint32_t)ticks != k_ticks_get_32());
+
+    if (pending) {
+        /* The flag is set as the counter reaches its top value, before it
+         * is cleared */
+        if (cnt == COUNTER_VALUE) {
+            cnt = 0u;
+        }
+        ticks++;
+    }
+
+    *counter = cnt;
+
+    return ticks;
+}
+
+uint64_t k_uptime_get_us64(void)
+{
+    uint16_t counter;
+    const uint64_t ticks = sysclock_sample(&counter, true);
+
+    return k_ticks_to_us64(ticks) + COUNTER_TO_US(counter);
+}
+
+uint32_t k_uptime_get_us32(void)
+{
+    uint16_t counter;
+    const uint32_t ticks = (uint32_t)sysclock_sample(&counter, false);
+
+    return ticks * (uint32_t)K_TICKS_US + COUNTER_TO_US(counter);
+}
+
+#endif /* CONFIG_KERNEL_TICKS_COUNTER */
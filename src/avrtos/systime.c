@@ -15,29 +15,23 @@
 uint32_t k_uptime_get(void)
 {
 #if CONFIG_CONFIG_KERNEL_TICKS_COUNTER_40BITS
-    return k_ticks_get_64() / K_TICKS_PER_SECOND;
+    return k_ticks_to_sec(k_ticks_get_64());
 #else
-    return k_ticks_get_32() / K_TICKS_PER_SECOND;
+    return k_ticks_to_sec(k_ticks_get_32());
 #endif /* CONFIG_KERNEL_UPTIME */
 }
 
 uint32_t k_uptime_get_ms32(void)
 {
-#if CONFIG_KERNEL_TICKS_COUNTER
-    return k_ticks_get_32() / K_TICKS_PER_MS;
-#else
-    return 0;
-#endif /* CONFIG_KERNEL_UPTIME */
+    return k_ticks_to_ms32(k_ticks_get_32());
 }
 
 uint64_t k_uptime_get_ms64(void)
 {
 #if CONFIG_CONFIG_KERNEL_TICKS_COUNTER_40BITS
-    return k_ticks_get_64() / K_TICKS_PER_MS;
-#elif CONFIG_KERNEL_TICKS_COUNTER
-    return k_ticks_get_32() / K_TICKS_PER_MS;
+    return k_ticks_to_ms64(k_ticks_get_64());
 #else
-    return 0;
+    return k_ticks_to_ms64(k_ticks_get_32());
 #endif /* CONFIG_KERNEL_UPTIME */
 }
 
@@ -47,10 +41,11 @@ void k_uptime_as_timespec_get(struct timespec *ts)
         return;
     }
 
-    const uint64_t ms = k_uptime_get_ms64();
+    const uint64_t ticks = k_ticks_get_64();
 
-    ts->tv_sec  = ms / 1000;
-    ts->tv_msec = ms % 1000;
+    ts->tv_sec = k_ticks_to_sec(ticks);
+    /* The difference is below 1000, it can be computed on 32 bits */
+    ts->tv_msec = (uint32_t)k_ticks_to_ms64(ticks) - ts->tv_sec * MSEC_PER_SEC;
 }
 
 void k_show_uptime(void)
@@ -12,6 +12,11 @@
  * within the kernel.
  * It supports operations for accessing the current time, checking if the time is set.
  *
+ * The ticks counter is read without disabling the interrupts, and the conversions
+ * of ticks to milliseconds and seconds are done with integer fractions reduced at
+ * compile time. The uptime in microseconds has the resolution of the sysclock
+ * timer counter.
+ *
  * Related configuration options:
  * - CONFIG_KERNEL_UPTIME: Uptime feature must be enabled to use the time API.
  * - CONFIG_KERNEL_TIME_API: Time API must be enabled to use the system time functions.
@@ -100,6 +105,148 @@ __kernel uint64_t k_uptime_get_ms64(void);
  */
 __kernel uint32_t k_uptime_get(void);
 
+/**
+ * @brief Get the current system uptime in microseconds (64-bit).
+ *
+ * The uptime is the ticks counter completed with the live counter of the
+ * sysclock timer (CONFIG_KERNEL_SYSLOCK_HW_TIMER), so its resolution is the
+ * period of the timer clock rather than the tick period. It is read without
+ * disabling the interrupts and can be called from an ISR.
+ *
+ * @return Uptime in microseconds (64-bit).
+ */
+__kernel uint64_t k_uptime_get_us64(void);
+
+/**
+ * @brief Get the current system uptime in microseconds (32-bit).
+ *
+ * Same as `k_uptime_get_us64` but cheaper, the value wraps around every
+ * ~71 minutes, it is meant for timestamps and short intervals.
+ *
+ * @return Uptime in microseconds (32-bit).
+ */
+__kernel uint32_t k_uptime_get_us32(void);
+
+/**
+ * Ticks conversions
+ *
+ * The tick period is reduced to fractions of a millisecond and of a second at
+ * compile time (only the factors 2 and 5 of 1000 and 1000000 are eliminated).
+ * A conversion is a multiplication if the denominator is 1 (e.g. 1000us
+ * period for milliseconds), a shift if it is a power of 2 (e.g. 500us or
+ * 250us period) and two 32-bit divisions otherwise, instead of a 64-bit
+ * division.
+ */
+
+#define Z_TICKS_GCD2(_p)                                                                 \
+    (((_p) % 64u == 0u)   ? 64u                                                          \
+     : ((_p) % 32u == 0u) ? 32u                                                          \
+     : ((_p) % 16u == 0u) ? 16u                                                          \
+     : ((_p) % 8u == 0u)  ? 8u                                                           \
+     : ((_p) % 4u == 0u)  ? 4u                                                           \
+     : ((_p) % 2u == 0u)  ? 2u                                                           \
+                          : 1u)
+#define Z_TICKS_GCD5(_p)                                                                 \
+    (((_p) % 15625u == 0u)  ? 15625u                                                     \
+     : ((_p) % 3125u == 0u) ? 3125u                                                      \
+     : ((_p) % 625u == 0u)  ? 625u                                                       \
+     : ((_p) % 125u == 0u)  ? 125u                                                       \
+     : ((_p) % 25u == 0u)   ? 25u                                                        \
+     : ((_p) % 5u == 0u)    ? 5u                                                         \
+                            : 1u)
+
+#define Z_TICKS_MS_GCD                                                                   \
+    (MIN(Z_TICKS_GCD2(K_TICKS_US), 8u) * MIN(Z_TICKS_GCD5(K_TICKS_US), 125u))
+#define Z_TICKS_SEC_GCD (Z_TICKS_GCD2(K_TICKS_US) * Z_TICKS_GCD5(K_TICKS_US))
+
+/* Tick period in milliseconds: K_TICKS_MS_NUM / K_TICKS_MS_DEN */
+#define K_TICKS_MS_NUM ((uint32_t)(K_TICKS_US / Z_TICKS_MS_GCD))
+#define K_TICKS_MS_DEN ((uint32_t)(1000u / Z_TICKS_MS_GCD))
+
+/* Tick period in seconds: K_TICKS_SEC_NUM / K_TICKS_SEC_DEN */
+#define K_TICKS_SEC_NUM ((uint32_t)(K_TICKS_US / Z_TICKS_SEC_GCD))
+#define K_TICKS_SEC_DEN ((uint32_t)(1000000u / Z_TICKS_SEC_GCD))
+
+/**
+ * @brief Multiply a number of ticks (below 2^48) by the fraction num / den.
+ *
+ * Both num and den must be constants for the conversion to be optimized.
+ */
+__always_inline uint64_t z_ticks_scale(uint64_t ticks, uint32_t num, uint32_t den)
+{
+    uint64_t q;
+    uint32_t r;
+
+    if (den == 1u) {
+        return ticks * num;
+    } else if ((den & (den - 1u)) == 0u) {
+        /* Cannot overflow, the ticks counter is 40-bit and num is below 2^16
+         * for any period supported by the sysclock timer */
+        return (ticks * num) / den;
+    } else if (den <= 0xFFFFu) {
+        /* (ticks / den) as two 32-bit divisions, the second one of the
+         * remainder of the first one followed by the 16 LSB of the ticks */
+        const uint32_t hi = (uint32_t)(ticks >> 16u);
+        const uint32_t lo = ((hi % den) << 16u) | (uint16_t)ticks;
+
+        q = ((uint64_t)(hi / den) << 16u) | (lo / den);
+    } else {
+        q = ticks / den;
+    }
+
+    r = (uint32_t)ticks - (uint32_t)q * den;
+
+    if ((uint64_t)den * num <= UINT32_MAX) {
+        return q * num + (r * num) / den;
+    } else {
+        return q * num + ((uint64_t)r * num) / den;
+    }
+}
+
+/**
+ * @brief Convert a number of ticks to milliseconds.
+ *
+ * @param ticks Number of ticks.
+ * @return Milliseconds (rounded down).
+ */
+__always_inline uint64_t k_ticks_to_ms64(uint64_t ticks)
+{
+    return z_ticks_scale(ticks, K_TICKS_MS_NUM, K_TICKS_MS_DEN);
+}
+
+/**
+ * @brief Convert a number of ticks to milliseconds (32-bit).
+ *
+ * @param ticks Number of ticks.
+ * @return Milliseconds (rounded down).
+ */
+__always_inline uint32_t k_ticks_to_ms32(uint32_t ticks)
+{
+    return (uint32_t)k_ticks_to_ms64(ticks);
+}
+
+/**
+ * @brief Convert a number of ticks to seconds.
+ *
+ * @param ticks Number of ticks.
+ * @return Seconds (rounded down).
+ */
+__always_inline uint32_t k_ticks_to_sec(uint64_t ticks)
+{
+    return (uint32_t)z_ticks_scale(ticks, K_TICKS_SEC_NUM, K_TICKS_SEC_DEN);
+}
+
+/**
+ * @brief Convert a number of ticks to microseconds.
+ *
+ * @param ticks Number of ticks.
+ * @return Microseconds.
+ */
+__always_inline uint64_t k_ticks_to_us64(uint64_t ticks)
+{
+    return ticks * (uint32_t)K_TICKS_US;
+}
+
 /**
  * @brief Print the current uptime in seconds to the serial output.
  *
@@ -120,13 +120,17 @@ struct k_thread {
                            ///< signal, etc...)
     void *swap_data;       ///< Data returned by kernel APIs when the thread is unpended.
 
+#if Z_THREAD_STACK_INFO
     struct {
         void *end;   ///< End of the stack memory.
         size_t size; ///< Size of the stack.
     } stack;         ///< Stack information for the thread.
+#endif /* Z_THREAD_STACK_INFO */
 
+#if Z_THREAD_SYMBOL
     char symbol; ///< A single character symbol representing the thread, reserved symbols:
-                 ///< 'M' for main, 'I' for idle.
+                 ///< 'M' for main, 'I' for idle. Use K_THREAD_SYMBOL() to read it.
+#endif /* Z_THREAD_SYMBOL */
 
 #if CONFIG_KERNEL_REENTRANCY
     /**
@@ -0,0 +1,7 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Empty stand-in, included by atomic.h (see avr/io.h). */
@@ -7,3 +7,7 @@
 /* Empty stand-in for <avr/io.h> so portable AVRTOS sources (data structures,
  * pure logic, ...) can be compiled and unit-tested with a native host
  * compiler, without depending on the avr-gcc toolchain or QEMU. */
+
+/* Status register, only referenced by the inline functions of kernel.h which
+ * the host tests never call. */
+#define SREG (*(volatile unsigned char *)0x5Fu)
@@ -0,0 +1,9 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Stand-in, included by kernel.h (see avr/io.h). */
+#define PROGMEM
+#define PSTR(s) (s)
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Native (host) unit tests and stress test for src/avrtos/dstruct/lflist.c
+ *
+ * The AVR implementation of the pointer atomics (arch/arch_atomic.S) is
+ * replaced by the host compiler builtins, the stress tests run producers in
+ * concurrent POSIX threads.
+ *
+ * Build/run: `make -C tests/native run`
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <avrtos/defines.h>
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "atomic.h"
+#include "dstruct/lflist.h"
+
+static int g_failures = 0;
+static const char *case_name;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            fprintf(stderr, "  [%s] FAILED: %s (%s:%d)\n", case_name, #cond, __FILE__,   \
+                    __LINE__);                                                           \
+            g_failures++;                                                                \
+        }                                                                                \
+    } while (0)
+
+/* Host implementation of the pointer atomics */
+
+void *atomic_ptr_get(void *const *target)
+{
+    return __atomic_load_n(target, __ATOMIC_SEQ_CST);
+}
+
+void *atomic_ptr_set(void **target, void *value)
+{
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+bool atomic_ptr_cas(void **target, void *cmd, void *val)
+{
+    return __atomic_compare_exchange_n(target, &cmd, val, false, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST);
+}
+
+struct item {
+    struct snode node;
+    unsigned producer;
+    unsigned seq;
+};
+
+#define ITEM_OF(_node) ((struct item *)((char *)(_node) - offsetof(struct item, node)))
+
+#define ITEMS 8u
+
+static struct item items[ITEMS];
+
+static void items_reset(void)
+{
+    memset(items, 0, sizeof(items));
+    for (unsigned i = 0u; i < ITEMS; i++) {
+        items[i].seq = i;
+    }
+}
+
+static void test_stack(void)
+{
+    case_name = "stack";
+    items_reset();
+
+    LFSTACK_DEFINE(stack);
+
+    CHECK(lfstack_pop(&stack) == NULL);
+
+    for (unsigned i = 0u; i < 4u; i++) {
+        lfstack_push(&stack, &items[i].node);
+    }
+
+    /* LIFO */
+    for (unsigned i = 4u; i > 0u; i--) {
+        struct snode *node = lfstack_pop(&stack);
+        CHECK(node == &items[i - 1u].node);
+    }
+    CHECK(lfstack_pop(&stack) == NULL);
+
+    /* A popped node can be pushed again */
+    lfstack_push(&stack, &items[0].node);
+    lfstack_push(&stack, &items[1].node);
+    CHECK(lfstack_pop(&stack) == &items[1].node);
+    lfstack_push(&stack, &items[1].node);
+    CHECK(lfstack_pop(&stack) == &items[1].node);
+    CHECK(lfstack_pop(&stack) == &items[0].node);
+    CHECK(stack.head == NULL);
+}
+
+static void test_stack_pop_all(void)
+{
+    case_name = "stack pop all";
+    items_reset();
+
+    LFSTACK_DEFINE(stack);
+
+    CHECK(lfstack_pop_all(&stack) == NULL);
+
+    for (unsigned i = 0u; i < 3u; i++) {
+        lfstack_push(&stack, &items[i].node);
+    }
+
+    struct snode *list = lfstack_pop_all(&stack);
+    CHECK(stack.head == NULL);
+    CHECK(list == &items[2].node);
+    CHECK(list->next == &items[1].node);
+    CHECK(list->next->next == &items[0].node);
+    CHECK(list->next->next->next == NULL);
+}
+
+static void test_mpsc(void)
+{
+    case_name = "mpsc";
+    items_reset();
+
+    MPSC_DEFINE(queue);
+
+    CHECK(mpsc_is_empty(&queue));
+    CHECK(mpsc_pop(&queue) == NULL);
+
+    for (unsigned i = 0u; i < 3u; i++) {
+        mpsc_push(&queue, &items[i].node);
+    }
+    CHECK(!mpsc_is_empty(&queue));
+
+    /* FIFO */
+    CHECK(mpsc_pop(&queue) == &items[0].node);
+
+    /* Pushed while the private list is not empty, given after it */
+    mpsc_push(&queue, &items[3].node);
+    mpsc_push(&queue, &items[4].node);
+
+    for (unsigned i = 1u; i < 5u; i++) {
+        CHECK(mpsc_pop(&queue) == &items[i].node);
+    }
+
+    CHECK(mpsc_pop(&queue) == NULL);
+    CHECK(mpsc_is_empty(&queue));
+
+    /* Refilled once empty */
+    mpsc_push(&queue, &items[5].node);
+    CHECK(!mpsc_is_empty(&queue));
+    CHECK(mpsc_pop(&queue) == &items[5].node);
+    CHECK(mpsc_is_empty(&queue));
+}
+
+#define PRODUCERS           4u
+#define ITEMS_PER_PRODUCER  20000u
+
+static struct item pool[PRODUCERS][ITEMS_PER_PRODUCER];
+static struct mpsc stress_queue;
+static struct lfstack stress_stack;
+
+struct producer {
+    pthread_t thread;
+    unsigned id;
+    bool stack;
+};
+
+static void *producer_entry(void *arg)
+{
+    const struct producer *p = arg;
+
+    for (unsigned i = 0u; i < ITEMS_PER_PRODUCER; i++) {
+        struct item *const item = &pool[p->id][i];
+
+        item->producer = p->id;
+        item->seq      = i;
+
+        if (p->stack) {
+            lfstack_push(&stress_stack, &item->node);
+        } else {
+            mpsc_push(&stress_queue, &item->node);
+        }
+    }
+
+    return NULL;
+}
+
+static void stress(bool stack)
+{
+    static bool received[PRODUCERS][ITEMS_PER_PRODUCER];
+    struct producer producers[PRODUCERS];
+    unsigned next_seq[PRODUCERS] = {0u};
+    unsigned count               = 0u;
+    bool ordered                 = true;
+    bool duplicated              = false;
+
+    memset(received, 0, sizeof(received));
+    stress_queue = (struct mpsc)MPSC_INIT();
+    stress_stack = (struct lfstack)LFSTACK_INIT();
+
+    for (unsigned i = 0u; i < PRODUCERS; i++) {
+        producers[i].id    = i;
+        producers[i].stack = stack;
+        pthread_create(&producers[i].thread, NULL, producer_entry, &producers[i]);
+    }
+
+    /* Single consumer, concurrent with the producers */
+    while (count < PRODUCERS * ITEMS_PER_PRODUCER) {
+        struct snode *node = stack ? lfstack_pop(&stress_stack) : mpsc_pop(&stress_queue);
+        if (node == NULL) {
+            continue;
+        }
+
+        const struct item *item = ITEM_OF(node);
+
+        if (received[item->producer][item->seq]) {
+            duplicated = true;
+        }
+        received[item->producer][item->seq] = true;
+
+        if (!stack) {
+            /* The items of a producer are received in order */
+            if (item->seq != next_seq[item->producer]) {
+                ordered = false;
+            }
+            next_seq[item->producer] = item->seq + 1u;
+        }
+
+        count++;
+    }
+
+    for (unsigned i = 0u; i < PRODUCERS; i++) {
+        pthread_join(producers[i].thread, NULL);
+    }
+
+    CHECK(!duplicated);
+    CHECK(ordered);
+    CHECK(stack ? (lfstack_pop(&stress_stack) == NULL) : mpsc_is_empty(&stress_queue));
+}
+
+static void test_stress_stack(void)
+{
+    case_name = "stress stack";
+    stress(true);
+}
+
+static void test_stress_mpsc(void)
+{
+    case_name = "stress mpsc";
+    stress(false);
+}
+
+int main(void)
+{
+    static void (*const cases[])(void) = {
+        test_stack, test_stack_pop_all, test_mpsc, test_stress_stack, test_stress_mpsc,
+    };
+
+    for (size_t i = 0u; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cases[i]();
+    }
+
+    if (g_failures == 0) {
+        printf("All %zu lflist test cases passed\n", sizeof(cases) / sizeof(cases[0]));
+        return 0;
+    }
+
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+}
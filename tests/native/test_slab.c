@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Native (host) unit tests for the batch operations of
+ * src/avrtos/alloc/slab.c
+ *
+ * After each test case, the free list is walked to check it only contains
+ * distinct blocks of the slab and matches the free counter.
+ *
+ * Build/run: `make -C tests/native run`
+ */
+
+#include <avrtos/defines.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "alloc/slab.h"
+
+static int g_failures = 0;
+static const char *case_name;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            fprintf(stderr, "  [%s] FAILED: %s (%s:%d)\n", case_name, #cond, __FILE__,   \
+                    __LINE__);                                                           \
+            g_failures++;                                                                \
+        }                                                                                \
+    } while (0)
+
+#define BLOCK_SIZE   8u
+#define BLOCKS_COUNT 6u
+
+static uint8_t buf[BLOCKS_COUNT * BLOCK_SIZE];
+static struct slab_allocator a;
+
+static bool in_slab(const void *mem)
+{
+    const uint8_t *p = mem;
+
+    return (p >= buf) && (p < buf + sizeof(buf)) && (((p - buf) % BLOCK_SIZE) == 0u);
+}
+
+/* Walk the free list, check it is consistent with the free counter */
+static void slab_check(void)
+{
+    bool seen[BLOCKS_COUNT] = {false};
+    uint8_t n               = 0u;
+
+    for (struct snode *node = a.free_list; node != NULL; node = node->next) {
+        CHECK(in_slab(node));
+        if (!in_slab(node) || (n > BLOCKS_COUNT))
+            return;
+
+        const size_t index = ((uint8_t *)node - buf) / BLOCK_SIZE;
+        CHECK(!seen[index]);
+        seen[index] = true;
+        n++;
+    }
+
+    CHECK(n == a.free_count);
+}
+
+static void reset(void)
+{
+    CHECK(slab_init(&a, buf, BLOCK_SIZE, BLOCKS_COUNT) == 0);
+    slab_check();
+}
+
+static void test_alloc_many(void)
+{
+    void *mem[BLOCKS_COUNT];
+
+    case_name = "alloc_many";
+    reset();
+
+    CHECK(slab_alloc_many(&a, mem, 0u) == 0u);
+    CHECK(a.free_count == BLOCKS_COUNT);
+
+    /* Blocks are taken in the order of the free list */
+    struct snode *head = a.free_list;
+    CHECK(slab_alloc_many(&a, mem, 4u) == 4u);
+    CHECK(mem[0] == head);
+    CHECK(a.free_count == BLOCKS_COUNT - 4u);
+    for (uint8_t i = 0u; i < 4u; i++) {
+        CHECK(in_slab(mem[i]));
+        for (uint8_t j = 0u; j < i; j++) {
+            CHECK(mem[i] != mem[j]);
+        }
+        memset(mem[i], 0xAA, BLOCK_SIZE);
+    }
+    slab_check();
+
+    CHECK(slab_alloc_many(&a, &mem[4u], 2u) == 2u);
+    CHECK(a.free_list == NULL);
+    CHECK(a.free_count == 0u);
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    CHECK(a.max_used == BLOCKS_COUNT);
+    CHECK(a.failures == 0u);
+#endif
+    slab_check();
+}
+
+static void test_exhaustion(void)
+{
+    void *mem[BLOCKS_COUNT + 2u];
+    void *more;
+
+    case_name = "exhaustion";
+    reset();
+
+    CHECK(slab_alloc(&a) != NULL);
+    struct snode *head = a.free_list;
+
+    /* Partial allocation: the available blocks are all returned */
+    CHECK(slab_alloc_many(&a, mem, BLOCKS_COUNT + 2u) == BLOCKS_COUNT - 1u);
+    CHECK(a.free_list == NULL);
+    CHECK(a.free_count == 0u);
+#if CONFIG_KERNEL_MEM_SLAB_STATS
+    CHECK(a.failures == 1u);
+#endif
+    CHECK(slab_alloc_many(&a, &more, 1u) == 0u);
+    CHECK(slab_alloc(&a) == NULL);
+    slab_check();
+
+    /* Roll back the partial allocation, the free list is restored as is */
+    slab_free_many(&a, mem, BLOCKS_COUNT - 1u);
+    CHECK(a.free_list == head);
+    CHECK(a.free_count == BLOCKS_COUNT - 1u);
+    slab_check();
+
+    struct snode *node = a.free_list;
+    for (uint8_t i = 0u; i < BLOCKS_COUNT - 1u; i++) {
+        CHECK(node == mem[i]);
+        node = node->next;
+    }
+    CHECK(node == NULL);
+}
+
+static void test_round_trip(void)
+{
+    void *mem[BLOCKS_COUNT];
+    void *again[BLOCKS_COUNT];
+
+    case_name = "round_trip";
+    reset();
+
+    CHECK(slab_alloc_many(&a, mem, BLOCKS_COUNT) == BLOCKS_COUNT);
+
+    /* Free in a different order than allocated, in two batches */
+    void *const order[BLOCKS_COUNT] = {mem[3], mem[0], mem[5], mem[1], mem[4], mem[2]};
+    slab_free_many(&a, (void **)&order[4u], 2u);
+    CHECK(a.free_count == 2u);
+    slab_check();
+
+    slab_free_many(&a, (void **)order, 4u);
+    CHECK(a.free_count == BLOCKS_COUNT);
+    slab_check();
+
+    /* The last batch freed is allocated first, each batch in its order */
+    CHECK(slab_alloc_many(&a, again, BLOCKS_COUNT) == BLOCKS_COUNT);
+    for (uint8_t i = 0u; i < BLOCKS_COUNT; i++) {
+        CHECK(again[i] == order[i]);
+    }
+    CHECK(a.free_count == 0u);
+    slab_check();
+
+    /* Free nothing */
+    slab_free_many(&a, again, 0u);
+    CHECK(a.free_list == NULL);
+
+    /* Single and batch operations mix */
+    slab_free(&a, again[0]);
+    slab_free_many(&a, &again[1u], BLOCKS_COUNT - 1u);
+    CHECK(slab_alloc(&a) == again[1]);
+    CHECK(slab_alloc_many(&a, mem, BLOCKS_COUNT) == BLOCKS_COUNT - 1u);
+    CHECK(mem[BLOCKS_COUNT - 2u] == again[0]);
+    slab_check();
+}
+
+int main(void)
+{
+    static void (*const cases[])(void) = {
+        test_alloc_many,
+        test_exhaustion,
+        test_round_trip,
+    };
+
+    for (size_t i = 0u; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cases[i]();
+    }
+
+    if (g_failures == 0) {
+        printf("All %zu slab test cases passed\n", sizeof(cases) / sizeof(cases[0]));
+        return 0;
+    }
+
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+}
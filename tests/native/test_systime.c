@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Native (host) unit tests for the ticks conversions of src/avrtos/systime.h
+ *
+ * The conversions are compared against a reference 64-bit division, the test
+ * is built once for each tested CONFIG_KERNEL_SYSCLOCK_PERIOD_US (see
+ * Makefile), as the fractions are reduced at compile time.
+ *
+ * Build/run: `make -C tests/native run`
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* Also defined by the C library, redefined by sys.h */
+#undef __always_inline
+
+#include "systime.h"
+
+static int g_failures = 0;
+static const char *case_name;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            fprintf(stderr, "  [%s] FAILED: %s (%s:%d)\n", case_name, #cond, __FILE__,   \
+                    __LINE__);                                                           \
+            g_failures++;                                                                \
+        }                                                                                \
+    } while (0)
+
+#define CHECK_TICKS(cond, ticks)                                                         \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            fprintf(stderr, "  [%s] FAILED: %s ticks=%llu (%s:%d)\n", case_name, #cond,  \
+                    (unsigned long long)(ticks), __FILE__, __LINE__);                    \
+            g_failures++;                                                                \
+            return;                                                                      \
+        }                                                                                \
+    } while (0)
+
+/* Ticks counter is at most 40-bit, z_ticks_scale() supports up to 2^48 */
+#define TICKS_MAX ((1ull << 48u) - 1u)
+
+static const uint64_t edges[] = {
+    0u,
+    1u,
+    2u,
+    999u,
+    1000u,
+    1001u,
+    0xFFFFu,
+    0x10000u,
+    0x10001u,
+    999999u,
+    1000000u,
+    0xFFFFFFFFu,
+    0x100000000u,
+    0xFFFFFFFFFFu,
+    0x10000000000u,
+    TICKS_MAX,
+};
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rng_next(void)
+{
+    rng_state ^= rng_state << 13u;
+    rng_state ^= rng_state >> 7u;
+    rng_state ^= rng_state << 17u;
+    return rng_state;
+}
+
+/* Random ticks with a random magnitude, so small values are covered too */
+static uint64_t rng_ticks(void)
+{
+    return (rng_next() & TICKS_MAX) >> (rng_next() % 48u);
+}
+
+static uint64_t ref_scale(uint64_t ticks, uint32_t num, uint32_t den)
+{
+    return (uint64_t)(((unsigned __int128)ticks * num) / den);
+}
+
+static void test_fractions(void)
+{
+    case_name = "fractions";
+
+    /* The reduced fractions are the tick period */
+    CHECK((uint64_t)K_TICKS_MS_NUM * 1000u == (uint64_t)K_TICKS_MS_DEN * K_TICKS_US);
+    CHECK((uint64_t)K_TICKS_SEC_NUM * 1000000u == (uint64_t)K_TICKS_SEC_DEN * K_TICKS_US);
+}
+
+static void test_edges(void)
+{
+    case_name = "edges";
+
+    for (size_t i = 0u; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        const uint64_t t = edges[i];
+
+        CHECK_TICKS(k_ticks_to_ms64(t) == t * K_TICKS_US / 1000u, t);
+        CHECK_TICKS(k_ticks_to_sec(t) == (uint32_t)(t * K_TICKS_US / 1000000u), t);
+        CHECK_TICKS(k_ticks_to_us64(t) == t * K_TICKS_US, t);
+    }
+}
+
+static void test_random(void)
+{
+    case_name = "random";
+
+    for (uint32_t i = 0u; i < 1000000u; i++) {
+        const uint64_t t = rng_ticks();
+
+        CHECK_TICKS(k_ticks_to_ms64(t) == t * K_TICKS_US / 1000u, t);
+        CHECK_TICKS(k_ticks_to_sec(t) == (uint32_t)(t * K_TICKS_US / 1000000u), t);
+    }
+}
+
+static void test_ms32(void)
+{
+    case_name = "ms32";
+
+    for (uint32_t i = 0u; i < 1000000u; i++) {
+        const uint32_t t = (uint32_t)rng_next();
+
+        CHECK_TICKS(k_ticks_to_ms32(t) == (uint32_t)((uint64_t)t * K_TICKS_US / 1000u),
+                    t);
+    }
+
+    CHECK(k_ticks_to_ms32(UINT32_MAX) ==
+          (uint32_t)((uint64_t)UINT32_MAX * K_TICKS_US / 1000u));
+}
+
+/* Two 32-bit divisions path and remainder fix-up with other fractions */
+static void test_scale(void)
+{
+    static const uint32_t fractions[][2] = {
+        {1u, 3u},      {2u, 3u},        {1u, 10u},      {333u, 1000u},
+        {1u, 1000u},   {7u, 1000u},     {1u, 4000u},    {333u, 65535u},
+        {1u, 65535u},  {999u, 1000u},   {1u, 100000u},  {333u, 1000000u},
+        {3u, 2u},      {1u, 2048u},     {1000u, 1u},    {65535u, 65533u},
+    };
+
+    case_name = "scale";
+
+    for (size_t f = 0u; f < sizeof(fractions) / sizeof(fractions[0]); f++) {
+        const uint32_t num = fractions[f][0];
+        const uint32_t den = fractions[f][1];
+
+        for (size_t i = 0u; i < sizeof(edges) / sizeof(edges[0]); i++) {
+            const uint64_t t = edges[i];
+            CHECK_TICKS(z_ticks_scale(t, num, den) == ref_scale(t, num, den), t);
+        }
+
+        for (uint32_t i = 0u; i < 100000u; i++) {
+            const uint64_t t = rng_ticks();
+            CHECK_TICKS(z_ticks_scale(t, num, den) == ref_scale(t, num, den), t);
+        }
+    }
+}
+
+int main(void)
+{
+    static void (*const cases[])(void) = {
+        test_fractions, test_edges, test_random, test_ms32, test_scale,
+    };
+
+    for (size_t i = 0u; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cases[i]();
+    }
+
+    if (g_failures == 0) {
+        printf("All %zu systime test cases passed (%uus period)\n",
+               sizeof(cases) / sizeof(cases[0]), (unsigned)K_TICKS_US);
+        return 0;
+    }
+
+    fprintf(stderr, "%d check(s) failed (%uus period)\n", g_failures,
+            (unsigned)K_TICKS_US);
+    return 1;
+}
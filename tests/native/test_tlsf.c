@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2025 Lucas Dietrich <lucas.dietrich.git@proton.me>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Native (host) unit tests, stress test and benchmark for
+ * src/avrtos/alloc/tlsf.c
+ *
+ * After each test case, the whole pool is walked to check the consistency of
+ * the physical blocks chain, of the free lists and of the statistics.
+ *
+ * Build/run: `make -C tests/native run`
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <avrtos/defines.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "alloc/tlsf.h"
+
+static int g_failures = 0;
+static const char *case_name;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            fprintf(stderr, "  [%s] FAILED: %s (%s:%d)\n", case_name, #cond, __FILE__,   \
+                    __LINE__);                                                           \
+            g_failures++;                                                                \
+        }                                                                                \
+    } while (0)
+
+#define POOL_SIZE 8192u
+#define HDR_SIZE  offsetof(struct z_tlsf_block, next_free)
+
+/* +1: the pool is deliberately misaligned */
+static uint8_t pool_buf[POOL_SIZE + 1u];
+static struct tlsf_allocator a;
+
+static size_t block_size(const struct z_tlsf_block *block)
+{
+    return block->size & ~(size_t)0x3u;
+}
+
+static struct z_tlsf_block *first_block(void)
+{
+    return (struct z_tlsf_block *)(((uintptr_t)a.buf + TLSF_ALIGN - 1u) &
+                                   ~(uintptr_t)(TLSF_ALIGN - 1u));
+}
+
+/* Walk the pool and the free lists, check everything is consistent */
+static void heap_check(void)
+{
+    struct z_tlsf_block *block = first_block();
+    struct z_tlsf_block *prev  = NULL;
+    size_t free_sum = 0u, free_count = 0u, total = 0u;
+    bool prev_free = false;
+
+    while (block_size(block) != 0u) {
+        const bool is_free = (block->size & 0x1u) != 0u;
+
+        CHECK(((uintptr_t)block % TLSF_ALIGN) == 0u);
+        CHECK((block_size(block) % TLSF_ALIGN) == 0u);
+        CHECK(prev == NULL || block->prev_phys == prev);
+        CHECK(((block->size & 0x2u) != 0u) == prev_free);
+        /* Free blocks are always merged */
+        CHECK(!(is_free && prev_free));
+
+        if (is_free) {
+            free_sum += block_size(block);
+            free_count++;
+        }
+
+        total += block_size(block) + HDR_SIZE;
+        prev_free = is_free;
+        prev      = block;
+        block = (struct z_tlsf_block *)((uint8_t *)block + HDR_SIZE + block_size(block));
+    }
+
+    /* Sentinel */
+    CHECK(block->prev_phys == prev);
+    CHECK(((block->size & 0x2u) != 0u) == prev_free);
+    CHECK(total == a.capacity + HDR_SIZE);
+
+    CHECK(free_sum == a.free);
+    CHECK(free_count == a.free_blocks);
+
+    /* Free lists only contain free blocks, and bitmaps match the lists */
+    size_t listed = 0u;
+    for (uint8_t fl = 0u; fl < TLSF_FL_INDEX_COUNT; fl++) {
+        CHECK(((a.fl_bitmap >> fl) & 1u) == (a.sl_bitmap[fl] != 0u));
+        for (uint8_t sl = 0u; sl < TLSF_SL_INDEX_COUNT; sl++) {
+            CHECK(((a.sl_bitmap[fl] >> sl) & 1u) == (a.heads[fl][sl] != NULL));
+            for (struct z_tlsf_block *b = a.heads[fl][sl]; b != NULL; b = b->next_free) {
+                CHECK((b->size & 0x1u) != 0u);
+                CHECK(b->next_free == NULL || b->next_free->prev_free == b);
+                listed++;
+            }
+        }
+    }
+    CHECK(listed == free_count);
+}
+
+static void test_init(void)
+{
+    case_name = "init";
+
+    CHECK(tlsf_init(NULL, pool_buf, POOL_SIZE) == -EINVAL);
+    CHECK(tlsf_init(&a, NULL, POOL_SIZE) == -EINVAL);
+    CHECK(tlsf_init(&a, pool_buf, 8u) == -EINVAL);
+    CHECK(tlsf_init(&a, pool_buf, TLSF_BLOCK_SIZE_MAX + 64u) == -EINVAL);
+    CHECK(tlsf_init(&a, pool_buf + 1u, POOL_SIZE) == 0);
+
+    struct alloc_stats stats;
+    tlsf_stats(&a, &stats);
+    CHECK(stats.total == a.capacity);
+    CHECK(stats.total > POOL_SIZE - 4u * HDR_SIZE);
+    CHECK(stats.used == 0u);
+    CHECK(stats.free == stats.total);
+    CHECK(stats.largest_free == stats.total);
+    CHECK(stats.free_blocks == 1u);
+
+    heap_check();
+}
+
+static void test_alloc_free(void)
+{
+    case_name = "alloc/free";
+    tlsf_reset(&a);
+
+    CHECK(tlsf_alloc(&a, 0u, 1u) == NULL);
+    CHECK(tlsf_alloc(&a, 16u, 3u) == NULL);
+    CHECK(tlsf_alloc(&a, POOL_SIZE, 1u) == NULL);
+
+    void *p[8];
+    for (uint8_t i = 0u; i < 8u; i++) {
+        p[i] = tlsf_alloc(&a, 1u + i * 37u, 1u);
+        CHECK(p[i] != NULL);
+        CHECK(((uintptr_t)p[i] % TLSF_ALIGN) == 0u);
+        CHECK(tlsf_usable_size(p[i]) >= 1u + i * 37u);
+        memset(p[i], i, 1u + i * 37u);
+    }
+    heap_check();
+
+    /* Free every other block, no merge possible */
+    for (uint8_t i = 0u; i < 8u; i += 2u) {
+        tlsf_free(&a, p[i]);
+    }
+    heap_check();
+    CHECK(a.free_blocks == 5u);
+
+    for (uint8_t i = 1u; i < 8u; i += 2u) {
+        for (size_t k = 0u; k < 1u + i * 37u; k++) {
+            CHECK(((uint8_t *)p[i])[k] == i);
+        }
+        tlsf_free(&a, p[i]);
+    }
+    tlsf_free(&a, NULL);
+    heap_check();
+
+    /* Everything merged back into a single block */
+    CHECK(a.free_blocks == 1u);
+    CHECK(a.free == a.capacity);
+}
+
+static void test_exhaustion(void)
+{
+    case_name = "exhaustion";
+    tlsf_reset(&a);
+
+    static void *p[POOL_SIZE / 8u];
+    size_t n = 0u;
+
+    while ((p[n] = tlsf_alloc(&a, 24u, 1u)) != NULL) {
+        n++;
+    }
+    CHECK(n > (POOL_SIZE / (24u + HDR_SIZE)) * 9u / 10u);
+    heap_check();
+
+    /* Free in reverse order, merging with the previous free block */
+    while (n--) {
+        tlsf_free(&a, p[n]);
+    }
+    heap_check();
+    CHECK(a.free_blocks == 1u);
+    CHECK(tlsf_alloc(&a, a.capacity - 2048u, 1u) != NULL);
+}
+
+static void test_aligned(void)
+{
+    case_name = "aligned";
+    tlsf_reset(&a);
+
+    static const uint8_t aligns[] = {1u, 2u, 4u, 8u, 16u, 32u, 64u, 128u};
+    void *p[sizeof(aligns)];
+
+    for (uint8_t i = 0u; i < sizeof(aligns); i++) {
+        p[i] = tlsf_alloc(&a, 10u + i, aligns[i]);
+        CHECK(p[i] != NULL);
+        CHECK(((uintptr_t)p[i] % aligns[i]) == 0u);
+        memset(p[i], 0xAA, 10u + i);
+        heap_check();
+    }
+
+    for (uint8_t i = 0u; i < sizeof(aligns); i++) {
+        tlsf_free(&a, p[i]);
+    }
+    heap_check();
+    CHECK(a.free_blocks == 1u);
+}
+
+static void test_realloc(void)
+{
+    case_name = "realloc";
+    tlsf_reset(&a);
+
+    uint8_t *p = tlsf_realloc(&a, NULL, 20u);
+    CHECK(p != NULL);
+    for (uint8_t i = 0u; i < 20u; i++) {
+        p[i] = i;
+    }
+
+    /* Grow in place, the next block is free */
+    uint8_t *q = tlsf_realloc(&a, p, 200u);
+    CHECK(q == p);
+    heap_check();
+
+    /* Shrink in place */
+    q = tlsf_realloc(&a, q, 16u);
+    CHECK(q == p);
+    heap_check();
+
+    /* Grow by moving, the next block is used */
+    void *blocker = tlsf_alloc(&a, 8u, 1u);
+    CHECK(blocker != NULL);
+    q = tlsf_realloc(&a, p, 100u);
+    CHECK(q != NULL && q != p);
+    for (uint8_t i = 0u; i < 16u; i++) {
+        CHECK(q[i] == i);
+    }
+    heap_check();
+
+    /* Too large: original block left untouched */
+    CHECK(tlsf_realloc(&a, q, POOL_SIZE) == NULL);
+    CHECK(q[15] == 15u);
+
+    CHECK(tlsf_realloc(&a, q, 0u) == NULL);
+    tlsf_free(&a, blocker);
+    heap_check();
+    CHECK(a.free_blocks == 1u);
+}
+
+struct slot {
+    uint8_t *ptr;
+    size_t len;
+    uint8_t tag;
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static bool slot_valid(const struct slot *s)
+{
+    for (size_t k = 0u; k < s->len; k++) {
+        if (s->ptr[k] != s->tag) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Random mix of allocations, frees and reallocs of small buffers, as seen on
+ * AVR applications. Contents are checked for corruption. */
+static void test_stress(void)
+{
+    case_name = "stress";
+    tlsf_reset(&a);
+
+#define SLOTS      128u
+#define ITERATIONS 200000u
+
+    static struct slot slots[SLOTS];
+    uint64_t worst_ns = 0u, sum_ns = 0u;
+    uint32_t ops = 0u, failed = 0u;
+    size_t min_largest = a.capacity;
+
+    srand(0xA5A5u);
+
+    for (uint32_t it = 0u; it < ITERATIONS; it++) {
+        struct slot *const s = &slots[(unsigned)rand() % SLOTS];
+        const size_t len     = 1u + (unsigned)rand() % ((rand() & 7) ? 64u : 512u);
+        uint64_t t0, dt;
+
+        if (s->ptr == NULL) {
+            t0     = now_ns();
+            s->ptr = tlsf_alloc(&a, len, (rand() & 15) ? 1u : 16u);
+            dt     = now_ns() - t0;
+            if (s->ptr != NULL) {
+                s->len = len;
+                s->tag = (uint8_t)it;
+                memset(s->ptr, s->tag, len);
+            } else {
+                failed++;
+            }
+        } else if (rand() & 3) {
+            CHECK(slot_valid(s));
+            t0 = now_ns();
+            tlsf_free(&a, s->ptr);
+            dt     = now_ns() - t0;
+            s->ptr = NULL;
+        } else {
+            t0               = now_ns();
+            uint8_t *const p = tlsf_realloc(&a, s->ptr, len);
+            dt               = now_ns() - t0;
+            if (p != NULL) {
+                s->ptr = p;
+                s->len = MIN(s->len, len);
+                CHECK(slot_valid(s));
+                s->len = len;
+                memset(s->ptr, s->tag, len);
+            } else {
+                CHECK(slot_valid(s));
+                failed++;
+            }
+        }
+
+        sum_ns += dt;
+        worst_ns = MAX(worst_ns, dt);
+        ops++;
+
+        if ((it % 1024u) == 0u) {
+            struct alloc_stats stats;
+            tlsf_stats(&a, &stats);
+            min_largest = MIN(min_largest, stats.largest_free);
+            heap_check();
+        }
+    }
+
+    for (uint8_t i = 0u; i < SLOTS; i++) {
+        if (slots[i].ptr != NULL) {
+            CHECK(slot_valid(&slots[i]));
+            tlsf_free(&a, slots[i].ptr);
+        }
+    }
+    heap_check();
+    CHECK(a.free_blocks == 1u);
+
+    printf("  tlsf stress: %u ops, %u failed (pool full), avg %.0f ns/op, worst %lu "
+           "ns, min largest free block %zu/%zu bytes\n",
+           (unsigned)ops, (unsigned)failed, (double)sum_ns / ops, (unsigned long)worst_ns,
+           min_largest, a.capacity);
+}
+
+int main(void)
+{
+    static void (*const cases[])(void) = {
+        test_init, test_alloc_free, test_exhaustion, test_aligned, test_realloc,
+        test_stress,
+    };
+
+    for (size_t i = 0u; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cases[i]();
+    }
+
+    if (g_failures == 0) {
+        printf("All %zu tlsf test cases passed\n", sizeof(cases) / sizeof(cases[0]));
+        return 0;
+    }
+
+    fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return 1;
+}